@@ -96,6 +96,7 @@ class GPSDecoder {
   /** List of observations */
   QList<t_satObs>         _obsList;
   QList<int>              _typeList;           // RTCM message types
+  QList<int>              _typeSizeList;       // RTCM message sizes in bytes (parallel to _typeList, RTCM3 only)
   QList<t_antInfo>        _antType;            // RTCM antenna descriptor
   QList<t_recInfo>        _recType;            // RTCM receiver descriptor
   QList<t_antRefPoint>    _antList;            // RTCM antenna XYZ
@@ -2,6 +2,116 @@
 #include <QDebug>
 #include <QMutexLocker>
 #include <QUrl>
+#include <cmath>
+
+//// 站点状态槽
+// ----------------------------------------------------------------------------
+
+StationSlot::StationSlot(const QString& stationId)
+    : _id(stationId)
+      , _status(static_cast<int>(StationStatus::Disconnect))
+      , _lastMSecs(QDateTime::currentMSecsSinceEpoch())
+      , _latencyUs(0)
+      , _throughput(0) {
+}
+
+// 更新最后数据接收时间
+void StationSlot::touch() {
+    _lastMSecs.storeRelaxed(QDateTime::currentMSecsSinceEpoch());
+}
+
+// 更新延迟，标记为 Connected；throughput 保留上次值
+void StationSlot::updateLatency(double latency) {
+    _latencyUs.storeRelaxed(static_cast<qint64>(latency * 1.e6));
+    _stats.addLatency(latency);
+    touch();
+    _status.storeRelease(static_cast<int>(StationStatus::Connected));
+}
+
+// 更新吞吐量，标记为 Connected
+void StationSlot::updateThroughput(int bytes) {
+    _throughput.storeRelaxed(bytes);
+    _stats.addBytes(bytes);
+    touch();
+    _status.storeRelease(static_cast<int>(StationStatus::Connected));
+}
+
+// 数据读取超时，msg 在发布时由最后数据时间生成
+void StationSlot::setTimeout() {
+    _status.storeRelease(static_cast<int>(StationStatus::Timeout));
+}
+
+// 网络连接断开
+void StationSlot::setDisconnected() {
+    _status.storeRelease(static_cast<int>(StationStatus::Disconnect));
+}
+
+// 发生异常，msg 存错误原因
+void StationSlot::setError(const QString& reason) {
+    {
+        QMutexLocker locker(&_msgMutex);
+        _msg = reason;
+    }
+    _status.storeRelease(static_cast<int>(StationStatus::Error));
+}
+
+void StationSlot::addMessages(int count) {
+    _stats.addMessages(count);
+}
+
+void StationSlot::addEpochs(int count) {
+    _stats.addEpochs(count);
+}
+
+void StationSlot::addMessageType(int type, int bytes) {
+    _typeStats.add(type, bytes);
+}
+
+StationStatus StationSlot::status() const {
+    return static_cast<StationStatus>(_status.loadAcquire());
+}
+
+// 读取当前状态快照；各字段独立读取，单个字段可能比状态新一个周期，对监控发布无影响
+StationInfo StationSlot::info() const {
+    StationInfo s;
+    s.id = _id;
+    s.status = status();
+    s.lastDateTime = QDateTime::fromMSecsSinceEpoch(_lastMSecs.loadRelaxed());
+    s.lastLatency = _latencyUs.loadRelaxed() / 1.e6;
+    s.lastThroughput = _throughput.loadRelaxed();
+    s.throughputRate = _stats.byteRate();
+    s.stats = _stats.toJson();
+
+    switch (s.status) {
+    case StationStatus::Timeout:
+        s.msg = s.lastDateTime.toString("yyyy-MM-dd hh:mm:ss");
+        break;
+    case StationStatus::Error: {
+        QMutexLocker locker(&_msgMutex);
+        s.msg = _msg;
+        break;
+    }
+    default:
+        break;
+    }
+    return s;
+}
+
+//// 站点计数
+// ----------------------------------------------------------------------------
+
+void JsonMessage::StatusCount::add(StationStatus status) {
+    switch (status) {
+    case StationStatus::Connected: connected++;
+        break;
+    case StationStatus::Timeout: timeout++;
+        break;
+    case StationStatus::Disconnect: disconnect++;
+        break;
+    case StationStatus::Error: error++;
+        break;
+    }
+}
 
 // 构造与析构
 // ----------------------------------------------------------------------------
@@ -9,12 +119,10 @@ JsonMessage::JsonMessage(QObject* parent)
     : QObject(parent)
       , _nodeName("DefaultNode")
       , _timeMessage(QDateTime::currentDateTime())
-      , _totalStationCount(0)
-      , _connectedStationCount(0)
-      , _timeoutStationCount(0)
-      , _disconnectStationCount(0)
-      , _errorStationCount(0)
-      , _timeStampDirty(false) {
+      , _timeStampDirty(false)
+      , _sequence(0)
+      , _fullSequence(0)
+      , _eventIntervalMs(10000) {
 }
 
 JsonMessage::~JsonMessage() {
@@ -30,48 +138,25 @@ void JsonMessage::setNodeName(const QString& name) {
     _timeStampDirty = true; // 标记时间戳需要更新
 }
 
-// 添加单个站点（默认断开）
-void JsonMessage::addStation(const QString& id) {
+// 添加单个站点（默认断开），返回其状态槽供数据流线程直接写入
+StationSlotPtr JsonMessage::addStation(const QString& id) {
     QMutexLocker locker(&_mutex);
-    if (!_stations.contains(id)) {
-        StationInfo station(id);
-        // station.status 默认为 Disconnect
-        station.lastDateTime = QDateTime::currentDateTime();
-        _stations.insert(id, station);
-
-        // 性能优化：更新计数，无需遍历
-        _totalStationCount++;
-        _disconnectStationCount++;
-        _timeStampDirty = true;
-    }
+    return findOrAddSlot(id);
 }
 
 // 手动初始化站点列表，全部置为 Disconnect
 void JsonMessage::initStationList(const QStringList& ids) {
     QMutexLocker locker(&_mutex);
-    _stations.clear();
-    _totalStationCount = _connectedStationCount = _timeoutStationCount =
-        _disconnectStationCount = _errorStationCount = 0;
-
-    QDateTime currentTime = QDateTime::currentDateTime();
+    clearSlots();
     for (const QString& id : ids) {
-        StationInfo station(id);
-        station.status = StationStatus::Disconnect;
-        station.lastDateTime = currentTime;
-        _stations.insert(id, station);
-        _totalStationCount++;
-        _disconnectStationCount++;
+        findOrAddSlot(id);
     }
-
-    _timeStampDirty = true;
 }
 
 // 从 bncSettings("mountPoints") 更新站点列表，全部标记为 Disconnect
 void JsonMessage::updateStationList() {
     QMutexLocker locker(&_mutex);
-    _stations.clear();
-    _totalStationCount = _connectedStationCount = _timeoutStationCount =
-        _disconnectStationCount = _errorStationCount = 0;
+    clearSlots();
 
     bncSettings settings;
     QStringList mountList = settings.value("mountPoints").toStringList();
@@ -79,18 +164,8 @@ void JsonMessage::updateStationList() {
         const QStringList parts = line.split(' ');
         if (parts.size() <= 1) continue;
         QUrl url(parts.at(0));
-        QString id = url.path().mid(1);
-
-        StationInfo station(id);
-        station.status = StationStatus::Disconnect;
-        station.lastDateTime = QDateTime::currentDateTime();
-        _stations.insert(id, station);
-
-        _totalStationCount++;
-        _disconnectStationCount++;
+        findOrAddSlot(url.path().mid(1));
     }
-
-    _timeStampDirty = true;
 }
 
 //// 更新数据
@@ -98,187 +173,86 @@ void JsonMessage::updateStationList() {
 
 // 手动更新某个站点信息
 void JsonMessage::updateStation(const QString& id, StationStatus status, const QVariantList& data) {
-    QMutexLocker locker(&_mutex);
-    if (!_stations.contains(id)) {
-        qWarning() << "Station" << id << "not found, adding automatically";
-        // 注意：这里需要解锁后再调用 addStation，或者直接在这里添加站点
-        StationInfo station(id);
-        station.lastDateTime = QDateTime::currentDateTime();
-        _stations.insert(id, station);
-        _totalStationCount++;
-        _disconnectStationCount++;
-    }
-
-    StationInfo& station = _stations[id];
-    StationStatus oldStatus = station.status;
-
-    // 状态改变时更新计数
-    if (oldStatus != status) {
-        decrementStatusCount(oldStatus);
-        incrementStatusCount(status);
-        station.status = status;
-        _timeStampDirty = true;
+    StationSlotPtr slot;
+    {
+        QMutexLocker locker(&_mutex);
+        if (!_index.contains(id)) {
+            qWarning() << "Station" << id << "not found, adding automatically";
+        }
+        slot = findOrAddSlot(id);
     }
 
-    station.lastDateTime = QDateTime::currentDateTime();
-
-    // 解析数据内容
-    if (status == StationStatus::Connected && data.size() >= 2) {
-        station.lastLatencyMs = data[0].toDouble();
-        station.lastThroughput = data[1].toInt();
-        station.msg.clear();
-    }
-    else if ((status == StationStatus::Timeout || status == StationStatus::Error) && data.size() >= 1) {
-        station.msg = data[0].toString();
-    }
-    else {
-        station.msg.clear();
+    switch (status) {
+    case StationStatus::Connected:
+        if (data.size() >= 2) {
+            slot->updateLatency(data[0].toDouble());
+            slot->updateThroughput(data[1].toInt());
+        }
+        else {
+            slot->updateThroughput(0);
+        }
+        break;
+    case StationStatus::Timeout:
+        slot->setTimeout();
+        break;
+    case StationStatus::Disconnect:
+        slot->setDisconnected();
+        break;
+    case StationStatus::Error:
+        slot->setError(data.size() >= 1 ? data[0].toString() : QString());
+        break;
     }
 }
 
 //// 槽函数：实时更新
+// 数据流线程已直接写入状态槽，这些槽函数保留给通过信号接入的调用者。
+// 信号经队列传递，可能在 removeStation() 之后才到达：未知站点直接忽略，不重新添加
 // ----------------------------------------------------------------------------
 
 // 更新站点延迟，标记为 Connected
 void JsonMessage::slotUpdateLatency(const QByteArray& staID, double latency) {
-    QMutexLocker locker(&_mutex);
-    QString id = QString::fromUtf8(staID);
-
-    // 确保站点存在
-    if (!_stations.contains(id)) {
-        StationInfo station(id);
-        _stations.insert(id, station);
-        _totalStationCount++;
-        _disconnectStationCount++; // 新站点默认为断开状态
-    }
-
-    StationInfo& station = _stations[id];
-    StationStatus oldStatus = station.status;
-
-    // 更新状态为连接
-    if (oldStatus != StationStatus::Connected) {
-        decrementStatusCount(oldStatus);
-        incrementStatusCount(StationStatus::Connected);
-        station.status = StationStatus::Connected;
-        _timeStampDirty = true;
+    StationSlotPtr slot = findSlot(QString::fromUtf8(staID));
+    if (slot) {
+        slot->updateLatency(latency);
     }
-
-    station.lastLatencyMs = latency;
-    station.lastDateTime = QDateTime::currentDateTime();
-    // throughput 保留上次值；msg 清空
-    station.msg.clear();
 }
 
 // 更新站点吞吐量，标记为 Connected
 void JsonMessage::slotUpdateThroughput(const QByteArray& staID, int bytes) {
-    QMutexLocker locker(&_mutex);
-    QString id = QString::fromUtf8(staID);
-
-    // 确保站点存在
-    if (!_stations.contains(id)) {
-        StationInfo station(id);
-        _stations.insert(id, station);
-        _totalStationCount++;
-        _disconnectStationCount++; // 新站点默认为断开状态
+    StationSlotPtr slot = findSlot(QString::fromUtf8(staID));
+    if (slot) {
+        slot->updateThroughput(bytes);
     }
-
-    StationInfo& station = _stations[id];
-    StationStatus oldStatus = station.status;
-
-    // 更新状态为连接
-    if (oldStatus != StationStatus::Connected) {
-        decrementStatusCount(oldStatus);
-        incrementStatusCount(StationStatus::Connected);
-        station.status = StationStatus::Connected;
-        _timeStampDirty = true;
-    }
-
-    station.lastThroughput = bytes;
-    station.lastDateTime = QDateTime::currentDateTime();
-    station.msg.clear();
 }
 
-// 数据读取超时，标记为 Timeout，msg 存最后时间
+// 数据读取超时，标记为 Timeout，并立即检查状态变化事件
 void JsonMessage::slotOnStaTimeout(const QByteArray& staID) {
-    QMutexLocker locker(&_mutex);
     QString id = QString::fromUtf8(staID);
-
-    // 确保站点存在
-    if (!_stations.contains(id)) {
-        StationInfo station(id);
-        _stations.insert(id, station);
-        _totalStationCount++;
-        _disconnectStationCount++; // 新站点默认为断开状态
+    StationSlotPtr slot = findSlot(id);
+    if (slot) {
+        slot->setTimeout();
+        checkStationEvent(id);
     }
-
-    StationInfo& station = _stations[id];
-    StationStatus oldStatus = station.status;
-
-    // 更新状态为超时
-    if (oldStatus != StationStatus::Timeout) {
-        decrementStatusCount(oldStatus);
-        incrementStatusCount(StationStatus::Timeout);
-        station.status = StationStatus::Timeout;
-        _timeStampDirty = true;
-    }
-
-    // msg 用于传递超时描述
-    station.msg = station.lastDateTime.toString("yyyy-MM-dd hh:mm:ss");
 }
 
-// 网络连接断开，标记为 Disconnect
+// 网络连接断开，标记为 Disconnect，并立即检查状态变化事件
 void JsonMessage::slotOnStaDisconnected(const QByteArray& staID) {
-    QMutexLocker locker(&_mutex);
     QString id = QString::fromUtf8(staID);
-
-    // 确保站点存在
-    if (!_stations.contains(id)) {
-        StationInfo station(id);
-        _stations.insert(id, station);
-        _totalStationCount++;
-        _disconnectStationCount++; // 新站点默认为断开状态
-        return; // 新站点已经是断开状态，无需再次设置
+    StationSlotPtr slot = findSlot(id);
+    if (slot) {
+        slot->setDisconnected();
+        checkStationEvent(id);
     }
-
-    StationInfo& station = _stations[id];
-    StationStatus oldStatus = station.status;
-
-    // 更新状态为断开
-    if (oldStatus != StationStatus::Disconnect) {
-        decrementStatusCount(oldStatus);
-        incrementStatusCount(StationStatus::Disconnect);
-        station.status = StationStatus::Disconnect;
-        _timeStampDirty = true;
-    }
-
-    station.msg.clear();
 }
 
-// 发生异常，标记为 Error，msg 存错误原因
+// 发生异常，标记为 Error，msg 存错误原因，并立即检查状态变化事件
 void JsonMessage::slotOnStaError(const QByteArray& staID, const QString& reason) {
-    QMutexLocker locker(&_mutex);
     QString id = QString::fromUtf8(staID);
-
-    // 确保站点存在
-    if (!_stations.contains(id)) {
-        StationInfo station(id);
-        _stations.insert(id, station);
-        _totalStationCount++;
-        _disconnectStationCount++; // 新站点默认为断开状态
+    StationSlotPtr slot = findSlot(id);
+    if (slot) {
+        slot->setError(reason);
+        checkStationEvent(id);
     }
-
-    StationInfo& station = _stations[id];
-    StationStatus oldStatus = station.status;
-
-    // 更新状态为错误
-    if (oldStatus != StationStatus::Error) {
-        decrementStatusCount(oldStatus);
-        incrementStatusCount(StationStatus::Error);
-        station.status = StationStatus::Error;
-        _timeStampDirty = true;
-    }
-
-    station.msg = reason;
 }
 
 //// 获取信息
@@ -301,69 +275,235 @@ QString JsonMessage::getJsonMessage(bool compact) {
 // 获取 JSON 对象
 QJsonObject JsonMessage::getJsonObject() {
     QMutexLocker locker(&_mutex);
+
+    // 逐站点读取快照
+    StatusCount count;
+    QJsonArray stationArray;
+    for (SlotEntry& entry : _slots) {
+        if (entry.slot) {
+            stationArray.append(stationToJson(readEntry(entry, count)));
+        }
+    }
     updateTimeStampIfNeeded();
 
     QJsonObject root;
     root["node"] = _nodeName;
     root["time"] = _timeMessage.toString("yyyy-MM-dd hh:mm:ss");
+    root["state"] = stateToJson(count);
+    root["station"] = stationArray;
+    return root;
+}
 
-    // 统计
-    QJsonObject state;
-    state["total"] = _totalStationCount;
-    state["connected"] = _connectedStationCount;
-    state["timeout"] = _timeoutStationCount;
-    state["disconnect"] = _disconnectStationCount;
-    state["error"] = _errorStationCount;
-    root["state"] = state;
-
-    // 逐站点构建
+//// 增量发布
+// ----------------------------------------------------------------------------
+
+// 全量快照：包含所有站点，并以此作为后续增量消息的基线
+QString JsonMessage::getFullMessage(bool compact) {
+    QJsonDocument doc(getFullObject());
+    return QString::fromUtf8(doc.toJson(compact ? QJsonDocument::Compact : QJsonDocument::Indented));
+}
+
+// 增量消息：只包含状态、延迟分档或吞吐量分档发生变化的站点
+QString JsonMessage::getDeltaMessage(bool compact) {
+    QJsonObject root = getDeltaObject();
+    if (root.isEmpty()) {
+        return QString();
+    }
+    QJsonDocument doc(root);
+    return QString::fromUtf8(doc.toJson(compact ? QJsonDocument::Compact : QJsonDocument::Indented));
+}
+
+QJsonObject JsonMessage::getFullObject() {
+    QMutexLocker locker(&_mutex);
+
+    StatusCount count;
+    QJsonArray stationArray;
+    for (SlotEntry& entry : _slots) {
+        if (entry.slot) {
+            StationInfo s = readEntry(entry, count);
+            stationArray.append(stationToJson(s));
+            markPublished(entry, s);
+        }
+    }
+    updateTimeStampIfNeeded();
+
+    _sequence++;
+    _fullSequence = _sequence;
+
+    QJsonObject root;
+    root["type"] = "full";
+    root["seq"] = static_cast<qint64>(_sequence);
+    root["node"] = _nodeName;
+    root["time"] = _timeMessage.toString("yyyy-MM-dd hh:mm:ss");
+    root["state"] = stateToJson(count);
+    root["station"] = stationArray;
+    _removedStations.clear();
+    return root;
+}
+
+QJsonObject JsonMessage::getDeltaObject() {
+    QMutexLocker locker(&_mutex);
+
+    StatusCount count;
     QJsonArray stationArray;
-    for (auto it = _stations.constBegin(); it != _stations.constEnd(); ++it) {
-        const StationInfo& s = it.value();
-        QJsonObject obj;
-        obj["ID"] = s.id;
-        obj["status"] = statusToString(s.status);
-
-        // 根据状态填充 data
-        QJsonArray dataArr;
-        switch (s.status) {
-        case StationStatus::Connected:
-            dataArr.append(QString::number(s.lastLatencyMs, 'f', 2));
-            dataArr.append(s.lastThroughput);
-            break;
-        case StationStatus::Timeout:
-        case StationStatus::Error:
-            dataArr.append(s.msg);
-            break;
-        case StationStatus::Disconnect:
-            // 留空
-            break;
+    for (SlotEntry& entry : _slots) {
+        if (!entry.slot) {
+            continue;
+        }
+        StationInfo s = readEntry(entry, count);
+        if (stationChanged(entry, s)) {
+            stationArray.append(stationToJson(s));
+            markPublished(entry, s);
         }
-        obj["data"] = dataArr;
-        stationArray.append(obj);
     }
+
+    if (stationArray.isEmpty() && _removedStations.isEmpty()) {
+        return QJsonObject();
+    }
+
+    _timeStampDirty = true; // 有变化的站点，与全量快照共用同一时间戳来源
+    updateTimeStampIfNeeded();
+    _sequence++;
+
+    QJsonObject root;
+    root["type"] = "delta";
+    root["seq"] = static_cast<qint64>(_sequence);
+    root["base"] = static_cast<qint64>(_fullSequence);
+    root["node"] = _nodeName;
+    root["time"] = _timeMessage.toString("yyyy-MM-dd hh:mm:ss");
+    root["state"] = stateToJson(count);
     root["station"] = stationArray;
+    if (!_removedStations.isEmpty()) {
+        root["removed"] = QJsonArray::fromStringList(_removedStations);
+        _removedStations.clear();
+    }
     return root;
 }
 
+quint32 JsonMessage::getSequence() {
+    QMutexLocker locker(&_mutex);
+    return _sequence;
+}
+
+//// RTCM消息类型统计
+// ----------------------------------------------------------------------------
+
+// 各站点按消息类型的累计计数，由发布服务发往 <topic>/rtcm
+QJsonObject JsonMessage::getMessageTypeObject() {
+    QMutexLocker locker(&_mutex);
+
+    QJsonArray stationArray;
+    for (const SlotEntry& entry : _slots) {
+        if (entry.slot) {
+            QJsonObject obj;
+            obj["ID"] = entry.slot->id();
+            obj["types"] = entry.slot->messageTypes();
+            stationArray.append(obj);
+        }
+    }
+
+    updateTimeStampIfNeeded();
+
+    QJsonObject root;
+    root["node"] = _nodeName;
+    root["time"] = _timeMessage.toString("yyyy-MM-dd hh:mm:ss");
+    root["station"] = stationArray;
+    return root;
+}
+
+//// 状态变化事件
+// ----------------------------------------------------------------------------
+
+void JsonMessage::setEventInterval(int seconds) {
+    QMutexLocker locker(&_mutex);
+    _eventIntervalMs = qint64(qMax(0, seconds)) * 1000;
+}
+
+// 定时检查：恢复为 Connected 的站点以及限流期结束后仍未报告的变化在这里发出
+void JsonMessage::checkEvents() {
+    QList<QJsonObject> events;
+    {
+        QMutexLocker locker(&_mutex);
+        qint64 now = QDateTime::currentMSecsSinceEpoch();
+        for (SlotEntry& entry : _slots) {
+            QJsonObject event;
+            if (entry.slot && makeEvent(entry, now, event)) {
+                events.append(event);
+            }
+        }
+    }
+    for (const QJsonObject& event : events) {
+        emit stationEvent(event);
+    }
+}
+
+void JsonMessage::checkStationEvent(const QString& id) {
+    QJsonObject event;
+    {
+        QMutexLocker locker(&_mutex);
+        auto it = _index.constFind(id);
+        if (it == _index.constEnd()) {
+            return;
+        }
+        SlotEntry& entry = _slots[it.value()];
+        if (!makeEvent(entry, QDateTime::currentMSecsSinceEpoch(), event)) {
+            // 限流期内的变化合并到下一次事件中
+            if (entry.slot->status() != entry.eventStatus) {
+                entry.suppressed++;
+            }
+            return;
+        }
+    }
+    emit stationEvent(event);
+}
+
+// 事件消息：{"type":"event","node":..,"time":..,"ID":..,"from":..,"to":..,"data":[..],"suppressed":n}
+bool JsonMessage::makeEvent(SlotEntry& entry, qint64 nowMSecs, QJsonObject& event) {
+    if (entry.slot->status() == entry.eventStatus) {
+        return false;
+    }
+    if (entry.lastEventMSecs > 0 && nowMSecs - entry.lastEventMSecs < _eventIntervalMs) {
+        return false;
+    }
+    StationInfo s = entry.slot->info();
+
+    QJsonObject station = stationToJson(s);
+    event = QJsonObject();
+    event["type"] = "event";
+    event["node"] = _nodeName;
+    event["time"] = QDateTime::fromMSecsSinceEpoch(nowMSecs).toString("yyyy-MM-dd hh:mm:ss");
+    event["ID"] = s.id;
+    event["from"] = statusToString(entry.eventStatus);
+    event["to"] = statusToString(s.status);
+    event["data"] = station["data"];
+    event["suppressed"] = entry.suppressed;
+
+    entry.eventStatus = s.status;
+    entry.lastEventMSecs = nowMSecs;
+    entry.suppressed = 0;
+    return true;
+}
+
 //// 清除数据
 // ----------------------------------------------------------------------------
 
 void JsonMessage::clear() {
     QMutexLocker locker(&_mutex);
-    _stations.clear();
-    _totalStationCount = _connectedStationCount = _timeoutStationCount =
-        _disconnectStationCount = _errorStationCount = 0;
-    _timeStampDirty = true;
+    clearSlots();
 }
 
+// 移除站点：释放表项下标以便复用；数据流线程持有的状态槽仍然有效，只是不再发布
 void JsonMessage::removeStation(const QString& id) {
     QMutexLocker locker(&_mutex);
-    auto it = _stations.find(id);
-    if (it != _stations.end()) {
-        decrementStatusCount(it.value().status);
-        _totalStationCount--;
-        _stations.erase(it);
+    auto it = _index.find(id);
+    if (it != _index.end()) {
+        SlotEntry& entry = _slots[it.value()];
+        if (entry.published) {
+            _removedStations.append(id);
+        }
+        entry.slot.clear();
+        _freeSlots.append(it.value());
+        _index.erase(it);
         _timeStampDirty = true;
     }
 }
@@ -371,52 +511,148 @@ void JsonMessage::removeStation(const QString& id) {
 //// 私有辅助
 // ----------------------------------------------------------------------------
 
-void JsonMessage::updateStationCount() {
-    _totalStationCount = _stations.size();
+StationSlotPtr JsonMessage::findOrAddSlot(const QString& id) {
+    auto it = _index.constFind(id);
+    if (it != _index.constEnd()) {
+        return _slots[it.value()].slot;
+    }
+
+    SlotEntry entry;
+    entry.slot = StationSlotPtr(new StationSlot(id));
+    entry.seenStatus = StationStatus::Disconnect;
+    entry.published = false;
+    entry.publishedStatus = StationStatus::Disconnect;
+    entry.publishedLatencyBucket = 0;
+    entry.publishedThroughputBucket = 0;
+    entry.eventStatus = StationStatus::Disconnect;
+    entry.lastEventMSecs = 0;
+    entry.suppressed = 0;
+
+    int idx;
+    if (!_freeSlots.isEmpty()) {
+        idx = _freeSlots.takeLast();
+        _slots[idx] = entry;
+    }
+    else {
+        idx = _slots.size();
+        _slots.append(entry);
+    }
+    _index.insert(id, idx);
+    _timeStampDirty = true;
+    return entry.slot;
 }
 
-void JsonMessage::updateStatusCount() {
-    _connectedStationCount = _timeoutStationCount = _disconnectStationCount = _errorStationCount = 0;
-    for (auto it = _stations.constBegin(); it != _stations.constEnd(); ++it) {
-        incrementStatusCount(it.value().status);
+StationSlotPtr JsonMessage::findSlot(const QString& id) {
+    QMutexLocker locker(&_mutex);
+    auto it = _index.constFind(id);
+    if (it == _index.constEnd()) {
+        return StationSlotPtr();
     }
+    return _slots[it.value()].slot;
 }
 
-void JsonMessage::incrementStatusCount(StationStatus status) {
-    switch (status) {
-    case StationStatus::Connected: _connectedStationCount++;
-        break;
-    case StationStatus::Timeout: _timeoutStationCount++;
-        break;
-    case StationStatus::Disconnect: _disconnectStationCount++;
-        break;
-    case StationStatus::Error: _errorStationCount++;
-        break;
+StationInfo JsonMessage::readEntry(SlotEntry& entry, StatusCount& count) {
+    StationInfo s = entry.slot->info();
+    if (s.status != entry.seenStatus) {
+        entry.seenStatus = s.status;
+        _timeStampDirty = true;
     }
+    count.add(s.status);
+    return s;
 }
 
-void JsonMessage::decrementStatusCount(StationStatus status) {
-    switch (status) {
+void JsonMessage::clearSlots() {
+    for (const SlotEntry& entry : _slots) {
+        if (entry.slot && entry.published) {
+            _removedStations.append(entry.slot->id());
+        }
+    }
+    _slots.clear();
+    _freeSlots.clear();
+    _index.clear();
+    _timeStampDirty = true;
+}
+
+void JsonMessage::updateTimeStampIfNeeded() {
+    if (_timeStampDirty) {
+        _timeMessage = QDateTime::currentDateTime();
+        _timeStampDirty = false;
+    }
+}
+
+QJsonObject JsonMessage::stationToJson(const StationInfo& s) const {
+    QJsonObject obj;
+    obj["ID"] = s.id;
+    obj["status"] = statusToString(s.status);
+
+    // 根据状态填充 data
+    QJsonArray dataArr;
+    switch (s.status) {
     case StationStatus::Connected:
-        if (_connectedStationCount > 0) _connectedStationCount--;
+        dataArr.append(QString::number(s.lastLatency, 'f', 2));
+        dataArr.append(s.lastThroughput);
         break;
     case StationStatus::Timeout:
-        if (_timeoutStationCount > 0) _timeoutStationCount--;
+    case StationStatus::Error:
+        dataArr.append(s.msg);
         break;
     case StationStatus::Disconnect:
-        if (_disconnectStationCount > 0) _disconnectStationCount--;
-        break;
-    case StationStatus::Error:
-        if (_errorStationCount > 0) _errorStationCount--;
+        // 留空
         break;
     }
+    obj["data"] = dataArr;
+    obj["stats"] = s.stats;
+    return obj;
 }
 
-void JsonMessage::updateTimeStampIfNeeded() {
-    if (_timeStampDirty) {
-        _timeMessage = QDateTime::currentDateTime();
-        _timeStampDirty = false;
+QJsonObject JsonMessage::stateToJson(const StatusCount& count) const {
+    QJsonObject state;
+    state["total"] = count.connected + count.timeout + count.disconnect + count.error;
+    state["connected"] = count.connected;
+    state["timeout"] = count.timeout;
+    state["disconnect"] = count.disconnect;
+    state["error"] = count.error;
+    return state;
+}
+
+bool JsonMessage::stationChanged(const SlotEntry& entry, const StationInfo& s) const {
+    if (!entry.published || entry.publishedStatus != s.status) {
+        return true;
+    }
+    if (s.status != StationStatus::Connected) {
+        return false;
+    }
+    if (entry.publishedLatencyBucket != latencyBucket(s.lastLatency)) {
+        return true;
+    }
+    // 吞吐量按1分钟平均分档，且在档位边界 10% 以内不算变化（防止来回跳档）
+    int published = entry.publishedThroughputBucket;
+    return throughputBucket(s.throughputRate) != published &&
+           throughputBucket(s.throughputRate * 1.1) != published &&
+           throughputBucket(s.throughputRate / 1.1) != published;
+}
+
+void JsonMessage::markPublished(SlotEntry& entry, const StationInfo& s) {
+    entry.published = true;
+    entry.publishedStatus = s.status;
+    entry.publishedLatencyBucket = latencyBucket(s.lastLatency);
+    entry.publishedThroughputBucket = throughputBucket(s.throughputRate);
+}
+
+// 延迟分档（秒）：1 秒以内每 250ms 一档，1 秒以上按 2 的幂分档
+int JsonMessage::latencyBucket(double latency) {
+    if (latency < 1.0) {
+        return latency > 0.0 ? static_cast<int>(latency / 0.25) : 0;
+    }
+    return 4 + static_cast<int>(std::floor(std::log2(latency)));
+}
+
+// 吞吐量分档（字节/秒）：按 2 的幂分档，不足 1 字节/秒单独一档
+int JsonMessage::throughputBucket(double bytesPerSec) {
+    if (bytesPerSec < 1.0) {
+        return 0;
     }
+    return 1 + static_cast<int>(std::floor(std::log2(bytesPerSec)));
 }
 
 QString JsonMessage::statusToString(StationStatus status) const {
@@ -10,10 +10,14 @@
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonValue>
-#include <QMap>
+#include <QHash>
+#include <QVector>
 #include <QObject>
 #include <QMutex>
+#include <QAtomicInt>
+#include <QSharedPointer>
 #include <bncsettings.h>
+#include "stationStats.h"
 
 // 站点状态枚举
 enum class StationStatus
@@ -24,28 +28,66 @@ enum class StationStatus
     Error // 异常状态
 };
 
-// 单个站点信息结构体
+// 单个站点信息结构体（发布时从状态槽读取的快照）
 struct StationInfo {
     QString       id;               // 站点ID
     StationStatus status;           // 站点状态
     QDateTime     lastDateTime;     // 最后正常数据接收时间
-    double        lastLatencyMs;    // 最新延迟（毫秒）
+    double        lastLatency;      // 最新延迟（秒）
     int           lastThroughput;   // 最新吞吐量（字节）
+    double        throughputRate;   // 1分钟平均吞吐量（字节/秒）
     QString       msg;              // 站点错误信息描述
+    QJsonObject   stats;            // 滑动窗口统计（1m/5m/1h）
 
     StationInfo()
         : status(StationStatus::Disconnect)
-        , lastLatencyMs(0)
-        , lastThroughput(0) {}
-
-    explicit StationInfo(const QString& stationId)
-        : id(stationId)
-        , status(StationStatus::Disconnect)
-        , lastDateTime(QDateTime::currentDateTime())
-        , lastLatencyMs(0)
-        , lastThroughput(0) {}
+        , lastLatency(0)
+        , lastThroughput(0)
+        , throughputRate(0) {}
 };
 
+// 单个站点状态槽
+// 在 bncCaster::addGetThread 时分配一次，之后地址固定；
+// 数据流线程只做原子写入，发布线程读取时互不阻塞。
+class StationSlot
+{
+public:
+    explicit StationSlot(const QString& stationId);
+
+    //// 数据流线程调用（无锁）
+    /////----------------------------------------------------------
+    void updateLatency(double latency); // 秒，与 latencyChecker::currentLatency() 相同
+    void updateThroughput(int bytes);
+    void setTimeout();
+    void setDisconnected();
+    void setError(const QString& reason); // 低频路径，错误描述需加锁
+    void addMessages(int count); // 解码出的RTCM消息数
+    void addEpochs(int count);   // 解码出的观测历元数
+    void addMessageType(int type, int bytes); // 单条RTCM消息（按类型计数）
+
+    //// 发布线程调用
+    /////----------------------------------------------------------
+    const QString& id() const { return _id; }
+    StationStatus status() const;
+    StationInfo info() const; // 读取当前状态快照（含窗口统计）
+    QJsonArray messageTypes() const { return _typeStats.toJson(); } // 按消息类型的计数
+
+private:
+    void touch(); // 更新最后数据接收时间
+
+    const QString          _id;          // 站点ID，分配后只读
+    QAtomicInt             _status;      // StationStatus
+    QAtomicInteger<qint64> _lastMSecs;   // 最后正常数据接收时间（毫秒，UTC纪元）
+    QAtomicInteger<qint64> _latencyUs;   // 最新延迟（微秒）
+    QAtomicInt             _throughput;  // 最新吞吐量（字节）
+    mutable QMutex         _msgMutex;    // 仅保护 _msg
+    QString                _msg;         // 错误描述
+    StationStats           _stats;       // 滑动窗口统计
+    MessageTypeStats       _typeStats;   // 按RTCM消息类型计数
+};
+
+typedef QSharedPointer<StationSlot> StationSlotPtr;
+
 // 存储多个站点信息的类
 class JsonMessage : public QObject
 {
@@ -58,7 +100,7 @@ public:
     //// 设置相关
     //----------------------------------------------------------
     void setNodeName(const QString& name); // 设置节点名称
-    void addStation(const QString& id); //添加单个站点
+    StationSlotPtr addStation(const QString& id); //添加单个站点，返回其状态槽
     void updateStationList();//更新站点列表
 
     void initStationList(const QStringList& ids); //手动初始化站点列表
@@ -70,11 +112,31 @@ public:
     QString getJsonMessage(bool compact = false); // 外部获取JSON消息，字符串
     QJsonObject getJsonObject(); // 获取JSON对象
 
+    //// 增量发布
+    /////----------------------------------------------------------
+    QString getFullMessage(bool compact = true);  // 全量快照（带序号），同时记录增量基线
+    QString getDeltaMessage(bool compact = true); // 自上次发布以来有变化的站点，无变化时返回空串
+    QJsonObject getFullObject();  // 同 getFullMessage，返回消息对象供编码器使用
+    QJsonObject getDeltaObject(); // 同 getDeltaMessage，无变化时返回空对象
+    quint32 getSequence(); // 最近一次发布的序号
+
+    //// RTCM消息类型统计（单独子主题）
+    /////----------------------------------------------------------
+    QJsonObject getMessageTypeObject();
+
+    //// 状态变化事件
+    /////----------------------------------------------------------
+    void setEventInterval(int seconds); // 同一站点两次事件的最小间隔，期间的变化合并
+    void checkEvents(); // 检查所有站点的状态变化（定时调用，发出被限流推迟的事件）
+
     //// 清除数据
     /////----------------------------------------------------------
     void clear(); //清空所有站点
     void removeStation(const QString& id); //移除一个站点
 
+signals:
+    void stationEvent(const QJsonObject& event); // 站点状态变化事件
+
 public slots:
     void slotUpdateLatency(const QByteArray& staID, double latency);// 更新站点延迟
     void slotUpdateThroughput(const QByteArray& staID, int bytes);// 更新站点吞吐量
@@ -83,32 +145,72 @@ public slots:
     void slotOnStaError(const QByteArray& staID, const QString& reason);// 发生异常错误
 
 private:
-    // 更新站点数量，增减站点数时触发
-    void updateStationCount();
-    // 更新站点状态计数即：正常站点数，超时站点数等，站点数据改变时触发
-    void updateStatusCount();
-    // 增加指定状态的计数（优化性能用）
-    void incrementStatusCount(StationStatus status);
-    // 减少指定状态的计数（优化性能用）
-    void decrementStatusCount(StationStatus status);
+    // 站点表项：状态槽 + 发布线程私有的发布基线
+    struct SlotEntry {
+        StationSlotPtr slot;                      // 为空表示该位置空闲
+        StationStatus  seenStatus;                // 上次读取时的状态（用于时间戳更新）
+        bool           published;                 // 是否已发布过
+        StationStatus  publishedStatus;           // 上次发布的状态
+        int            publishedLatencyBucket;    // 上次发布的延迟分档
+        int            publishedThroughputBucket; // 上次发布的吞吐量（1分钟平均）分档
+        StationStatus  eventStatus;               // 上次事件报告的状态
+        qint64         lastEventMSecs;            // 上次事件时间（毫秒，0 表示尚无事件）
+        int            suppressed;                // 限流期间合并的状态变化次数
+    };
+
+    // 各状态站点数
+    struct StatusCount {
+        int connected;
+        int timeout;
+        int disconnect;
+        int error;
+        StatusCount() : connected(0), timeout(0), disconnect(0), error(0) {}
+        void add(StationStatus status);
+    };
+
+    // 按ID查找状态槽，不存在时自动添加（调用者需持有 _mutex）
+    StationSlotPtr findOrAddSlot(const QString& id);
+    // 按ID查找状态槽，不存在（或已移除）时返回空指针
+    StationSlotPtr findSlot(const QString& id);
+    // 读取站点快照，并在状态变化时标记时间戳（调用者需持有 _mutex）
+    StationInfo readEntry(SlotEntry& entry, StatusCount& count);
+    // 清空站点表（调用者需持有 _mutex）
+    void clearSlots();
     // 按需更新时间戳
     void updateTimeStampIfNeeded();
     // 状态枚举转字符串
     QString statusToString(StationStatus status) const;
+    // 单个站点、统计信息转JSON
+    QJsonObject stationToJson(const StationInfo& s) const;
+    QJsonObject stateToJson(const StatusCount& count) const;
+    // 站点是否需要在增量消息中发布
+    bool stationChanged(const SlotEntry& entry, const StationInfo& s) const;
+    // 记录站点的发布基线
+    void markPublished(SlotEntry& entry, const StationInfo& s);
+    // 站点状态与上次事件不同且不在限流期内时生成事件（调用者需持有 _mutex）
+    bool makeEvent(SlotEntry& entry, qint64 nowMSecs, QJsonObject& event);
+    // 信号触发的单站检查：立即发出事件，或在限流期内记为合并
+    void checkStationEvent(const QString& id);
+    // 延迟、吞吐量分档
+    static int latencyBucket(double latency);
+    static int throughputBucket(double bytesPerSec);
 
 private:
-    QMutex _mutex;  // 保护站点数据线程安全
+    QMutex _mutex;  // 保护站点表结构（增删站点与发布），数据流线程不获取此锁
     QString _nodeName; // 节点名称
     QDateTime _timeMessage; // 消息时间戳
-    int _totalStationCount; // 站点数量
-    int _connectedStationCount; // 正常站点数
-    int _timeoutStationCount; // 超时站点数
-    int _disconnectStationCount; // 断开站点数
-    int _errorStationCount; // 异常站点数
 
     bool _timeStampDirty; // 时间戳脏位标记
 
-    QMap<QString, StationInfo> _stations; // 所有站点信息（使用QMap便于查找）
+    quint32 _sequence;     // 消息序号（全量与增量共用，用于检测丢包）
+    quint32 _fullSequence; // 最近一次全量快照的序号
+    QStringList _removedStations; // 自上次发布以来移除的站点
+
+    QVector<SlotEntry> _slots;     // 站点表（固定下标）
+    QVector<int>       _freeSlots; // 空闲下标
+    QHash<QString, int> _index;    // 站点ID -> 下标
+
+    qint64 _eventIntervalMs; // 同一站点事件最小间隔（毫秒）
 };
 
 #endif // JSONMESSAGE_H
@@ -0,0 +1,191 @@
+#include "messageEncoder.h"
+#include <QCborStreamWriter>
+#include <QJsonArray>
+#include <QLocale>
+#include <cmath>
+
+// 工厂
+// ----------------------------------------------------------------------------
+MessageEncoder* MessageEncoder::create(const QString& format) {
+    if (format.compare("CBOR", Qt::CaseInsensitive) == 0) {
+        return new CborEncoder();
+    }
+    return new JsonEncoder();
+}
+
+// QByteArray::resize(0) 只有在预留过容量时才保留内存
+void MessageEncoder::resetBuffer() {
+    _buffer.reserve(qMax(_buffer.capacity(), 4096));
+    _buffer.resize(0);
+}
+
+//// JSON
+// ----------------------------------------------------------------------------
+const QByteArray& JsonEncoder::encode(const QJsonObject& obj) {
+    resetBuffer();
+    writeValue(obj);
+    return _buffer;
+}
+
+// 与 QJsonDocument::Compact 相同的格式；整数值的 double 按整数写出
+void JsonEncoder::writeValue(const QJsonValue& value) {
+    switch (value.type()) {
+    case QJsonValue::Null:
+    case QJsonValue::Undefined:
+        _buffer.append("null");
+        break;
+    case QJsonValue::Bool:
+        _buffer.append(value.toBool() ? "true" : "false");
+        break;
+    case QJsonValue::Double: {
+        double d = value.toDouble();
+        if (!std::isfinite(d)) {
+            _buffer.append("null");
+        }
+        else if (d == std::floor(d) && std::fabs(d) < 9.0e15) {
+            char hlp[32];
+            int  len = qsnprintf(hlp, sizeof(hlp), "%lld", static_cast<long long>(d));
+            _buffer.append(hlp, len);
+        }
+        else {
+            _buffer.append(QByteArray::number(d, 'g', QLocale::FloatingPointShortest));
+        }
+        break;
+    }
+    case QJsonValue::String:
+        writeString(value.toString());
+        break;
+    case QJsonValue::Array: {
+        const QJsonArray arr = value.toArray();
+        _buffer.append('[');
+        for (int ii = 0; ii < arr.size(); ii++) {
+            if (ii > 0) {
+                _buffer.append(',');
+            }
+            writeValue(arr.at(ii));
+        }
+        _buffer.append(']');
+        break;
+    }
+    case QJsonValue::Object: {
+        const QJsonObject obj = value.toObject();
+        _buffer.append('{');
+        for (auto it = obj.constBegin(); it != obj.constEnd(); ++it) {
+            if (it != obj.constBegin()) {
+                _buffer.append(',');
+            }
+            writeString(it.key());
+            _buffer.append(':');
+            writeValue(it.value());
+        }
+        _buffer.append('}');
+        break;
+    }
+    }
+}
+
+// 带引号的字符串，按 JSON 规则转义，非 ASCII 字符直接编码为 UTF-8（无临时缓冲区）
+void JsonEncoder::writeString(const QString& str) {
+    static const char hex[] = "0123456789abcdef";
+    _buffer.append('"');
+    const int len = str.size();
+    for (int ii = 0; ii < len; ii++) {
+        uint uc = str.at(ii).unicode();
+        if (uc < 0x80) {
+            switch (uc) {
+            case '"':  _buffer.append("\\\""); break;
+            case '\\': _buffer.append("\\\\"); break;
+            case '\b': _buffer.append("\\b"); break;
+            case '\f': _buffer.append("\\f"); break;
+            case '\n': _buffer.append("\\n"); break;
+            case '\r': _buffer.append("\\r"); break;
+            case '\t': _buffer.append("\\t"); break;
+            default:
+                if (uc < 0x20) {
+                    _buffer.append("\\u00");
+                    _buffer.append(hex[uc >> 4]);
+                    _buffer.append(hex[uc & 0xf]);
+                }
+                else {
+                    _buffer.append(static_cast<char>(uc));
+                }
+            }
+            continue;
+        }
+        if (QChar::isHighSurrogate(uc) && ii + 1 < len && str.at(ii + 1).isLowSurrogate()) {
+            uc = QChar::surrogateToUcs4(static_cast<ushort>(uc), str.at(++ii).unicode());
+        }
+        else if (QChar::isSurrogate(uc)) {
+            uc = 0xfffd; // 不成对的代理项
+        }
+        if (uc < 0x800) {
+            _buffer.append(static_cast<char>(0xc0 | (uc >> 6)));
+        }
+        else {
+            if (uc < 0x10000) {
+                _buffer.append(static_cast<char>(0xe0 | (uc >> 12)));
+            }
+            else {
+                _buffer.append(static_cast<char>(0xf0 | (uc >> 18)));
+                _buffer.append(static_cast<char>(0x80 | ((uc >> 12) & 0x3f)));
+            }
+            _buffer.append(static_cast<char>(0x80 | ((uc >> 6) & 0x3f)));
+        }
+        _buffer.append(static_cast<char>(0x80 | (uc & 0x3f)));
+    }
+    _buffer.append('"');
+}
+
+//// CBOR
+// ----------------------------------------------------------------------------
+const QByteArray& CborEncoder::encode(const QJsonObject& obj) {
+    resetBuffer();
+    QCborStreamWriter writer(&_buffer);
+    writeValue(writer, obj);
+    return _buffer;
+}
+
+// 逐节点写出，不构造中间的 QCborValue 树；整数值的 double 按整数编码以减小体积
+void CborEncoder::writeValue(QCborStreamWriter& writer, const QJsonValue& value) {
+    switch (value.type()) {
+    case QJsonValue::Null:
+    case QJsonValue::Undefined:
+        writer.append(nullptr);
+        break;
+    case QJsonValue::Bool:
+        writer.append(value.toBool());
+        break;
+    case QJsonValue::Double: {
+        double d = value.toDouble();
+        if (d == std::floor(d) && std::fabs(d) < 9.0e15) {
+            writer.append(static_cast<qint64>(d));
+        }
+        else {
+            writer.append(d);
+        }
+        break;
+    }
+    case QJsonValue::String:
+        writer.append(value.toString());
+        break;
+    case QJsonValue::Array: {
+        const QJsonArray arr = value.toArray();
+        writer.startArray(arr.size());
+        for (const QJsonValue& item : arr) {
+            writeValue(writer, item);
+        }
+        writer.endArray();
+        break;
+    }
+    case QJsonValue::Object: {
+        const QJsonObject obj = value.toObject();
+        writer.startMap(obj.size());
+        for (auto it = obj.constBegin(); it != obj.constEnd(); ++it) {
+            writer.append(it.key());
+            writeValue(writer, it.value());
+        }
+        writer.endMap();
+        break;
+    }
+    }
+}
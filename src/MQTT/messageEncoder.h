@@ -0,0 +1,57 @@
+#ifndef MESSAGEENCODER_H
+#define MESSAGEENCODER_H
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+
+class QCborStreamWriter;
+
+/**
+ * @brief MQTT消息编码器
+ * 将 JsonMessage 生成的消息对象直接编码为发布用的字节数组，
+ * 不再经过 QString 中转。编码结果保存在编码器内部可复用的缓冲区中，
+ * 在下一次 encode() 之前有效。
+ */
+class MessageEncoder
+{
+public:
+    virtual ~MessageEncoder() {}
+
+    virtual const QByteArray& encode(const QJsonObject& obj) = 0;
+    virtual QString name() const = 0;
+
+    // 按配置名称创建编码器："CBOR" 或 "JSON"（默认）
+    static MessageEncoder* create(const QString& format);
+
+protected:
+    void resetBuffer(); // 清空缓冲区但保留已分配的内存
+
+    QByteArray _buffer;
+};
+
+// JSON 文本（紧凑格式），逐节点写入缓冲区，不经过 QJsonDocument
+class JsonEncoder : public MessageEncoder
+{
+public:
+    const QByteArray& encode(const QJsonObject& obj) override;
+    QString name() const override { return "JSON"; }
+
+private:
+    void writeValue(const QJsonValue& value);
+    void writeString(const QString& str);
+};
+
+// CBOR（RFC 7049），用 QCborStreamWriter 直接写入缓冲区
+class CborEncoder : public MessageEncoder
+{
+public:
+    const QByteArray& encode(const QJsonObject& obj) override;
+    QString name() const override { return "CBOR"; }
+
+private:
+    static void writeValue(QCborStreamWriter& writer, const QJsonValue& value);
+};
+
+#endif // MESSAGEENCODER_H
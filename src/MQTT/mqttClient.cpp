@@ -3,6 +3,8 @@
 #include <QDebug>
 #include <QString>
 #include <QByteArray>
+#include <QIODevice>
+#include <QRandomGenerator>
 #include <cmath>
 
 
@@ -11,7 +13,9 @@ MqttClient::MqttClient(QObject* parent)
       , m_client(nullptr)
       , m_port(1883)
       , m_connectionCheckEnabled(true)
-      , m_autoSendMessageEnabled(true) {
+      , m_autoSendMessageEnabled(true)
+      , m_offlineQueue(new MqttOfflineQueue())
+      , m_drainRate(50) {
     initializeClient();
 
     // 初始化连接检查定时器
@@ -23,10 +27,27 @@ MqttClient::MqttClient(QObject* parent)
     m_sendMessageTimer = new QTimer(this);
     m_sendMessageTimer->setInterval(10000); // 默认10秒
     connect(m_sendMessageTimer, &QTimer::timeout, this, &MqttClient::autoSendMessage);
+
+    // 重连定时器
+    m_reconnectTimer = new QTimer(this);
+    m_reconnectTimer->setSingleShot(true);
+    connect(m_reconnectTimer, &QTimer::timeout, this, [this]() {
+        if (isConnected()) {
+            return;
+        }
+        emit mqttLogMessage(QString("自动重连MQTT服务，尝试次数: %1").arg(m_reconnectAttempts).toUtf8());
+        connectToHost();
+    });
+
+    // 离线队列补发定时器
+    m_drainTimer = new QTimer(this);
+    m_drainTimer->setInterval(100);
+    connect(m_drainTimer, &QTimer::timeout, this, &MqttClient::drainQueue);
 }
 
 MqttClient::~MqttClient() {
     stopMqttClient();
+    delete m_offlineQueue;
 }
 
 void MqttClient::initializeClient() {
@@ -48,6 +69,7 @@ void MqttClient::setupSignalSlots() {
     // 消息接收信号
     connect(m_client, &QMqttClient::messageReceived, this, &MqttClient::onMessageReceived);
     connect(m_client, &QMqttClient::pingResponseReceived, this, &MqttClient::onPingResponseReceived);
+    connect(m_client, &QMqttClient::messageSent, this, &MqttClient::onMessageSent);
 }
 
 void MqttClient::setConnectionParameters(const QString &host, quint16 port, const QString& topic, const QString& clientId) {
@@ -106,6 +128,10 @@ void MqttClient::stopMqttClient() {
     // 停止发送消息定时器
     enableAutoSendMessage(false);
 
+    // 停止重连与补发
+    m_reconnectTimer->stop();
+    m_drainTimer->stop();
+
     // 断开MQTT连接
     disconnectFromHost();
 
@@ -113,23 +139,37 @@ void MqttClient::stopMqttClient() {
 }
 
 qint32 MqttClient::publishMessage(const QString& topic, const QString& message, quint8 qos, bool retain) {
-    if (!isConnected()) {
-        m_lastError = "MQTT客户端未连接";
-        emit mqttLogMessage("MQTT客户端未连接");
-        return -1;
-    }
+    return publishPayload(topic, message.toUtf8(), qos, retain);
+}
 
-    if (topic.isEmpty()) {
+qint32 MqttClient::publishPayload(const QString& topic, const QByteArray& payload, quint8 qos, bool retain) {
+    return publishQueued(MqttQueuedMessage(topic, payload, qos, retain));
+}
+
+qint32 MqttClient::publishSnapshot(const QString& topic, const QByteArray& payload, quint8 qos, bool retain) {
+    return publishQueued(MqttQueuedMessage(topic, payload, qos, retain, true));
+}
+
+qint32 MqttClient::publishQueued(const MqttQueuedMessage& msg) {
+    if (msg.topic.isEmpty()) {
         m_lastError = "发布主题不能为空";
         emit mqttLogMessage("发布主题不能为空");
         return -1;
     }
 
-    qint32 messageId = m_client->publish(QMqttTopicName(topic), message.toUtf8(), qos, retain);
+    // 未连接或离线队列尚未补发完时入队，保证消息顺序
+    if (!isConnected() || !m_retryList.isEmpty() || !m_offlineQueue->isEmpty()) {
+        enqueueMessage(msg);
+        return 0;
+    }
+
+    qint32 messageId = sendMessage(msg);
 
     if (messageId == -1) {
         m_lastError = "消息发布失败";
-        emit mqttLogMessage("消息发布失败");
+        emit mqttLogMessage("消息发布失败，进入离线队列");
+        enqueueMessage(msg);
+        return 0;
     }
     else {
         emit mqttLogMessage("发布消息成功");
@@ -138,6 +178,107 @@ qint32 MqttClient::publishMessage(const QString& topic, const QString& message,
     return messageId;
 }
 
+qint32 MqttClient::publishVolatile(const QString& topic, const QByteArray& payload, qint64 maxPendingBytes) {
+    if (topic.isEmpty() || !isConnected() || pendingBytes() > maxPendingBytes) {
+        return -1;
+    }
+    return m_client->publish(QMqttTopicName(topic), payload, 0, false);
+}
+
+void MqttClient::setOfflineQueue(int maxMessages, const QString& spillFile) {
+    // 尚未补发的消息转入新队列
+    MqttOfflineQueue* queue = new MqttOfflineQueue(maxMessages, spillFile);
+    MqttQueuedMessage msg;
+    while (m_offlineQueue->dequeue(msg)) {
+        queue->enqueue(msg);
+    }
+    delete m_offlineQueue;
+    m_offlineQueue = queue;
+    m_reportedDropped = 0;
+    m_reportedCorrupted = 0;
+
+    if (!spillFile.isEmpty() && !m_offlineQueue->isSpilled()) {
+        emit mqttLogMessage(QString("无法打开离线队列文件: %1，改用内存队列").arg(spillFile).toUtf8());
+    }
+    emit mqttLogMessage(QString("设置离线队列: 最多%1条消息%2")
+                        .arg(maxMessages)
+                        .arg(m_offlineQueue->isSpilled() ? QString("，文件 %1").arg(spillFile) : QString()).toUtf8());
+    reportCorruptedQueue();
+    if (!m_offlineQueue->isEmpty()) {
+        emit mqttLogMessage(QString("离线队列中有%1条待补发消息").arg(m_offlineQueue->size()).toUtf8());
+    }
+}
+
+void MqttClient::setDrainRate(int messagesPerSec) {
+    m_drainRate = messagesPerSec > 0 ? messagesPerSec : 1;
+    emit mqttLogMessage(QString("设置离线消息补发速率: %1条/秒").arg(m_drainRate).toUtf8());
+}
+
+int MqttClient::queuedMessages() const {
+    return m_offlineQueue->size() + m_retryList.size();
+}
+
+void MqttClient::enqueueMessage(const MqttQueuedMessage& msg) {
+    m_offlineQueue->enqueue(msg);
+    if (m_offlineQueue->dropped() > m_reportedDropped) {
+        emit mqttLogMessage(QString("离线队列已满，累计丢弃最旧消息%1条")
+                            .arg(m_offlineQueue->dropped()).toUtf8(), false);
+        m_reportedDropped = m_offlineQueue->dropped();
+    }
+    reportCorruptedQueue();
+}
+
+void MqttClient::reportCorruptedQueue() {
+    if (m_offlineQueue->corrupted() > m_reportedCorrupted) {
+        emit mqttLogMessage("离线队列文件中的记录无效，已清空离线队列");
+        m_reportedCorrupted = m_offlineQueue->corrupted();
+    }
+}
+
+qint32 MqttClient::sendMessage(const MqttQueuedMessage& msg) {
+    qint32 messageId = m_client->publish(QMqttTopicName(msg.topic), msg.payload, msg.qos, msg.retain);
+    if (messageId > 0 && msg.qos > 0) {
+        m_inFlight.insert(messageId, msg);
+    }
+    return messageId;
+}
+
+void MqttClient::onMessageSent(qint32 messageId) {
+    m_inFlight.remove(messageId);
+    emit messagePublished(messageId);
+}
+
+// 补发离线队列：每次最多 m_drainRate/10 条，且未确认消息不超过 m_MAX_IN_FLIGHT
+void MqttClient::drainQueue() {
+    if (!isConnected()) {
+        m_drainTimer->stop();
+        return;
+    }
+
+    int budget = qMax(1, m_drainRate * m_drainTimer->interval() / 1000);
+    while (budget > 0 && m_inFlight.size() < m_MAX_IN_FLIGHT) {
+        MqttQueuedMessage msg;
+        if (!m_retryList.isEmpty()) {
+            msg = m_retryList.takeFirst();
+        }
+        else if (!m_offlineQueue->dequeue(msg)) {
+            reportCorruptedQueue();
+            break;
+        }
+        msg.qos = qMax<quint8>(msg.qos, 1);
+        if (sendMessage(msg) == -1) {
+            m_retryList.prepend(msg);
+            break;
+        }
+        budget--;
+    }
+
+    if (m_retryList.isEmpty() && m_offlineQueue->isEmpty()) {
+        m_drainTimer->stop();
+        emit mqttLogMessage("离线消息补发完成");
+    }
+}
+
 bool MqttClient::subscribeToTopic(const QString& topic, quint8 qos) {
     if (!isConnected()) {
         m_lastError = "MQTT客户端未连接";
@@ -153,7 +294,6 @@ bool MqttClient::subscribeToTopic(const QString& topic, quint8 qos) {
 
     auto subscription = m_client->subscribe(QMqttTopicFilter(topic), qos);
     if (subscription) {
-        m_topic = topic;
         emit mqttLogMessage(QString("订阅主题: %1 (QoS: %2)").arg(topic).arg(qos).toUtf8());
         return true;
     }
@@ -164,6 +304,13 @@ bool MqttClient::subscribeToTopic(const QString& topic, quint8 qos) {
     }
 }
 
+void MqttClient::setCommandTopic(const QString& topic) {
+    m_commandTopic = topic;
+    if (isConnected() && !m_commandTopic.isEmpty()) {
+        subscribeToTopic(m_commandTopic, 1);
+    }
+}
+
 void MqttClient::unsubscribeFromTopic(const QString& topic) {
     if (!isConnected()) {
         m_lastError = "MQTT客户端未连接";
@@ -174,6 +321,11 @@ void MqttClient::unsubscribeFromTopic(const QString& topic) {
     emit mqttLogMessage(QString("取消订阅主题: %1").arg(topic).toUtf8());
 }
 
+qint64 MqttClient::pendingBytes() const {
+    QIODevice* transport = m_client ? m_client->transport() : nullptr;
+    return transport ? transport->bytesToWrite() : 0;
+}
+
 bool MqttClient::isConnected() const {
     return m_client && m_client->state() == QMqttClient::Connected;
 }
@@ -216,7 +368,8 @@ void MqttClient::enableConnectionCheck(bool enable) {
 void MqttClient::enableAutoSendMessage(bool enable) {
     m_autoSendMessageEnabled = enable;
 
-    if (enable && isConnected()) {
+    // 断线期间也继续定时生成消息，由离线队列缓存
+    if (enable) {
         m_sendMessageTimer->start();
         emit mqttLogMessage("启用自动发送消息");
     }
@@ -230,6 +383,10 @@ void MqttClient::onStateChanged(QMqttClient::ClientState state) {
     QString stateStr = stateToString(state);
     emit mqttLogMessage(QString("连接状态变化: %1").arg(stateStr).toUtf8());
     emit connectionStateChanged(state);
+
+    if (state == QMqttClient::Disconnected) {
+        scheduleReconnect();
+    }
 }
 
 void MqttClient::onErrorChanged(QMqttClient::ClientError error) {
@@ -237,46 +394,29 @@ void MqttClient::onErrorChanged(QMqttClient::ClientError error) {
         m_lastError = errorToString(error);
         emit mqttLogMessage(QString("MQTT错误: %1").arg(m_lastError).toUtf8());
 
-        // 需要重连的错误类型
-        static const QList<QMqttClient::ClientError> reconnectErrors = {
-            QMqttClient::IdRejected,
-            QMqttClient::ServerUnavailable,
-            QMqttClient::NotAuthorized,
-            QMqttClient::TransportInvalid,
-            QMqttClient::UnknownError
-        };
-
-        // 如果是需要重连的错误类型
-        if (reconnectErrors.contains(error)&&m_connectionCheckEnabled) {
-            // 如果当前状态不是连接中或已连接
-            if (m_client->state() != QMqttClient::Connected &&
-                m_client->state() != QMqttClient::Connecting) {
-                // 检查重连次数限制
-                if (m_reconnectAttempts >= m_MAX_RECONNECT_ATTEMPTS || !m_connectionCheckEnabled) {
-                    if (m_reconnectAttempts == m_MAX_RECONNECT_ATTEMPTS) {
-                        emit mqttLogMessage("已达到最大重连次数，需手动重连MQTT服务");
-                        m_reconnectAttempts++; // 避免重复记录
-                    }
-                    return;
-                }
-                m_reconnectAttempts++; // 增加重连计数
-                // 延迟10秒后重连
-                int interval = 1000 * pow(2, m_reconnectAttempts);
-                QTimer::singleShot(interval, this, [this]() {
-                    if (m_client->state() == QMqttClient::Connected) {
-                        // 连接成功时重置计数器
-                        m_reconnectAttempts = 0;
-                        return;
-                    }
-                    // 只在重连尝试时提示,并提示次数
-                    emit mqttLogMessage(QString("自动重连MQTT服务，尝试次数: %1").arg(m_reconnectAttempts).toUtf8());
-                    this->connectToHost();
-                });
-            }
-        }
+        // 任何错误都按退避间隔重连，不限制次数
+        scheduleReconnect();
     }
 }
 
+// 带抖动的指数退避：第 n 次重连等待 [T/2, T]，T = min(2^n 秒, m_MAX_RECONNECT_DELAY)
+void MqttClient::scheduleReconnect() {
+    if (!m_connectionCheckEnabled || m_reconnectTimer->isActive()) {
+        return;
+    }
+    if (m_client->state() == QMqttClient::Connected ||
+        m_client->state() == QMqttClient::Connecting) {
+        return;
+    }
+
+    int exponent = qMin(m_reconnectAttempts, 16);
+    qint64 cap = qMin<qint64>(qint64(1000) << exponent, qint64(m_MAX_RECONNECT_DELAY) * 1000);
+    int delay = int(cap / 2) + QRandomGenerator::global()->bounded(int(cap / 2) + 1);
+    m_reconnectAttempts++;
+    m_reconnectTimer->start(delay);
+    emit mqttLogMessage(QString("%1秒后重连MQTT服务").arg(delay / 1000.0, 0, 'f', 1).toUtf8(), false);
+}
+
 void MqttClient::onMessageReceived(const QByteArray& message, const QMqttTopicName& topic) {
     QString topicStr = topic.name();
     QString messageStr = QString::fromUtf8(message);
@@ -286,6 +426,8 @@ void MqttClient::onMessageReceived(const QByteArray& message, const QMqttTopicNa
 
 void MqttClient::onConnected() {
     m_lastError.clear();
+    m_reconnectAttempts = 0;
+    m_reconnectTimer->stop();
     emit mqttLogMessage("MQTT连接成功");
     emit connected();
 
@@ -303,6 +445,15 @@ void MqttClient::onConnected() {
     if (!m_topic.isEmpty()) {
         subscribeToTopic(m_topic,0);
     }
+    if (!m_commandTopic.isEmpty()) {
+        subscribeToTopic(m_commandTopic, 1);
+    }
+
+    // 补发断线期间缓存的消息
+    if (queuedMessages() > 0) {
+        emit mqttLogMessage(QString("开始补发离线消息%1条").arg(queuedMessages()).toUtf8());
+        m_drainTimer->start();
+    }
 }
 
 void MqttClient::onDisconnected() {
@@ -310,8 +461,13 @@ void MqttClient::onDisconnected() {
 
     // 停止连接检查
     m_connectionCheckTimer->stop();
-    // 停止自动发送消息
-    m_sendMessageTimer->stop();
+    // 停止补发，未确认的消息重新排在队首
+    m_drainTimer->stop();
+    m_retryList = m_inFlight.values() + m_retryList;
+    m_inFlight.clear();
+    // 自动发送消息继续运行，消息进入离线队列
+
+    scheduleReconnect();
 }
 
 void MqttClient::onPingResponseReceived() {
@@ -331,10 +487,6 @@ void MqttClient::checkConnection() {
 }
 
 void MqttClient::autoSendMessage() {
-    if (!isConnected()) {
-        emit mqttLogMessage("自动发送消息失败: MQTT未连接");
-    }
-
     emit autoSendMsg(m_topic);
 }
 
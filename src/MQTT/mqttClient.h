@@ -4,8 +4,11 @@
 #include <QObject>
 #include <QString>
 #include <QTimer>
+#include <QMap>
+#include <QList>
 #include <QtMqtt/qmqttclient.h>
 #include <QtMqtt/qmqtttopicname.h>
+#include "mqttOfflineQueue.h"
 
 /**
  * @brief MQTT客户端封装类
@@ -26,14 +29,22 @@ public:
     void disconnectFromHost();
 
     // 消息发布和订阅
+    // 未连接（或离线队列尚未补发完）时消息进入离线队列，返回 0；参数错误返回 -1
     qint32 publishMessage(const QString &topic, const QString &message, quint8 qos = 0, bool retain = false);
+    qint32 publishPayload(const QString &topic, const QByteArray &payload, quint8 qos = 0, bool retain = false); // 已编码的消息
+    // 完整状态：离线时替换离线队列中同一主题上尚未补发的旧快照和增量
+    qint32 publishSnapshot(const QString &topic, const QByteArray &payload, quint8 qos = 0, bool retain = false);
+    // 实时数据（QoS 0）：不进入离线队列，未连接或发送缓冲积压超过 maxPendingBytes 时直接丢弃，返回 -1
+    qint32 publishVolatile(const QString &topic, const QByteArray &payload, qint64 maxPendingBytes);
     bool subscribeToTopic(const QString &topic, quint8 qos = 0);
     void unsubscribeFromTopic(const QString &topic);
+    void setCommandTopic(const QString &topic); // 连接（重连）后自动以 QoS 1 订阅的命令主题
 
     // 状态查询
     bool isConnected() const;
     QMqttClient::ClientState getState() const;
     QString getLastError() const;
+    qint64 pendingBytes() const; // 已交给传输层但尚未写出的字节数
 
     // 连接检查配置
     void setConnectionCheckInterval(int intervalMs = 60000); // 默认60秒检查一次
@@ -43,6 +54,11 @@ public:
     void setSendMessageInterval(int intervalMs = 10000); // 默认10秒发送一次
     void enableAutoSendMessage(bool enable = true);
 
+    // 离线队列：断线期间缓存消息，重连后以 QoS 1 按 drainRate 条/秒补发
+    void setOfflineQueue(int maxMessages, const QString &spillFile = QString());
+    void setDrainRate(int messagesPerSec);
+    int queuedMessages() const;
+
 public slots:
     void stopMqttClient(); // 停止MQTT客户端连接
 
@@ -72,6 +88,8 @@ private slots:
     void onPingResponseReceived();
     void checkConnection(); // 定时检查连接状态
     void autoSendMessage(); // 定时发送消息
+    void onMessageSent(qint32 messageId); // QoS>0 消息得到服务器确认
+    void drainQueue(); // 补发离线队列
 
 private:
     QMqttClient *m_client;          // Qt MQTT客户端实例
@@ -79,12 +97,14 @@ private:
     quint16 m_port;                 // 服务器端口
     QString m_clientId;             // 客户端ID
     QString m_topic;                // 主题
+    QString m_commandTopic;         // 命令主题（为空时不订阅）
     QString m_username;             // 用户名
     QString m_password;             // 密码
     QString m_lastError;            // 最后的错误信息
 
-    int m_reconnectAttempts = 0;          // 错误重连计数器
-    int m_MAX_RECONNECT_ATTEMPTS = 10;     // 最大重连次数
+    int m_reconnectAttempts = 0;          // 连续重连次数（用于退避）
+    int m_MAX_RECONNECT_DELAY = 300;      // 重连最大间隔（秒），不限制重连次数
+    QTimer *m_reconnectTimer;             // 重连定时器（单次）
 
     QTimer *m_connectionCheckTimer; // 连接检查定时器
     bool m_connectionCheckEnabled;  // 是否启用连接检查
@@ -92,8 +112,22 @@ private:
     QTimer *m_sendMessageTimer; // 发送消息定时器
     bool m_autoSendMessageEnabled;  // 是否启用发送消息
 
+    MqttOfflineQueue *m_offlineQueue;          // 离线消息队列
+    QList<MqttQueuedMessage> m_retryList;      // 断线时未确认的消息，优先补发
+    QMap<qint32, MqttQueuedMessage> m_inFlight; // 已发送未确认的 QoS>0 消息
+    QTimer *m_drainTimer;                      // 补发定时器
+    int m_drainRate;                           // 补发速率（条/秒）
+    int m_MAX_IN_FLIGHT = 32;                  // 最多未确认消息数
+    qint64 m_reportedDropped = 0;              // 已记录日志的丢弃数
+    int m_reportedCorrupted = 0;               // 已记录日志的溢写文件损坏次数
+
     void initializeClient();       // 初始化客户端
     void setupSignalSlots();       // 设置信号槽连接
+    void scheduleReconnect();      // 按带抖动的指数退避安排重连
+    void enqueueMessage(const MqttQueuedMessage &msg); // 消息进入离线队列
+    qint32 sendMessage(const MqttQueuedMessage &msg);  // 直接发送，QoS>0 时记录未确认消息
+    qint32 publishQueued(const MqttQueuedMessage &msg); // 发送或（未连接时）进入离线队列
+    void reportCorruptedQueue();                       // 溢写文件损坏时记录日志
     QString stateToString(QMqttClient::ClientState state) const; // 状态转换为字符串
     QString errorToString(QMqttClient::ClientError error) const; // 错误转换为字符串
 };
@@ -0,0 +1,167 @@
+#include "mqttDataOutput.h"
+#include "mqttClient.h"
+#include <QDateTime>
+#include <QTimer>
+#include <QtEndian>
+#include <cstring>
+
+namespace {
+    const quint8 kTypeObs     = 1;
+    const quint8 kTypePpp     = 2;
+    const quint8 kVersion     = 1;
+    const int    kHeaderSize  = 12;  // type + version + gpsw + gpssec
+    const qint64 kIdleMSecs   = 200; // 历元收集空闲超过该时间即发布
+    const qint64 kReportMSecs = 60000;
+
+    template <typename T>
+    void put(QByteArray& buf, T value) {
+        T le = qToLittleEndian(value);
+        buf.append(reinterpret_cast<const char*>(&le), sizeof(T));
+    }
+
+    void putDouble(QByteArray& buf, double value) {
+        quint64 bits;
+        memcpy(&bits, &value, sizeof(bits));
+        put(buf, bits);
+    }
+
+    void putFloat(QByteArray& buf, double value) {
+        float hlp = float(value);
+        quint32 bits;
+        memcpy(&bits, &hlp, sizeof(bits));
+        put(buf, bits);
+    }
+}
+
+// 构造
+// ----------------------------------------------------------------------------
+MqttDataOutput::MqttDataOutput(MqttClient* client, const QString& topic, qint64 maxPendingBytes, QObject* parent)
+    : QObject(parent)
+      , _client(client)
+      , _topic(topic)
+      , _maxPendingBytes(maxPendingBytes)
+      , _published(0)
+      , _dropped(0)
+      , _reportedDropped(0)
+      , _lastReportMSecs(0) {
+    _flushTimer = new QTimer(this);
+    _flushTimer->setInterval(int(kIdleMSecs));
+    connect(_flushTimer, &QTimer::timeout, this, &MqttDataOutput::slotFlush);
+    _flushTimer->start();
+}
+
+void MqttDataOutput::removeStation(const QByteArray& staID) {
+    _batches.remove(staID);
+}
+
+// 观测值：按站点收集同一历元的卫星，历元变化时发布上一历元
+// ----------------------------------------------------------------------------
+void MqttDataOutput::slotNewObs(QByteArray staID, t_satObsBatch obsBatch) {
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    Batch& batch = _batches[staID];
+    for (const t_satObs& obs : *obsBatch) {
+        if (batch.nSat > 0 && batch.time != obs._time) {
+            flush(staID, batch);
+        }
+        if (batch.nSat == 0) {
+            batch.time = obs._time;
+        }
+        appendObs(batch.body, obs);
+        batch.nSat++;
+    }
+    batch.lastMSecs = now;
+}
+
+// PPP定位结果：xx 为 x, y, z, n, e, u
+// ----------------------------------------------------------------------------
+void MqttDataOutput::slotNewPosition(QByteArray staID, bncTime time, QVector<double> xx) {
+    if (xx.size() < 6) {
+        return;
+    }
+    QByteArray payload = header(kTypePpp, time, 3 * 8 + 3 * 4);
+    for (int ii = 0; ii < 3; ii++) {
+        putDouble(payload, xx[ii]);
+    }
+    for (int ii = 3; ii < 6; ii++) {
+        putFloat(payload, xx[ii]);
+    }
+    send(_topic + "/ppp/" + QString::fromLatin1(staID), payload);
+}
+
+// 定时检查：发布空闲超时的历元，并限频记录丢弃数
+// ----------------------------------------------------------------------------
+void MqttDataOutput::slotFlush() {
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (auto it = _batches.begin(); it != _batches.end(); ++it) {
+        if (it->nSat > 0 && now - it->lastMSecs >= kIdleMSecs) {
+            flush(it.key(), it.value());
+        }
+    }
+
+    if (_dropped > _reportedDropped && now - _lastReportMSecs >= kReportMSecs) {
+        emit mqttLogMessage(QString("MQTT data output: %1 messages dropped (broker too slow or disconnected)")
+                            .arg(_dropped - _reportedDropped).toLatin1(), true);
+        _reportedDropped = _dropped;
+        _lastReportMSecs = now;
+    }
+}
+
+// 私有辅助
+// ----------------------------------------------------------------------------
+
+void MqttDataOutput::flush(const QByteArray& staID, Batch& batch) {
+    QByteArray payload = header(kTypeObs, batch.time, 2 + batch.body.size());
+    put(payload, quint16(batch.nSat));
+    payload.append(batch.body);
+    send(_topic + "/obs/" + QString::fromLatin1(staID), payload);
+
+    batch.body.resize(0); // 保留已分配的内存供下一历元使用
+    batch.nSat = 0;
+}
+
+void MqttDataOutput::send(const QString& topic, const QByteArray& payload) {
+    if (_client->publishVolatile(topic, payload, _maxPendingBytes) == -1) {
+        _dropped++;
+    }
+    else {
+        _published++;
+    }
+}
+
+QByteArray MqttDataOutput::header(quint8 type, const bncTime& time, int reserve) {
+    QByteArray buf;
+    buf.reserve(kHeaderSize + reserve);
+    put(buf, type);
+    put(buf, kVersion);
+    put(buf, quint16(time.gpsw()));
+    putDouble(buf, time.gpssec());
+    return buf;
+}
+
+void MqttDataOutput::appendObs(QByteArray& body, const t_satObs& obs) {
+    body.append(obs._prn.system());
+    put(body, quint8(obs._prn.number()));
+    put(body, quint8(obs._obs.size()));
+    for (const t_frqObs& frq : obs._obs) {
+        char type[2] = { ' ', ' ' };
+        for (size_t ii = 0; ii < 2 && ii < frq._rnxType2ch.size(); ii++) {
+            type[ii] = frq._rnxType2ch[ii];
+        }
+        body.append(type, 2);
+
+        quint8 flags = 0;
+        if (frq._codeValid)     flags |= 0x01;
+        if (frq._phaseValid)    flags |= 0x02;
+        if (frq._dopplerValid)  flags |= 0x04;
+        if (frq._snrValid)      flags |= 0x08;
+        if (frq._lockTimeValid) flags |= 0x10;
+        if (frq._slip)          flags |= 0x20;
+        put(body, flags);
+
+        if (frq._codeValid)     putDouble(body, frq._code);
+        if (frq._phaseValid)    putDouble(body, frq._phase);
+        if (frq._dopplerValid)  putFloat(body, frq._doppler);
+        if (frq._snrValid)      putFloat(body, frq._snr);
+        if (frq._lockTimeValid) putFloat(body, frq._lockTime);
+    }
+}
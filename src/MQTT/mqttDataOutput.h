@@ -0,0 +1,80 @@
+#ifndef MQTTDATAOUTPUT_H
+#define MQTTDATAOUTPUT_H
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QVector>
+#include "satObs.h"
+#include "bnctime.h"
+
+class QTimer;
+class MqttClient;
+
+/**
+ * @brief MQTT实时数据输出
+ * 把解码后的观测值按站点、按历元打包发布在 <topic>/obs/<staID>，
+ * PPP 定位结果发布在 <topic>/ppp/<staID>。
+ *
+ * 消息为紧凑的小端二进制格式（QoS 0，不保留，不进入离线队列）：
+ *   头部    type(u8: 1=观测, 2=PPP) version(u8) gpsw(u16) gpssec(f64)
+ *   观测    nSat(u16)，每颗卫星 system(char) number(u8) nFrq(u8)，
+ *           每个频率 rnxType2ch(2 char) flags(u8) 及 flags 指明的字段：
+ *           bit0 code(f64) bit1 phase(f64) bit2 doppler(f32) bit3 snr(f32)
+ *           bit4 lockTime(f32) bit5 slip（无字段）
+ *   PPP     x y z(f64, m) n e u(f32, m)
+ *
+ * 背压：服务器处理不及时、发送缓冲积压超过 maxPendingBytes 时整个历元被丢弃，
+ * 不会在内存中无限堆积，也不会挤占站点状态消息的离线队列。
+ */
+class MqttDataOutput : public QObject
+{
+    Q_OBJECT
+
+public:
+    MqttDataOutput(MqttClient* client, const QString& topic, qint64 maxPendingBytes, QObject* parent = nullptr);
+
+    void removeStation(const QByteArray& staID); // 丢弃该站点尚未发布的历元
+
+    qint64 published() const { return _published; }
+    qint64 dropped() const { return _dropped; }
+
+public slots:
+    void slotNewObs(QByteArray staID, t_satObsBatch obsBatch);
+    void slotNewPosition(QByteArray staID, bncTime time, QVector<double> xx);
+
+signals:
+    void mqttLogMessage(QByteArray message, bool showOnScreen = true);
+
+private slots:
+    void slotFlush(); // 发布空闲超时的历元
+
+private:
+    // 一个站点正在收集的历元
+    struct Batch {
+        bncTime    time;
+        QByteArray body;      // 已编码的卫星记录
+        int        nSat;
+        qint64     lastMSecs; // 最后一次追加的时间
+        Batch() : nSat(0), lastMSecs(0) {}
+    };
+
+    static void appendObs(QByteArray& body, const t_satObs& obs);
+    static QByteArray header(quint8 type, const bncTime& time, int reserve);
+    void flush(const QByteArray& staID, Batch& batch);
+    void send(const QString& topic, const QByteArray& payload);
+
+    MqttClient*                _client;
+    QString                    _topic;
+    qint64                     _maxPendingBytes;
+    QHash<QByteArray, Batch>   _batches;
+    QTimer*                    _flushTimer;
+    qint64                     _published;
+    qint64                     _dropped;
+    qint64                     _reportedDropped;
+    qint64                     _lastReportMSecs;
+};
+
+#endif // MQTTDATAOUTPUT_H
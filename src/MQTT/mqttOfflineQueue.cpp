@@ -0,0 +1,256 @@
+#include "mqttOfflineQueue.h"
+#include <QFile>
+#include <cstring>
+
+namespace {
+    const quint32 kMagic    = 0x51434e42; // "BNCQ"
+    const quint32 kVersion  = 1;
+    const qint64  kFileSize = 16 * 1024 * 1024; // 溢写文件固定大小 16 MB
+
+    // 单条记录：payload长度(4) + topic长度(2) + qos(1) + retain(1) + topic + payload
+    const qint64  kRecordHeader = 8;
+}
+
+// 构造与析构
+// ----------------------------------------------------------------------------
+MqttOfflineQueue::MqttOfflineQueue(int maxMessages, const QString& spillFile)
+    : _maxMessages(maxMessages > 0 ? maxMessages : 1)
+      , _dropped(0)
+      , _corrupted(0)
+      , _file(nullptr)
+      , _map(nullptr)
+      , _mapSize(0) {
+    if (!spillFile.isEmpty()) {
+        openSpillFile(spillFile);
+    }
+}
+
+MqttOfflineQueue::~MqttOfflineQueue() {
+    if (_map) {
+        _file->unmap(_map);
+    }
+    delete _file;
+}
+
+// 打开（必要时创建）溢写文件；文件头及全部记录有效时保留其中尚未发送的消息
+bool MqttOfflineQueue::openSpillFile(const QString& fileName) {
+    _file = new QFile(fileName);
+    if (!_file->open(QIODevice::ReadWrite)) {
+        delete _file;
+        _file = nullptr;
+        return false;
+    }
+    bool keep = (_file->size() == kFileSize);
+    if (!keep && !_file->resize(kFileSize)) {
+        delete _file;
+        _file = nullptr;
+        return false;
+    }
+    _map = _file->map(0, kFileSize);
+    if (!_map) {
+        delete _file;
+        _file = nullptr;
+        return false;
+    }
+    _mapSize = kFileSize;
+
+    FileHeader* hdr = header();
+    if (!keep || hdr->magic != kMagic || hdr->version != kVersion) {
+        resetFile();
+        return true;
+    }
+    bool valid = hdr->head >= sizeof(FileHeader) && hdr->head <= hdr->tail &&
+                 hdr->tail <= quint64(_mapSize);
+    if (valid) {
+        // 逐条检查记录长度并核对条数
+        quint32 count = 0;
+        quint64 pos = hdr->head;
+        while (valid && pos < hdr->tail) {
+            qint64 len = recordSize(pos);
+            valid = len > 0;
+            pos += len;
+            count++;
+        }
+        valid = valid && count == hdr->count;
+    }
+    if (!valid) {
+        _corrupted++;
+        resetFile();
+    }
+    return true;
+}
+
+int MqttOfflineQueue::size() const {
+    return _map ? int(header()->count) : _memQueue.size();
+}
+
+// 入队，队列满时丢弃最旧的消息
+// ----------------------------------------------------------------------------
+void MqttOfflineQueue::enqueue(const MqttQueuedMessage& msg) {
+    if (msg.snapshot) {
+        removeTopic(msg.topic);
+    }
+    while (size() >= _maxMessages) {
+        dropOldest();
+    }
+
+    if (!_map) {
+        _memQueue.enqueue(msg);
+        return;
+    }
+
+    QByteArray topic = msg.topic.toUtf8();
+    qint64 recordSize = kRecordHeader + topic.size() + msg.payload.size();
+    if (!makeRoom(recordSize)) {
+        _dropped++; // 单条消息超过文件容量
+        return;
+    }
+
+    FileHeader* hdr = header();
+    uchar* p = _map + hdr->tail;
+    quint32 payloadLen = quint32(msg.payload.size());
+    quint16 topicLen = quint16(topic.size());
+    memcpy(p, &payloadLen, 4);
+    memcpy(p + 4, &topicLen, 2);
+    p[6] = msg.qos;
+    p[7] = msg.retain ? 1 : 0;
+    memcpy(p + kRecordHeader, topic.constData(), topicLen);
+    memcpy(p + kRecordHeader + topicLen, msg.payload.constData(), payloadLen);
+    hdr->tail += recordSize;
+    hdr->count++;
+}
+
+// 出队（最旧的消息）
+// ----------------------------------------------------------------------------
+bool MqttOfflineQueue::dequeue(MqttQueuedMessage& msg) {
+    if (!_map) {
+        if (_memQueue.isEmpty()) {
+            return false;
+        }
+        msg = _memQueue.dequeue();
+        return true;
+    }
+
+    FileHeader* hdr = header();
+    if (hdr->count == 0) {
+        return false;
+    }
+    qint64 len = recordSize(hdr->head);
+    if (len == 0) {
+        _corrupted++;
+        resetFile();
+        return false;
+    }
+    const uchar* p = _map + hdr->head;
+    quint32 payloadLen;
+    quint16 topicLen;
+    memcpy(&payloadLen, p, 4);
+    memcpy(&topicLen, p + 4, 2);
+    msg.qos = p[6];
+    msg.retain = p[7] != 0;
+    msg.snapshot = false;
+    msg.topic = QString::fromUtf8(reinterpret_cast<const char*>(p + kRecordHeader), topicLen);
+    msg.payload = QByteArray(reinterpret_cast<const char*>(p + kRecordHeader + topicLen), int(payloadLen));
+
+    hdr->head += len;
+    hdr->count--;
+    if (hdr->count == 0) {
+        hdr->head = hdr->tail = sizeof(FileHeader);
+    }
+    return true;
+}
+
+// 私有辅助
+// ----------------------------------------------------------------------------
+
+void MqttOfflineQueue::dropOldest() {
+    MqttQueuedMessage msg;
+    if (dequeue(msg)) {
+        _dropped++;
+    }
+}
+
+// 新快照到达时丢弃同一主题上尚未补发的旧消息，其余记录在文件中前移
+void MqttOfflineQueue::removeTopic(const QString& topic) {
+    if (!_map) {
+        for (int ii = _memQueue.size() - 1; ii >= 0; ii--) {
+            if (_memQueue.at(ii).topic == topic) {
+                _memQueue.removeAt(ii);
+            }
+        }
+        return;
+    }
+
+    FileHeader* hdr = header();
+    QByteArray name = topic.toUtf8();
+    quint64 pos = hdr->head;
+    quint64 out = hdr->head;
+    quint32 count = 0;
+    while (pos < hdr->tail) {
+        qint64 len = recordSize(pos);
+        if (len == 0) {
+            _corrupted++;
+            resetFile();
+            return;
+        }
+        quint16 topicLen;
+        memcpy(&topicLen, _map + pos + 4, 2);
+        bool match = topicLen == name.size() &&
+                     memcmp(_map + pos + kRecordHeader, name.constData(), topicLen) == 0;
+        if (!match) {
+            if (out != pos) {
+                memmove(_map + out, _map + pos, size_t(len));
+            }
+            out += len;
+            count++;
+        }
+        pos += len;
+    }
+    hdr->tail = out;
+    hdr->count = count;
+    if (count == 0) {
+        hdr->head = hdr->tail = sizeof(FileHeader);
+    }
+}
+
+qint64 MqttOfflineQueue::recordSize(quint64 pos) const {
+    quint64 tail = header()->tail;
+    if (pos > tail || tail - pos < quint64(kRecordHeader)) {
+        return 0;
+    }
+    quint32 payloadLen;
+    quint16 topicLen;
+    memcpy(&payloadLen, _map + pos, 4);
+    memcpy(&topicLen, _map + pos + 4, 2);
+    quint64 len = quint64(kRecordHeader) + topicLen + payloadLen;
+    return len <= tail - pos ? qint64(len) : 0;
+}
+
+void MqttOfflineQueue::resetFile() {
+    FileHeader* hdr = header();
+    hdr->magic = kMagic;
+    hdr->version = kVersion;
+    hdr->head = hdr->tail = sizeof(FileHeader);
+    hdr->count = 0;
+    hdr->reserved = 0;
+}
+
+// 文件尾部空间不足时先把有效数据移到文件头之后，仍不足则丢弃最旧的消息
+bool MqttOfflineQueue::makeRoom(qint64 recordSize) {
+    if (recordSize > _mapSize - qint64(sizeof(FileHeader))) {
+        return false;
+    }
+    FileHeader* hdr = header();
+    while (qint64(hdr->tail) + recordSize > _mapSize) {
+        if (hdr->head > sizeof(FileHeader)) {
+            qint64 used = hdr->tail - hdr->head;
+            memmove(_map + sizeof(FileHeader), _map + hdr->head, size_t(used));
+            hdr->head = sizeof(FileHeader);
+            hdr->tail = sizeof(FileHeader) + used;
+        }
+        else {
+            dropOldest();
+        }
+    }
+    return true;
+}
@@ -0,0 +1,74 @@
+#ifndef MQTTOFFLINEQUEUE_H
+#define MQTTOFFLINEQUEUE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QQueue>
+
+class QFile;
+
+// 待发布的MQTT消息
+struct MqttQueuedMessage {
+    QString    topic;
+    QByteArray payload;
+    quint8     qos;
+    bool       retain;
+    bool       snapshot; // 完整状态：入队时替换同一主题上尚未补发的消息
+
+    MqttQueuedMessage() : qos(0), retain(false), snapshot(false) {}
+    MqttQueuedMessage(const QString& t, const QByteArray& p, quint8 q, bool r, bool s = false)
+        : topic(t), payload(p), qos(q), retain(r), snapshot(s) {}
+};
+
+/**
+ * @brief MQTT离线消息队列
+ * 断线期间缓存待发布的消息，重连后按先进先出顺序补发。
+ * 队列有界：超过 maxMessages 条（或溢写文件写满）时丢弃最旧的消息。
+ * 指定溢写文件时，消息保存在内存映射文件中，BNC 重启后未发送的消息仍然保留。
+ * 完整状态快照（snapshot）入队时丢弃同一主题上更早的消息（旧快照及其后的增量），
+ * 断线期间每个主题只保留最新的快照。
+ */
+class MqttOfflineQueue
+{
+public:
+    explicit MqttOfflineQueue(int maxMessages = 1000, const QString& spillFile = QString());
+    ~MqttOfflineQueue();
+
+    bool isEmpty() const { return size() == 0; }
+    int size() const;
+    qint64 dropped() const { return _dropped; } // 因队列满而丢弃的消息总数
+    int corrupted() const { return _corrupted; } // 因溢写文件损坏而清空队列的次数
+    bool isSpilled() const { return _map != nullptr; }
+
+    void enqueue(const MqttQueuedMessage& msg);
+    bool dequeue(MqttQueuedMessage& msg);
+
+private:
+    // 溢写文件头
+    struct FileHeader {
+        quint32 magic;
+        quint32 version;
+        quint64 head;  // 最旧消息的偏移
+        quint64 tail;  // 写入位置
+        quint32 count; // 消息条数
+        quint32 reserved;
+    };
+
+    bool openSpillFile(const QString& fileName);
+    bool makeRoom(qint64 recordSize); // 丢弃最旧消息或整理文件，直到可以写入 recordSize 字节
+    void dropOldest();
+    void removeTopic(const QString& topic); // 丢弃该主题上的全部消息
+    qint64 recordSize(quint64 pos) const;   // pos 处记录的长度，记录超出 tail 时返回 0
+    void resetFile();
+    FileHeader* header() const { return reinterpret_cast<FileHeader*>(_map); }
+
+    int                       _maxMessages;
+    qint64                    _dropped;
+    int                       _corrupted;
+    QQueue<MqttQueuedMessage> _memQueue; // 未指定溢写文件时使用
+    QFile*                    _file;
+    uchar*                    _map;      // 溢写文件的内存映射
+    qint64                    _mapSize;
+};
+
+#endif // MQTTOFFLINEQUEUE_H
@@ -0,0 +1,372 @@
+#include "mqttPublisher.h"
+#include "mqttClient.h"
+#include "jsonMessage.h"
+#include "messageEncoder.h"
+#include "mqttDataOutput.h"
+#include "bnccore.h"
+#include "bncgetthread.h"
+#include "bncsettings.h"
+#include <QJsonDocument>
+#include <QStringList>
+#include <QTimer>
+#include <QUrl>
+
+// 构造与析构
+// ----------------------------------------------------------------------------
+MqttPublisher::MqttPublisher(QObject* parent)
+    : QObject(parent)
+      , _port(1883)
+      , _sendInterval(10)
+      , _deltaMode(false)
+      , _rtcmTypes(false)
+      , _queueSize(1000)
+      , _drainRate(50)
+      , _events(false)
+      , _eventInterval(10)
+      , _eventTimer(nullptr)
+      , _commands(false)
+      , _dataOutput(nullptr)
+      , _encoder(nullptr)
+      , _fullInterval(300)
+      , _forceFull(true)
+      , _running(false) {
+
+    bncSettings settings;
+    _host     = settings.value("mqttHost").toString().trimmed();
+    _topic    = settings.value("mqttTopic").toString().trimmed();
+    _user     = settings.value("mqttUser").toString().trimmed();
+    _password = settings.value("mqttPwd").toString().trimmed();
+    _nodeId   = settings.value("mqttNodeId").toString().trimmed();
+
+    int port = settings.value("mqttPort").toInt();
+    if (port > 0 && port <= 65535) {
+        _port = static_cast<quint16>(port);
+    }
+    int interval = settings.value("mqttSendInterval").toInt();
+    if (interval > 0) {
+        _sendInterval = interval;
+    }
+    _deltaMode = Qt::CheckState(settings.value("mqttDelta").toInt()) == Qt::Checked;
+    _rtcmTypes = Qt::CheckState(settings.value("mqttRtcmTypes").toInt()) == Qt::Checked;
+    int queueSize = settings.value("mqttQueueSize").toInt();
+    if (queueSize > 0) {
+        _queueSize = queueSize;
+    }
+    _queueFile = settings.value("mqttQueueFile").toString().trimmed();
+    int drainRate = settings.value("mqttDrainRate").toInt();
+    if (drainRate > 0) {
+        _drainRate = drainRate;
+    }
+    _events = Qt::CheckState(settings.value("mqttEvents").toInt()) == Qt::Checked;
+    bool ok;
+    int eventInterval = settings.value("mqttEventInterval").toInt(&ok);
+    if (ok && eventInterval >= 0) {
+        _eventInterval = eventInterval;
+    }
+    _commands = Qt::CheckState(settings.value("mqttCommands").toInt()) == Qt::Checked;
+    int fullInterval = settings.value("mqttFullInterval").toInt();
+    if (fullInterval > 0) {
+        _fullInterval = fullInterval;
+    }
+
+    _encoder     = MessageEncoder::create(settings.value("mqttFormat").toString());
+    _mqttClient  = new MqttClient(this);
+    _jsonMessage = new JsonMessage(this);
+
+    // MQTT日志统一转发到 BNC_CORE，GUI 的 "MQTT Log" 页面从那里接收
+    connect(_mqttClient, &MqttClient::mqttLogMessage, BNC_CORE, &t_bncCore::slotMQTTMessage);
+    connect(_mqttClient, &MqttClient::autoSendMsg, this, &MqttPublisher::slotPublishMessage);
+    connect(_mqttClient, &MqttClient::connected, this, &MqttPublisher::slotConnected);
+
+    // 状态变化事件：超时、断开、异常由数据流线程的信号立即触发，
+    // 恢复连接及限流期后合并的变化由每秒一次的检查发出
+    if (_events) {
+        _jsonMessage->setEventInterval(_eventInterval);
+        connect(_jsonMessage, &JsonMessage::stationEvent, this, &MqttPublisher::slotPublishEvent);
+        _eventTimer = new QTimer(this);
+        _eventTimer->setInterval(1000);
+        connect(_eventTimer, &QTimer::timeout, _jsonMessage, &JsonMessage::checkEvents);
+    }
+
+    // 观测值与PPP结果：QoS 0 按站点主题发布，发送缓冲积压时丢弃
+    if (Qt::CheckState(settings.value("mqttData").toInt()) == Qt::Checked) {
+        qint64 bufferKB = settings.value("mqttDataBuffer").toLongLong();
+        if (bufferKB <= 0) {
+            bufferKB = 1024;
+        }
+        _dataOutput = new MqttDataOutput(_mqttClient, _topic, bufferKB * 1024, this);
+        connect(_dataOutput, &MqttDataOutput::mqttLogMessage, BNC_CORE, &t_bncCore::slotMQTTMessage);
+        connect(BNC_CORE, &t_bncCore::newPosition, _dataOutput, &MqttDataOutput::slotNewPosition);
+    }
+
+    if (_commands) {
+        connect(_mqttClient, &MqttClient::messageReceived, this, &MqttPublisher::slotCommandReceived);
+    }
+}
+
+MqttPublisher::~MqttPublisher() {
+    stop();
+    delete _encoder;
+}
+
+// 配置中是否启用了MQTT
+// ----------------------------------------------------------------------------
+bool MqttPublisher::isConfigured() {
+    bncSettings settings;
+    return !settings.value("mqttHost").toString().trimmed().isEmpty() &&
+           !settings.value("mqttPort").toString().trimmed().isEmpty() &&
+           !settings.value("mqttTopic").toString().trimmed().isEmpty();
+}
+
+// 启动发布服务
+// ----------------------------------------------------------------------------
+void MqttPublisher::start() {
+    if (_running) {
+        return;
+    }
+    _running = true;
+
+    BNC_CORE->slotMQTTMessage("Start MQTT Message", true);
+    BNC_CORE->slotMessage(QString("MQTT status publisher: %1:%2, topic %3, interval %4 sec, %5")
+                          .arg(_host).arg(_port).arg(_topic).arg(_sendInterval).arg(_encoder->name()).toLatin1(), true);
+
+    // 消息存储对象初始化
+    _jsonMessage->setNodeName(_nodeId.isEmpty() ? QString("DefaultNode") : _nodeId);
+
+    // 设置连接参数
+    _mqttClient->setConnectionParameters(_host, _port, _topic, _nodeId);
+    // 用户认证，如果有
+    if (!_user.isEmpty()) {
+        _mqttClient->setCredentials(_user, _password);
+    }
+    // 离线队列与补发速率
+    _mqttClient->setOfflineQueue(_queueSize, _queueFile);
+    _mqttClient->setDrainRate(_drainRate);
+    // 控制命令主题
+    if (_commands) {
+        _mqttClient->setCommandTopic(_topic + "/cmd");
+    }
+    // 设置自动发送消息间隔
+    _mqttClient->setSendMessageInterval(_sendInterval * 1000);
+    // 启动自动发送消息
+    _mqttClient->enableAutoSendMessage();
+    // 启动MQTT连接检查
+    _mqttClient->enableConnectionCheck();
+    // 连接到MQTT服务器
+    _mqttClient->connectToHost();
+    // 启动事件检查
+    if (_eventTimer) {
+        _eventTimer->start();
+    }
+}
+
+// 停止发布服务
+// ----------------------------------------------------------------------------
+void MqttPublisher::stop() {
+    if (!_running) {
+        return;
+    }
+    _running = false;
+    if (_eventTimer) {
+        _eventTimer->stop();
+    }
+    _mqttClient->stopMqttClient();
+}
+
+// 挂接数据流线程，由 bncCaster::addGetThread 调用
+// ----------------------------------------------------------------------------
+void MqttPublisher::addGetThread(bncGetThread* getThread) {
+    // 数据流线程直接写入固定的状态槽，不再经过信号与发布线程的互斥锁
+    getThread->setStatusSlot(_jsonMessage->addStation(QString::fromLatin1(getThread->staID())));
+
+    // 状态变化事件只需要低频的异常信号
+    if (_events) {
+        connect(getThread, &bncGetThread::sigStaTimeout, _jsonMessage, &JsonMessage::slotOnStaTimeout);
+        connect(getThread, &bncGetThread::sigStaDisconnected, _jsonMessage, &JsonMessage::slotOnStaDisconnected);
+        connect(getThread, &bncGetThread::sigStaError, _jsonMessage, &JsonMessage::slotOnStaError);
+    }
+
+    if (_dataOutput) {
+        connect(getThread, &bncGetThread::newObs, _dataOutput, &MqttDataOutput::slotNewObs);
+    }
+}
+
+// 移除站点
+// ----------------------------------------------------------------------------
+void MqttPublisher::removeStation(const QByteArray& staID) {
+    _jsonMessage->removeStation(QString::fromLatin1(staID));
+    if (_dataOutput) {
+        _dataOutput->removeStation(staID);
+    }
+}
+
+// 定时发布站点状态
+// ----------------------------------------------------------------------------
+void MqttPublisher::slotPublishMessage(const QString& topic) {
+    // 断线期间消息进入 MqttClient 的离线队列，重连后补发；完整状态在队列中
+    // 只保留每个主题最新的一份
+    // RTCM消息类型计数发布在单独的子主题上
+    if (_rtcmTypes) {
+        publish(topic + "/rtcm", _jsonMessage->getMessageTypeObject(), 0, false, true);
+    }
+
+    // 默认模式：每个周期发布完整站点列表
+    if (!_deltaMode) {
+        publish(topic, _jsonMessage->getJsonObject(), 0, false, true);
+        return;
+    }
+
+    // 增量模式：启动、重连及每隔 _fullInterval 秒发布保留的全量快照，其余周期只发布变化的站点
+    QDateTime now = QDateTime::currentDateTime();
+    if (_forceFull || !_lastFullTime.isValid() || _lastFullTime.secsTo(now) >= _fullInterval) {
+        if (publish(topic, _jsonMessage->getFullObject(), 0, true, true) != -1) {
+            _lastFullTime = now;
+            _forceFull = false;
+        }
+    }
+    else {
+        QJsonObject delta = _jsonMessage->getDeltaObject();
+        if (!delta.isEmpty()) {
+            publish(topic, delta);
+        }
+    }
+}
+
+// 连接（重连）成功
+// ----------------------------------------------------------------------------
+void MqttPublisher::slotConnected() {
+    if (_deltaMode) {
+        _forceFull = true;
+        slotPublishMessage(_topic);
+    }
+}
+
+// 发布站点状态变化事件（QoS 1，断线时进入离线队列）
+// ----------------------------------------------------------------------------
+void MqttPublisher::slotPublishEvent(const QJsonObject& event) {
+    publish(_topic + "/event", event, 1);
+}
+
+// 控制命令
+// ----------------------------------------------------------------------------
+// 命令为 JSON：{"id":..,"cmd":"add|remove|reread|snapshot","mountpoint":..}
+//   add      mountpoint 与配置文件 mountPoints 中的一条格式相同："url format country lat lon nmea ntripVersion"
+//   remove   mountpoint 为完整 URL 或站点ID（挂载点名）
+//   reread   重新读取配置文件
+//   snapshot 立即发布完整站点状态
+// 应答：{"id":..,"cmd":..,"ok":true/false,"message":..,"node":..,"time":..}，QoS 1
+void MqttPublisher::slotCommandReceived(const QString& topic, const QString& message) {
+    if (topic != _topic + "/cmd") {
+        return;
+    }
+
+    QJsonObject reply;
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8(), &error);
+    bool ok = false;
+    QString text;
+    if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+        text = "invalid command: " + (doc.isObject() ? QString("not an object") : error.errorString());
+    }
+    else {
+        QJsonObject command = doc.object();
+        QString cmd = command.value("cmd").toString();
+        QString mountPoint = command.value("mountpoint").toString().trimmed();
+        reply["id"] = command.value("id");
+        reply["cmd"] = cmd;
+
+        if (cmd == "add") {
+            ok = addMountPoint(mountPoint, text);
+        }
+        else if (cmd == "remove") {
+            ok = removeMountPoint(mountPoint, text);
+        }
+        else if (cmd == "reread") {
+            ok = true;
+            text = "configuration reread";
+            emit reReadRequested();
+        }
+        else if (cmd == "snapshot") {
+            ok = true;
+            text = "snapshot published";
+            _forceFull = true;
+            slotPublishMessage(_topic);
+        }
+        else {
+            text = "unknown command: " + cmd;
+        }
+    }
+
+    BNC_CORE->slotMessage(QString("MQTT command %1: %2").arg(reply.value("cmd").toString()).arg(text).toLatin1(), true);
+
+    reply["ok"] = ok;
+    reply["message"] = text;
+    reply["node"] = _jsonMessage->getNodeName();
+    reply["time"] = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss");
+    publish(_topic + "/response", reply, 1);
+}
+
+// 增加挂载点：写入配置文件后由 bncCaster 重新读取并启动数据流线程
+bool MqttPublisher::addMountPoint(const QString& mountPoint, QString& text) {
+    QStringList hlp = mountPoint.split(" ", Qt::SkipEmptyParts);
+    QUrl url(hlp.value(0));
+    if (hlp.size() < 7 || !url.isValid() || url.path().mid(1).isEmpty()) {
+        text = "invalid mountpoint: " + mountPoint;
+        return false;
+    }
+
+    bncSettings settings;
+    QStringList mountPoints = settings.value("mountPoints").toStringList();
+    for (const QString& entry : mountPoints) {
+        if (QUrl(entry.split(" ").first()) == url) {
+            text = "mountpoint already exists: " + url.path().mid(1);
+            return false;
+        }
+    }
+    mountPoints.append(hlp.join(" "));
+    settings.setValue("mountPoints", mountPoints);
+    settings.sync();
+
+    text = "mountpoint added: " + url.path().mid(1);
+    emit reReadRequested();
+    return true;
+}
+
+// 删除挂载点：匹配完整 URL 或站点ID
+bool MqttPublisher::removeMountPoint(const QString& mountPoint, QString& text) {
+    if (mountPoint.isEmpty()) {
+        text = "missing mountpoint";
+        return false;
+    }
+
+    bncSettings settings;
+    QStringList mountPoints = settings.value("mountPoints").toStringList();
+    QStringList kept;
+    for (const QString& entry : mountPoints) {
+        QString urlString = entry.split(" ").first();
+        if (urlString == mountPoint || QUrl(urlString).path().mid(1) == mountPoint) {
+            continue;
+        }
+        kept.append(entry);
+    }
+    if (kept.size() == mountPoints.size()) {
+        text = "mountpoint not found: " + mountPoint;
+        return false;
+    }
+    settings.setValue("mountPoints", kept);
+    settings.sync();
+
+    text = QString("mountpoint removed: %1 (%2 entries)").arg(mountPoint).arg(mountPoints.size() - kept.size());
+    emit reReadRequested();
+    return true;
+}
+
+// 按配置的格式编码后发布
+// ----------------------------------------------------------------------------
+qint32 MqttPublisher::publish(const QString& topic, const QJsonObject& obj, quint8 qos, bool retain,
+                              bool snapshot) {
+    if (snapshot) {
+        return _mqttClient->publishSnapshot(topic, _encoder->encode(obj), qos, retain);
+    }
+    return _mqttClient->publishPayload(topic, _encoder->encode(obj), qos, retain);
+}
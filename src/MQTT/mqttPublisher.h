@@ -0,0 +1,84 @@
+#ifndef MQTTPUBLISHER_H
+#define MQTTPUBLISHER_H
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QDateTime>
+#include <QJsonObject>
+
+class QTimer;
+class MqttClient;
+class JsonMessage;
+class MessageEncoder;
+class MqttDataOutput;
+class bncGetThread;
+
+/**
+ * @brief MQTT站点状态发布服务
+ * 由 bncCaster 持有，不依赖 bncWindow，因此在 --nw 模式下同样可用。
+ * 配置读取自 mqttHost/mqttPort/mqttTopic/mqttUser/mqttPwd/mqttNodeId/mqttSendInterval 等。
+ * 启用 mqttData 时另外发布观测值与PPP结果（见 MqttDataOutput）。
+ * 启用 mqttCommands 时订阅 <topic>/cmd 接收控制命令，执行结果发布在 <topic>/response。
+ */
+class MqttPublisher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MqttPublisher(QObject* parent = nullptr);
+    ~MqttPublisher();
+
+    static bool isConfigured(); // 配置中是否启用了MQTT（Host/Port/Topic 均不为空）
+
+    void start(); // 连接服务器并启动定时发布
+    void stop();  // 停止发布并断开连接
+
+    void addGetThread(bncGetThread* getThread);  // 为数据流线程分配状态槽
+    void removeStation(const QByteArray& staID); // 移除站点（挂载点被删除时）
+
+    JsonMessage* jsonMessage() const { return _jsonMessage; }
+    MqttClient*  mqttClient() const { return _mqttClient; }
+
+signals:
+    void reReadRequested(); // 命令修改了挂载点配置，需要 bncCaster 重新读取
+
+private slots:
+    void slotPublishMessage(const QString& topic); // 定时发布站点状态
+    void slotConnected(); // 连接（重连）成功后立即发布全量快照
+    void slotPublishEvent(const QJsonObject& event); // 发布站点状态变化事件
+    void slotCommandReceived(const QString& topic, const QString& message); // 处理控制命令
+
+private:
+    qint32 publish(const QString& topic, const QJsonObject& obj, quint8 qos = 0, bool retain = false,
+                   bool snapshot = false);
+    bool addMountPoint(const QString& mountPoint, QString& text);   // 在 mountPoints 配置中增加一条
+    bool removeMountPoint(const QString& mountPoint, QString& text); // 按 URL 或站点ID删除
+
+    MqttClient*  _mqttClient;  // MQTT客户端
+    JsonMessage* _jsonMessage; // 站点状态表
+    QString      _host;
+    quint16      _port;
+    QString      _topic;
+    QString      _user;
+    QString      _password;
+    QString      _nodeId;
+    int          _sendInterval; // 发布间隔（秒）
+    bool         _deltaMode;    // 增量发布模式
+    bool         _rtcmTypes;    // 发布RTCM消息类型计数（<topic>/rtcm）
+    int          _queueSize;    // 离线队列最多缓存的消息数
+    QString      _queueFile;    // 离线队列溢写文件（为空时只用内存）
+    int          _drainRate;    // 重连后补发速率（条/秒）
+    bool         _events;       // 发布站点状态变化事件（<topic>/event）
+    int          _eventInterval; // 同一站点事件最小间隔（秒）
+    QTimer*      _eventTimer;   // 事件检查定时器
+    bool         _commands;     // 接收控制命令（<topic>/cmd）
+    MqttDataOutput* _dataOutput; // 观测值/PPP实时数据输出（mqttData）
+    MessageEncoder* _encoder;   // 消息编码器（mqttFormat: JSON/CBOR）
+    int          _fullInterval; // 增量模式下全量快照间隔（秒）
+    QDateTime    _lastFullTime; // 上次全量快照时间
+    bool         _forceFull;    // 下次发布强制全量
+    bool         _running;
+};
+
+#endif // MQTTPUBLISHER_H
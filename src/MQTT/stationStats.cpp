@@ -0,0 +1,283 @@
+#include "stationStats.h"
+#include <QDateTime>
+#include <QJsonArray>
+#include <QMap>
+#include <cmath>
+
+namespace {
+    const qint64 kHistBaseUs = 50000; // 直方图第一档上限 50ms，之后每档乘以 sqrt(2)
+
+    qint64 nowSeconds() {
+        return QDateTime::currentMSecsSinceEpoch() / 1000;
+    }
+
+    double round2(double value) {
+        return std::round(value * 100.0) / 100.0;
+    }
+}
+
+//// 环形桶
+// ----------------------------------------------------------------------------
+
+StationStats::Ring::Ring(int bucketSeconds, int bucketCount)
+    : bucketSec(bucketSeconds)
+      , nBuckets(bucketCount)
+      , buckets(new Bucket[bucketCount]) {
+    for (int ii = 0; ii < nBuckets; ii++) {
+        buckets[ii].period.storeRelaxed(-1);
+    }
+}
+
+StationStats::Ring::~Ring() {
+    delete [] buckets;
+}
+
+// 单写者：桶所属周期过期时先清零再发布新的周期序号
+StationStats::Bucket* StationStats::Ring::current(qint64 nowSec) {
+    qint64 period = nowSec / bucketSec;
+    Bucket* bucket = &buckets[period % nBuckets];
+    if (bucket->period.loadAcquire() != period) {
+        bucket->period.storeRelaxed(-1);
+        bucket->bytes.storeRelaxed(0);
+        bucket->messages.storeRelaxed(0);
+        bucket->epochs.storeRelaxed(0);
+        bucket->latCount.storeRelaxed(0);
+        bucket->latSumUs.storeRelaxed(0);
+        bucket->latMinUs.storeRelaxed(0);
+        bucket->latMaxUs.storeRelaxed(0);
+        for (int ii = 0; ii < nHistBins; ii++) {
+            bucket->hist[ii].storeRelaxed(0);
+        }
+        bucket->period.storeRelease(period);
+    }
+    return bucket;
+}
+
+StationStats::Summary::Summary()
+    : bytes(0), messages(0), epochs(0), latCount(0), latSumUs(0), latMinUs(0), latMaxUs(0) {
+    for (int ii = 0; ii < nHistBins; ii++) {
+        hist[ii] = 0;
+    }
+}
+
+// 构造
+// ----------------------------------------------------------------------------
+StationStats::StationStats()
+    : _startSec(nowSeconds())
+      , _fine(10, 30)
+      , _coarse(60, 60) {
+}
+
+//// 写入
+// ----------------------------------------------------------------------------
+
+void StationStats::addBytes(int bytes) {
+    qint64 now = nowSeconds();
+    _fine.current(now)->bytes.fetchAndAddRelaxed(bytes);
+    _coarse.current(now)->bytes.fetchAndAddRelaxed(bytes);
+}
+
+void StationStats::addMessages(int count) {
+    if (count <= 0) {
+        return;
+    }
+    qint64 now = nowSeconds();
+    _fine.current(now)->messages.fetchAndAddRelaxed(count);
+    _coarse.current(now)->messages.fetchAndAddRelaxed(count);
+}
+
+void StationStats::addEpochs(int count) {
+    if (count <= 0) {
+        return;
+    }
+    qint64 now = nowSeconds();
+    _fine.current(now)->epochs.fetchAndAddRelaxed(count);
+    _coarse.current(now)->epochs.fetchAndAddRelaxed(count);
+}
+
+void StationStats::addLatency(double latency) {
+    qint64 latUs = static_cast<qint64>(std::llround(latency * 1.e6));
+    int bin = histBin(latUs);
+    qint64 now = nowSeconds();
+    Bucket* buckets[2] = { _fine.current(now), _coarse.current(now) };
+    for (Bucket* bucket : buckets) {
+        // 单写者，min/max 直接比较后写入即可
+        if (bucket->latCount.loadRelaxed() == 0 || latUs < bucket->latMinUs.loadRelaxed()) {
+            bucket->latMinUs.storeRelaxed(latUs);
+        }
+        if (bucket->latCount.loadRelaxed() == 0 || latUs > bucket->latMaxUs.loadRelaxed()) {
+            bucket->latMaxUs.storeRelaxed(latUs);
+        }
+        bucket->latSumUs.fetchAndAddRelaxed(latUs);
+        bucket->hist[bin].fetchAndAddRelaxed(1);
+        bucket->latCount.fetchAndAddRelaxed(1);
+    }
+}
+
+//// 读取
+// ----------------------------------------------------------------------------
+
+QJsonObject StationStats::toJson() const {
+    qint64 now = nowSeconds();
+    QJsonObject obj;
+    obj["1m"] = windowToJson(_fine, 60, now);
+    obj["5m"] = windowToJson(_fine, 300, now);
+    obj["1h"] = windowToJson(_coarse, 3600, now);
+    return obj;
+}
+
+double StationStats::byteRate() const {
+    qint64 now = nowSeconds();
+    Summary sum;
+    summarize(_fine, 60, now, sum);
+    return double(sum.bytes) / windowSpan(_fine, 60, now);
+}
+
+// 汇总最近 windowSec 秒内（含当前未满的桶）的所有桶
+void StationStats::summarize(const Ring& ring, int windowSec, qint64 nowSec, Summary& sum) const {
+    qint64 lastPeriod = nowSec / ring.bucketSec;
+    qint64 firstPeriod = lastPeriod - windowSec / ring.bucketSec + 1;
+    for (int ii = 0; ii < ring.nBuckets; ii++) {
+        const Bucket& bucket = ring.buckets[ii];
+        qint64 period = bucket.period.loadAcquire();
+        if (period < firstPeriod || period > lastPeriod) {
+            continue;
+        }
+        sum.bytes += bucket.bytes.loadRelaxed();
+        sum.messages += bucket.messages.loadRelaxed();
+        sum.epochs += bucket.epochs.loadRelaxed();
+        int latCount = bucket.latCount.loadRelaxed();
+        if (latCount > 0) {
+            qint64 latMin = bucket.latMinUs.loadRelaxed();
+            qint64 latMax = bucket.latMaxUs.loadRelaxed();
+            if (sum.latCount == 0 || latMin < sum.latMinUs) {
+                sum.latMinUs = latMin;
+            }
+            if (sum.latCount == 0 || latMax > sum.latMaxUs) {
+                sum.latMaxUs = latMax;
+            }
+            sum.latCount += latCount;
+            sum.latSumUs += bucket.latSumUs.loadRelaxed();
+            for (int jj = 0; jj < nHistBins; jj++) {
+                sum.hist[jj] += bucket.hist[jj].loadRelaxed();
+            }
+        }
+    }
+}
+
+// 单个窗口：bps/mps/eps 为每秒平均值，lat 为 [min, mean, p95, max]（无延迟样本时为空）
+QJsonObject StationStats::windowToJson(const Ring& ring, int windowSec, qint64 nowSec) const {
+    Summary sum;
+    summarize(ring, windowSec, nowSec, sum);
+    qint64 span = windowSpan(ring, windowSec, nowSec);
+
+    QJsonObject obj;
+    obj["bps"] = round2(double(sum.bytes) / span);
+    obj["mps"] = round2(double(sum.messages) / span);
+    obj["eps"] = round2(double(sum.epochs) / span);
+
+    QJsonArray lat;
+    if (sum.latCount > 0) {
+        // p95：累计直方图首次达到 95% 的档位上限，并限制在 [min, max] 内
+        qint64 target = static_cast<qint64>(std::ceil(0.95 * sum.latCount));
+        qint64 cumulative = 0;
+        double p95 = sum.latMaxUs / 1.e6;
+        for (int ii = 0; ii < nHistBins; ii++) {
+            cumulative += sum.hist[ii];
+            if (cumulative >= target) {
+                p95 = histUpperEdge(ii);
+                break;
+            }
+        }
+        p95 = qBound(sum.latMinUs / 1.e6, p95, sum.latMaxUs / 1.e6);
+
+        lat.append(round2(sum.latMinUs / 1.e6));
+        lat.append(round2(double(sum.latSumUs) / sum.latCount / 1.e6));
+        lat.append(round2(p95));
+        lat.append(round2(sum.latMaxUs / 1.e6));
+    }
+    obj["lat"] = lat;
+    return obj;
+}
+
+// 当前桶尚未结束，窗口实际覆盖的时长为完整桶加上当前桶已过去的部分
+qint64 StationStats::windowSpan(const Ring& ring, int windowSec, qint64 nowSec) const {
+    qint64 span = windowSec - ring.bucketSec + (nowSec % ring.bucketSec) + 1;
+    span = qMin(span, nowSec - _startSec + 1);
+    return span < 1 ? 1 : span;
+}
+
+// 延迟直方图档位：第 k 档上限为 50ms * 2^(k/2)，最后一档收纳所有更大的值
+int StationStats::histBin(qint64 latUs) {
+    if (latUs < kHistBaseUs) {
+        return 0;
+    }
+    int bin = 1 + static_cast<int>(std::floor(2.0 * std::log2(double(latUs) / kHistBaseUs)));
+    return qMin(bin, int(nHistBins) - 1);
+}
+
+double StationStats::histUpperEdge(int bin) {
+    return kHistBaseUs * std::pow(2.0, bin / 2.0) / 1.e6;
+}
+
+//// 按消息类型计数
+// ----------------------------------------------------------------------------
+
+MessageTypeStats::MessageTypeStats() {
+}
+
+// 单写者：表项一旦占用不再释放，因此发布线程读到非零 type 后即可安全读取计数
+MessageTypeStats::Entry* MessageTypeStats::find(int type) {
+    if (type <= 0) {
+        return &_overflow;
+    }
+    int start = type % nEntries;
+    for (int ii = 0; ii < nEntries; ii++) {
+        Entry& entry = _entries[(start + ii) % nEntries];
+        int entryType = entry.type.loadRelaxed();
+        if (entryType == type) {
+            return &entry;
+        }
+        if (entryType == 0) {
+            entry.type.storeRelease(type);
+            return &entry;
+        }
+    }
+    return &_overflow;
+}
+
+void MessageTypeStats::add(int type, int bytes) {
+    Entry* entry = find(type);
+    entry->count.fetchAndAddRelaxed(1);
+    entry->bytes.fetchAndAddRelaxed(bytes);
+    entry->lastMSecs.storeRelaxed(QDateTime::currentMSecsSinceEpoch());
+}
+
+// [{"type":1077,"count":..,"bytes":..,"last":"yyyy-MM-dd hh:mm:ss","age":秒}, ...]
+QJsonArray MessageTypeStats::toJson() const {
+    QMap<int, const Entry*> sorted;
+    for (int ii = 0; ii < nEntries; ii++) {
+        int type = _entries[ii].type.loadAcquire();
+        if (type != 0) {
+            sorted.insert(type, &_entries[ii]);
+        }
+    }
+    if (_overflow.count.loadRelaxed() > 0) {
+        sorted.insert(0, &_overflow);
+    }
+
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QJsonArray arr;
+    for (auto it = sorted.constBegin(); it != sorted.constEnd(); ++it) {
+        const Entry* entry = it.value();
+        qint64 lastMSecs = entry->lastMSecs.loadRelaxed();
+        QJsonObject obj;
+        obj["type"] = it.key();
+        obj["count"] = entry->count.loadRelaxed();
+        obj["bytes"] = entry->bytes.loadRelaxed();
+        obj["last"] = QDateTime::fromMSecsSinceEpoch(lastMSecs).toString("yyyy-MM-dd hh:mm:ss");
+        obj["age"] = round2((now - lastMSecs) / 1000.0);
+        arr.append(obj);
+    }
+    return arr;
+}
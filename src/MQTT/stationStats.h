@@ -0,0 +1,117 @@
+#ifndef STATIONSTATS_H
+#define STATIONSTATS_H
+
+#include <QAtomicInteger>
+#include <QJsonObject>
+#include <QJsonArray>
+
+/**
+ * @brief 单站滑动窗口统计（1分钟 / 5分钟 / 1小时）
+ * 统计字节率、RTCM消息率、历元率以及延迟的 min/mean/p95/max。
+ *
+ * 内存固定：10秒粒度的环形缓冲覆盖 5 分钟，60秒粒度的环形缓冲覆盖 1 小时；
+ * 延迟分位数由每个桶内的对数直方图估计。
+ * 写入方只有所属的数据流线程（单写者），全部为原子操作，不加锁；
+ * 发布线程读取时若恰逢桶翻转，只会影响当前桶的精度。
+ */
+class StationStats
+{
+public:
+    StationStats();
+
+    //// 数据流线程调用
+    /////----------------------------------------------------------
+    void addBytes(int bytes);
+    void addMessages(int count);
+    void addEpochs(int count);
+    void addLatency(double latency); // 单位与 latencyChecker::currentLatency() 相同（秒）
+
+    //// 发布线程调用
+    /////----------------------------------------------------------
+    QJsonObject toJson() const; // {"1m":{...},"5m":{...},"1h":{...}}
+    double byteRate() const;    // 1分钟窗口的平均字节率（字节/秒）
+
+private:
+    enum { nHistBins = 24 };
+
+    // 单个时间桶
+    struct Bucket {
+        QAtomicInteger<qint64> period;   // 桶所属周期序号（秒 / 桶长度），-1 为空
+        QAtomicInteger<qint64> bytes;
+        QAtomicInt             messages;
+        QAtomicInt             epochs;
+        QAtomicInt             latCount;
+        QAtomicInteger<qint64> latSumUs;
+        QAtomicInteger<qint64> latMinUs;
+        QAtomicInteger<qint64> latMaxUs;
+        QAtomicInt             hist[nHistBins];
+    };
+
+    // 固定长度的环形桶序列
+    struct Ring {
+        Ring(int bucketSec, int nBuckets);
+        ~Ring();
+        Bucket* current(qint64 nowSec); // 单写者：必要时重置并返回当前桶
+        const int bucketSec;
+        const int nBuckets;
+        Bucket*   buckets;
+    private:
+        Ring(const Ring&);
+        Ring& operator=(const Ring&);
+    };
+
+    // 窗口汇总结果
+    struct Summary {
+        qint64 bytes;
+        qint64 messages;
+        qint64 epochs;
+        qint64 latCount;
+        qint64 latSumUs;
+        qint64 latMinUs;
+        qint64 latMaxUs;
+        qint64 hist[nHistBins];
+        Summary();
+    };
+
+    void summarize(const Ring& ring, int windowSec, qint64 nowSec, Summary& sum) const;
+    QJsonObject windowToJson(const Ring& ring, int windowSec, qint64 nowSec) const;
+    qint64 windowSpan(const Ring& ring, int windowSec, qint64 nowSec) const; // 窗口实际覆盖的秒数
+
+    static int histBin(qint64 latUs);
+    static double histUpperEdge(int bin);
+
+    qint64 _startSec; // 统计开始时间，窗口未满时按实际时长计算速率
+    Ring   _fine;     // 10秒 x 30
+    Ring   _coarse;   // 60秒 x 60
+};
+
+/**
+ * @brief 单站按RTCM消息类型的计数（次数、字节数、最后接收时间）
+ * 固定容量的开放寻址表，写入方只有所属的数据流线程（单写者），无锁；
+ * 超出容量的类型统一计入 type 0。计数自启动起累计，速率由相邻两次发布相减得到。
+ */
+class MessageTypeStats
+{
+public:
+    MessageTypeStats();
+
+    void add(int type, int bytes); // 数据流线程调用
+    QJsonArray toJson() const;     // 发布线程调用，按消息类型排序
+
+private:
+    enum { nEntries = 64 };
+
+    struct Entry {
+        QAtomicInt             type;      // 0 表示空位（或溢出项）
+        QAtomicInteger<qint64> count;
+        QAtomicInteger<qint64> bytes;
+        QAtomicInteger<qint64> lastMSecs; // 最后接收时间（毫秒，UTC纪元）
+    };
+
+    Entry* find(int type); // 单写者：查找或占用表项
+
+    Entry _entries[nEntries];
+    Entry _overflow;
+};
+
+#endif // STATIONSTATS_H
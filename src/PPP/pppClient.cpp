@@ -14,8 +14,6 @@
  *
  * -----------------------------------------------------------------------*/
 
-#include <QThreadStorage>
-
 #include <iostream>
 #include <iomanip>
 #include <cmath>
@@ -24,7 +22,6 @@
 #include <stdexcept>
 
 #include "pppClient.h"
-#include "pppEphPool.h"
 #include "pppObsPool.h"
 #include "bncconst.h"
 #include "bncutils.h"
@@ -35,14 +32,15 @@
 using namespace BNC_PPP;
 using namespace std;
 
-// Global variable holding thread-specific pointers
+// Client of the rover the current thread is working on (a rover thread
+// owns one client, a worker of the PPP thread pool switches per epoch)
 //////////////////////////////////////////////////////////////////////////////
-QThreadStorage<t_pppClient*> CLIENTS;
+static thread_local t_pppClient* CURRENT = 0;
 
 // Static function returning thread-specific pointer
 //////////////////////////////////////////////////////////////////////////////
 t_pppClient* t_pppClient::instance() {
-  return CLIENTS.localData();
+  return CURRENT;
 }
 
 // Constructor
@@ -52,7 +50,15 @@ t_pppClient::t_pppClient(const t_pppOptions* opt) {
   _output   = 0;
   _opt      = new t_pppOptions(*opt);
   _log      = new ostringstream();
-  _ephPool  = new t_pppEphPool();
+  if (_opt->_realTime) {
+    _corrStore    = t_pppCorrStore::channel(_opt);
+    _ownCorrStore = false;
+  }
+  else {
+    _corrStore    = new t_pppCorrStore();
+    _ownCorrStore = true;
+  }
+  _corr     = _corrStore->snapshot();
   _obsPool  = new t_pppObsPool();
   _staRover = new t_pppStation();
   _filter   = new t_pppFilter();
@@ -66,16 +72,24 @@ t_pppClient::t_pppClient(const t_pppOptions* opt) {
       //_tides->printAllBlqSets();
     }
   }
-  CLIENTS.setLocalData(this);  // CLIENTS takes ownership over "this"
+  CURRENT = this;
 }
 
 // Destructor
 //////////////////////////////////////////////////////////////////////////////
 t_pppClient::~t_pppClient() {
+  if (CURRENT == this) {
+    CURRENT = 0;
+  }
   _running = false;
   delete _log;
   delete _opt;
-  delete _ephPool;
+  if (_ownCorrStore) {
+    delete _corrStore;
+  }
+  else {
+    t_pppCorrStore::releaseChannel(_corrStore);
+  }
   delete _obsPool;
   delete _staRover;
   if (_antex) {
@@ -89,65 +103,42 @@ t_pppClient::~t_pppClient() {
 //
 //////////////////////////////////////////////////////////////////////////////
 void t_pppClient::putEphemeris(const t_eph* eph) {
-  const t_ephGPS* ephGPS = dynamic_cast<const t_ephGPS*>(eph);
-  const t_ephGlo* ephGlo = dynamic_cast<const t_ephGlo*>(eph);
-  const t_ephGal* ephGal = dynamic_cast<const t_ephGal*>(eph);
-  const t_ephBDS* ephBDS = dynamic_cast<const t_ephBDS*>(eph);
-  if      (ephGPS) {
-    _ephPool->putEphemeris(new t_ephGPS(*ephGPS));
-  }
-  else if (ephGlo) {
-    _ephPool->putEphemeris(new t_ephGlo(*ephGlo));
-  }
-  else if (ephGal) {
-    _ephPool->putEphemeris(new t_ephGal(*ephGal));
-  }
-  else if (ephBDS) {
-    _ephPool->putEphemeris(new t_ephBDS(*ephBDS));
-  }
+  _corrStore->putEphemeris(eph);
 }
 
 //
 //////////////////////////////////////////////////////////////////////////////
 void t_pppClient::putTec(const t_vTec* vTec) {
-  _obsPool->putTec(new t_vTec(*vTec));
+  _corrStore->putTec(vTec);
 }
 
 //
 //////////////////////////////////////////////////////////////////////////////
 void t_pppClient::putOrbCorrections(const vector<t_orbCorr*>& corr) {
-  for (unsigned ii = 0; ii < corr.size(); ii++) {
-    _ephPool->putOrbCorrection(new t_orbCorr(*corr[ii]));
-  }
+  _corrStore->putOrbCorrections(corr);
 }
 
 //
 //////////////////////////////////////////////////////////////////////////////
 void t_pppClient::putClkCorrections(const vector<t_clkCorr*>& corr) {
-  for (unsigned ii = 0; ii < corr.size(); ii++) {
-    _ephPool->putClkCorrection(new t_clkCorr(*corr[ii]));
-  }
+  _corrStore->putClkCorrections(corr);
 }
 
 //
 //////////////////////////////////////////////////////////////////////////////
 void t_pppClient::putCodeBiases(const vector<t_satCodeBias*>& biases) {
-  for (unsigned ii = 0; ii < biases.size(); ii++) {
-    _obsPool->putCodeBias(new t_satCodeBias(*biases[ii]));
-  }
+  _corrStore->putCodeBiases(biases);
 }
 
 //
 //////////////////////////////////////////////////////////////////////////////
 void t_pppClient::putPhaseBiases(const vector<t_satPhaseBias*>& biases) {
-  for (unsigned ii = 0; ii < biases.size(); ii++) {
-    _obsPool->putPhaseBias(new t_satPhaseBias(*biases[ii]));
-  }
+  _corrStore->putPhaseBiases(biases);
 }
 
 //
 //////////////////////////////////////////////////////////////////////////////
-t_irc t_pppClient::prepareObs(const vector<t_satObs*>& satObs,
+t_irc t_pppClient::prepareObs(const vector<const t_satObs*>& satObs,
                               vector<t_pppSatObs*>& obsVector, bncTime& epoTime) {
 
   // Default
@@ -441,11 +432,17 @@ t_irc t_pppClient::cmpModel(t_pppStation* station, const ColumnVector& xyzc,
 
 //
 //////////////////////////////////////////////////////////////////////////////
-void t_pppClient::processEpoch(const vector<t_satObs*>& satObs, t_output* output) {
+void t_pppClient::processEpoch(const vector<const t_satObs*>& satObs, t_output* output) {
+
+  CURRENT = this;
 
   try {
     initOutput(output);
 
+    // Ephemerides and corrections valid for the whole epoch
+    // ------------------------------------------------------
+    _corr = _corrStore->snapshot();
+
     // Prepare Observations of the Rover
     // ---------------------------------
     if (prepareObs(satObs, _obsRover, _epoTimeRover) != success) {
@@ -598,11 +595,14 @@ t_irc t_pppClient::bancroft(const Matrix& BBpass, ColumnVector& pos) {
 //////////////////////////////////////////////////////////////////////////////
 void t_pppClient::reset() {
 
-  // to delete old orbit and clock corrections
-  delete _ephPool;
-  _ephPool  = new t_pppEphPool();
+  // to delete old orbit and clock corrections and biases (a shared
+  // store is reset by itself when the provider changes)
+  if (_ownCorrStore) {
+    _corrStore->reset();
+  }
+  _corr = _corrStore->snapshot();
 
-  // to delete old code biases
+  // to delete old epochs
   delete _obsPool;
   _obsPool  = new t_pppObsPool();
 
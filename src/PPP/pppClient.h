@@ -1,18 +1,19 @@
 #ifndef PPPCLIENT_H
 #define PPPCLIENT_H
 
+#include <memory>
 #include <sstream>
 #include <vector>
 #include "pppInclude.h"
 #include "ephemeris.h"
 #include "pppOptions.h"
 #include "pppModel.h"
+#include "pppCorrStore.h"
 
 class bncAntex;
 
 namespace BNC_PPP {
 
-class t_pppEphPool;
 class t_pppObsPool;
 class t_pppSatObs;
 class t_pppStation;
@@ -29,9 +30,10 @@ class t_pppClient : public interface_pppClient {
   void putClkCorrections(const std::vector<t_clkCorr*>& corr);
   void putCodeBiases(const std::vector<t_satCodeBias*>& biases);
   void putPhaseBiases(const std::vector<t_satPhaseBias*>& biases);
-  void processEpoch(const std::vector<t_satObs*>& satObs, t_output* output);
+  void processEpoch(const std::vector<const t_satObs*>& satObs, t_output* output);
 
-  const t_pppEphPool* ephPool() const {return _ephPool;}
+  const t_pppCorrStore::t_snapshot* corr() const {return _corr.get();}
+  const t_pppCorrStore* corrStore() const {return _corrStore;}
   const t_pppObsPool* obsPool() const {return _obsPool;}
   const bncAntex*     antex() const {return _antex;}
   const t_pppStation* staRover() const {return _staRover;}
@@ -48,7 +50,7 @@ class t_pppClient : public interface_pppClient {
   void initOutput(t_output* output);
   void finish(t_irc irc, int ind);
   void clearObs();
-  t_irc prepareObs(const std::vector<t_satObs*>& satObs,
+  t_irc prepareObs(const std::vector<const t_satObs*>& satObs,
                    std::vector<t_pppSatObs*>& obsVector, bncTime& epoTime);
   bool  preparePseudoObs(std::vector<t_pppSatObs*>& obsVector);
   void  useObsWithCodeBiasesOnly(std::vector<t_pppSatObs*>& obsVector);
@@ -63,7 +65,9 @@ class t_pppClient : public interface_pppClient {
 
 
   t_output*                 _output;
-  t_pppEphPool*             _ephPool;
+  t_pppCorrStore*           _corrStore;
+  bool                      _ownCorrStore;
+  std::shared_ptr<const t_pppCorrStore::t_snapshot> _corr; // used in current epoch
   t_pppObsPool*             _obsPool;
   bncTime                   _epoTimeRover;
   t_pppStation*             _staRover;
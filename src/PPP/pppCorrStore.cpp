@@ -0,0 +1,428 @@
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      t_pppCorrStore
+ *
+ * Purpose:    Ephemerides, SSR corrections, biases and VTEC shared by the
+ *             PPP rovers as immutable, versioned snapshots
+ *
+ * Created:    16-Oct-2026
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include "pppCorrStore.h"
+#include "pppClient.h"
+#include "pppOptions.h"
+#include "bnccore.h"
+#include "bncutils.h"
+#include "combination/bnccomb.h"
+
+using namespace BNC_PPP;
+using namespace std;
+
+QMutex                                                   t_pppCorrStore::_channelsMutex;
+map<t_pppCorrStore::t_channelKey, t_pppCorrStore*>       t_pppCorrStore::_channels;
+
+// Constructor
+/////////////////////////////////////////////////////////////////////////////
+t_pppCorrStore::t_pppCorrStore(const string& corrMount, const string& ionoMount,
+                               unsigned maxQueueSize) {
+  _corrMount    = corrMount;
+  _ionoMount    = ionoMount;
+  _maxQueueSize = maxQueueSize;
+  _numUsers     = 0;
+  _snapshot     = make_shared<t_snapshot>();
+}
+
+// Destructor (readers may still hold older snapshots)
+/////////////////////////////////////////////////////////////////////////////
+t_pppCorrStore::~t_pppCorrStore() {
+}
+
+// Store shared by all real-time rovers with the same correction streams.
+// It is fed directly from the signals of BNC_CORE and BNC_CMB, i.e. once
+// per message and not once per rover, and lives as long as one of its
+// rovers (see releaseChannel), so a restart of PPP begins with no data.
+/////////////////////////////////////////////////////////////////////////////
+t_pppCorrStore* t_pppCorrStore::channel(const t_pppOptions* opt) {
+  QMutexLocker locker(&_channelsMutex);
+
+  t_channelKey key(opt->_corrMount, opt->_ionoMount);
+  t_pppCorrStore* store = 0;
+  map<t_channelKey, t_pppCorrStore*>::const_iterator it = _channels.find(key);
+  if (it != _channels.end()) {
+    store = it->second;
+  }
+  else {
+    store = new t_pppCorrStore(opt->_corrMount, opt->_ionoMount);
+    store->connectToCore();
+    _channels[key] = store;
+  }
+  ++store->_numUsers;
+  return store;
+}
+
+// Rover no longer uses the store, the last one deletes it
+/////////////////////////////////////////////////////////////////////////////
+void t_pppCorrStore::releaseChannel(t_pppCorrStore* store) {
+  QMutexLocker locker(&_channelsMutex);
+
+  if (--store->_numUsers > 0) {
+    return;
+  }
+  _channels.erase(t_channelKey(store->_corrMount, store->_ionoMount));
+  disconnect(BNC_CORE, 0, store, 0);
+  disconnect(BNC_CMB,  0, store, 0);
+  {
+    QMutexLocker storeLocker(&store->_mutex); // wait for a running writer
+  }
+  delete store;
+}
+
+//
+/////////////////////////////////////////////////////////////////////////////
+void t_pppCorrStore::connectToCore() {
+
+  connect(BNC_CORE, SIGNAL(newGPSEph(t_ephGPS)),
+          this, SLOT(slotNewGPSEph(t_ephGPS)), Qt::DirectConnection);
+
+  connect(BNC_CORE, SIGNAL(newGlonassEph(t_ephGlo)),
+          this, SLOT(slotNewGlonassEph(t_ephGlo)), Qt::DirectConnection);
+
+  connect(BNC_CORE, SIGNAL(newGalileoEph(t_ephGal)),
+          this, SLOT(slotNewGalileoEph(t_ephGal)), Qt::DirectConnection);
+
+  connect(BNC_CORE, SIGNAL(newBDSEph(t_ephBDS)),
+          this, SLOT(slotNewBDSEph(t_ephBDS)), Qt::DirectConnection);
+
+  connect(BNC_CORE, SIGNAL(newTec(t_vTec)),
+          this, SLOT(slotNewTec(t_vTec)), Qt::DirectConnection);
+
+  connect(BNC_CORE, SIGNAL(newOrbCorrections(QList<t_orbCorr>)),
+          this, SLOT(slotNewOrbCorrections(QList<t_orbCorr>)), Qt::DirectConnection);
+
+  connect(BNC_CORE, SIGNAL(newClkCorrections(QList<t_clkCorr>)),
+          this, SLOT(slotNewClkCorrections(QList<t_clkCorr>)), Qt::DirectConnection);
+
+  connect(BNC_CORE, SIGNAL(newCodeBiases(QList<t_satCodeBias>)),
+          this, SLOT(slotNewCodeBiases(QList<t_satCodeBias>)), Qt::DirectConnection);
+
+  connect(BNC_CORE, SIGNAL(newPhaseBiases(QList<t_satPhaseBias>)),
+          this, SLOT(slotNewPhaseBiases(QList<t_satPhaseBias>)), Qt::DirectConnection);
+
+  connect(BNC_CMB, SIGNAL(newOrbCorrections(QList<t_orbCorr>)),
+          this, SLOT(slotNewOrbCorrections(QList<t_orbCorr>)), Qt::DirectConnection);
+
+  connect(BNC_CMB, SIGNAL(newClkCorrections(QList<t_clkCorr>)),
+          this, SLOT(slotNewClkCorrections(QList<t_clkCorr>)), Qt::DirectConnection);
+
+  connect(BNC_CMB, SIGNAL(newCodeBiases(QList<t_satCodeBias>)),
+          this, SLOT(slotNewCodeBiases(QList<t_satCodeBias>)), Qt::DirectConnection);
+
+  connect(BNC_CORE, SIGNAL(providerIDChanged(QString)),
+          this, SLOT(slotProviderIDChanged(QString)), Qt::DirectConnection);
+}
+
+// Writable copy of the current snapshot (shares all unchanged satellites)
+/////////////////////////////////////////////////////////////////////////////
+shared_ptr<t_pppCorrStore::t_snapshot> t_pppCorrStore::beginUpdate() const {
+  return make_shared<t_snapshot>(*atomic_load(&_snapshot));
+}
+
+// Make the new snapshot visible to the readers
+/////////////////////////////////////////////////////////////////////////////
+void t_pppCorrStore::publish(shared_ptr<t_snapshot> snapshot) {
+  snapshot->_version += 1;
+  atomic_store(&_snapshot, shared_ptr<const t_snapshot>(snapshot));
+}
+
+// Copy of an ephemeris of the systems used in PPP (0 for other systems)
+/////////////////////////////////////////////////////////////////////////////
+static t_eph* copyEph(const t_eph* eph) {
+  const t_ephGPS* ephGPS = dynamic_cast<const t_ephGPS*>(eph);
+  const t_ephGlo* ephGlo = dynamic_cast<const t_ephGlo*>(eph);
+  const t_ephGal* ephGal = dynamic_cast<const t_ephGal*>(eph);
+  const t_ephBDS* ephBDS = dynamic_cast<const t_ephBDS*>(eph);
+  if      (ephGPS) {
+    return new t_ephGPS(*ephGPS);
+  }
+  else if (ephGlo) {
+    return new t_ephGlo(*ephGlo);
+  }
+  else if (ephGal) {
+    return new t_ephGal(*ephGal);
+  }
+  else if (ephBDS) {
+    return new t_ephBDS(*ephBDS);
+  }
+  return 0;
+}
+
+//
+/////////////////////////////////////////////////////////////////////////////
+void t_pppCorrStore::putEphemeris(const t_eph* eph) {
+  shared_ptr<const t_eph> newEph(copyEph(eph));
+  if (!newEph) {
+    return;
+  }
+
+  QMutexLocker locker(&_mutex);
+
+  shared_ptr<const t_snapshot> current = atomic_load(&_snapshot);
+  int iPrn = newEph->prn().toInt();
+  const t_snapshot::t_ephList* oldEphs = current->_ephs[iPrn].get();
+  if (oldEphs && !oldEphs->empty() && !newEph->isNewerThan(oldEphs->front().get())) {
+    return;
+  }
+
+  shared_ptr<t_snapshot::t_ephList> ephs = make_shared<t_snapshot::t_ephList>();
+  ephs->push_back(newEph);
+  if (oldEphs) {
+    ephs->insert(ephs->end(), oldEphs->begin(), oldEphs->end());
+  }
+  if (_maxQueueSize > 0 && ephs->size() > _maxQueueSize) {
+    ephs->resize(_maxQueueSize);
+  }
+
+  shared_ptr<t_snapshot> snapshot = beginUpdate();
+  snapshot->_ephs[iPrn] = ephs;
+  publish(snapshot);
+}
+
+//
+/////////////////////////////////////////////////////////////////////////////
+void t_pppCorrStore::putTec(const t_vTec* vTec) {
+  QMutexLocker locker(&_mutex);
+  shared_ptr<t_snapshot> snapshot = beginUpdate();
+  snapshot->_vTec = make_shared<t_vTec>(*vTec);
+  publish(snapshot);
+}
+
+// Corrections are attached to copies of the ephemerides with matching IOD
+/////////////////////////////////////////////////////////////////////////////
+void t_pppCorrStore::putOrbCorrections(const vector<t_orbCorr*>& corr) {
+  QMutexLocker locker(&_mutex);
+  shared_ptr<t_snapshot> snapshot = beginUpdate();
+  for (unsigned ii = 0; ii < corr.size(); ii++) {
+    int iPrn = corr[ii]->_prn.toInt();
+    if (!snapshot->_ephs[iPrn]) {
+      continue;
+    }
+    shared_ptr<t_snapshot::t_ephList> ephs = make_shared<t_snapshot::t_ephList>(*snapshot->_ephs[iPrn]);
+    for (unsigned iEph = 0; iEph < ephs->size(); iEph++) {
+      if ((*ephs)[iEph]->IOD() == corr[ii]->_iod) {
+        t_eph* eph = copyEph((*ephs)[iEph].get());
+        eph->setOrbCorr(corr[ii]);
+        (*ephs)[iEph].reset(eph);
+      }
+    }
+    snapshot->_ephs[iPrn] = ephs;
+  }
+  publish(snapshot);
+}
+
+//
+/////////////////////////////////////////////////////////////////////////////
+void t_pppCorrStore::putClkCorrections(const vector<t_clkCorr*>& corr) {
+  QMutexLocker locker(&_mutex);
+  shared_ptr<t_snapshot> snapshot = beginUpdate();
+  for (unsigned ii = 0; ii < corr.size(); ii++) {
+    snapshot->_lastClkCorrTime = corr[ii]->_time;
+    int iPrn = corr[ii]->_prn.toInt();
+    if (!snapshot->_ephs[iPrn]) {
+      continue;
+    }
+    shared_ptr<t_snapshot::t_ephList> ephs = make_shared<t_snapshot::t_ephList>(*snapshot->_ephs[iPrn]);
+    for (unsigned iEph = 0; iEph < ephs->size(); iEph++) {
+      if ((*ephs)[iEph]->IOD() == corr[ii]->_iod) {
+        t_eph* eph = copyEph((*ephs)[iEph].get());
+        eph->setClkCorr(corr[ii]);
+        (*ephs)[iEph].reset(eph);
+      }
+    }
+    snapshot->_ephs[iPrn] = ephs;
+  }
+  publish(snapshot);
+}
+
+//
+/////////////////////////////////////////////////////////////////////////////
+void t_pppCorrStore::putCodeBiases(const vector<t_satCodeBias*>& biases) {
+  QMutexLocker locker(&_mutex);
+  shared_ptr<t_snapshot> snapshot = beginUpdate();
+  for (unsigned ii = 0; ii < biases.size(); ii++) {
+    snapshot->_satCodeBiases[biases[ii]->_prn.toInt()] = make_shared<t_satCodeBias>(*biases[ii]);
+  }
+  publish(snapshot);
+}
+
+//
+/////////////////////////////////////////////////////////////////////////////
+void t_pppCorrStore::putPhaseBiases(const vector<t_satPhaseBias*>& biases) {
+  QMutexLocker locker(&_mutex);
+  shared_ptr<t_snapshot> snapshot = beginUpdate();
+  for (unsigned ii = 0; ii < biases.size(); ii++) {
+    snapshot->_satPhaseBiases[biases[ii]->_prn.toInt()] = make_shared<t_satPhaseBias>(*biases[ii]);
+  }
+  publish(snapshot);
+}
+
+// Delete all ephemerides, corrections and biases
+/////////////////////////////////////////////////////////////////////////////
+void t_pppCorrStore::reset() {
+  QMutexLocker locker(&_mutex);
+  shared_ptr<t_snapshot> snapshot = make_shared<t_snapshot>();
+  snapshot->_version = atomic_load(&_snapshot)->_version;
+  publish(snapshot);
+}
+
+//
+/////////////////////////////////////////////////////////////////////////////
+void t_pppCorrStore::slotNewGPSEph(t_ephGPS eph) {
+  putEphemeris(&eph);
+}
+
+//
+/////////////////////////////////////////////////////////////////////////////
+void t_pppCorrStore::slotNewGlonassEph(t_ephGlo eph) {
+  putEphemeris(&eph);
+}
+
+//
+/////////////////////////////////////////////////////////////////////////////
+void t_pppCorrStore::slotNewGalileoEph(t_ephGal eph) {
+  putEphemeris(&eph);
+}
+
+//
+/////////////////////////////////////////////////////////////////////////////
+void t_pppCorrStore::slotNewBDSEph(t_ephBDS eph) {
+  putEphemeris(&eph);
+}
+
+//
+/////////////////////////////////////////////////////////////////////////////
+void t_pppCorrStore::slotNewTec(t_vTec vTec) {
+  if (vTec._layers.size() == 0) {
+    return;
+  }
+  if (_ionoMount.empty() && _corrMount.empty()) {
+    return;
+  }
+  if ( _ionoMount.empty() &&
+      !_corrMount.empty() && _corrMount != vTec._staID) {
+    return;
+  }
+  if (!_ionoMount.empty() && _ionoMount != vTec._staID) {
+    return;
+  }
+  putTec(&vTec);
+}
+
+//
+/////////////////////////////////////////////////////////////////////////////
+void t_pppCorrStore::slotNewOrbCorrections(QList<t_orbCorr> orbCorr) {
+  if (orbCorr.size() == 0) {
+    return;
+  }
+  if (_corrMount.empty() || _corrMount != orbCorr[0]._staID) {
+    return;
+  }
+  vector<t_orbCorr*> corrections;
+  for (int ii = 0; ii < orbCorr.size(); ii++) {
+    corrections.push_back(&orbCorr[ii]);
+  }
+  putOrbCorrections(corrections);
+}
+
+//
+/////////////////////////////////////////////////////////////////////////////
+void t_pppCorrStore::slotNewClkCorrections(QList<t_clkCorr> clkCorr) {
+  if (clkCorr.size() == 0) {
+    return;
+  }
+  if (_corrMount.empty() || _corrMount != clkCorr[0]._staID) {
+    return;
+  }
+  vector<t_clkCorr*> corrections;
+  for (int ii = 0; ii < clkCorr.size(); ii++) {
+    corrections.push_back(&clkCorr[ii]);
+  }
+  putClkCorrections(corrections);
+}
+
+//
+/////////////////////////////////////////////////////////////////////////////
+void t_pppCorrStore::slotNewCodeBiases(QList<t_satCodeBias> codeBiases) {
+  if (codeBiases.size() == 0) {
+    return;
+  }
+  if (_corrMount.empty() || _corrMount != codeBiases[0]._staID) {
+    return;
+  }
+  vector<t_satCodeBias*> biases;
+  for (int ii = 0; ii < codeBiases.size(); ii++) {
+    biases.push_back(&codeBiases[ii]);
+  }
+  putCodeBiases(biases);
+}
+
+//
+/////////////////////////////////////////////////////////////////////////////
+void t_pppCorrStore::slotNewPhaseBiases(QList<t_satPhaseBias> phaseBiases) {
+  if (phaseBiases.size() == 0) {
+    return;
+  }
+  if (_corrMount.empty() || _corrMount != phaseBiases[0]._staID) {
+    return;
+  }
+  vector<t_satPhaseBias*> biases;
+  for (int ii = 0; ii < phaseBiases.size(); ii++) {
+    biases.push_back(&phaseBiases[ii]);
+  }
+  putPhaseBiases(biases);
+}
+
+// Old orbit and clock corrections and biases must not be used any longer
+/////////////////////////////////////////////////////////////////////////////
+void t_pppCorrStore::slotProviderIDChanged(QString mountPoint) {
+  if (mountPoint.toStdString() != _corrMount) {
+    return;
+  }
+  reset();
+}
+
+//
+/////////////////////////////////////////////////////////////////////////////
+t_irc t_pppCorrStore::t_snapshot::getCrd(const t_prn& prn, const bncTime& tt,
+                                         ColumnVector& xc, ColumnVector& vv) const {
+  const t_ephList* ephs = _ephs[prn.toInt()].get();
+  if (!ephs) {
+    return failure;
+  }
+
+  for (unsigned ii = 0; ii < ephs->size(); ii++) {
+    const t_eph* eph = (*ephs)[ii].get();
+    t_irc irc = eph->getCrd(tt, xc, vv, OPT->useOrbClkCorr());
+    if (irc == success) {
+      if (outDatedBcep(eph, tt)) {
+        continue;
+      }
+      return irc;
+    }
+  }
+  return failure;
+}
+
+//
+/////////////////////////////////////////////////////////////////////////////
+int t_pppCorrStore::t_snapshot::getChannel(const t_prn& prn) const {
+  const t_ephList* ephs = _ephs[prn.toInt()].get();
+  if (ephs && !ephs->empty()) {
+    return ephs->front()->slotNum();
+  }
+  return 0;
+}
@@ -0,0 +1,104 @@
+#ifndef CORRSTORE_H
+#define CORRSTORE_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <QtCore>
+#include "pppInclude.h"
+#include "bnctime.h"
+#include "ephemeris.h"
+#include "satObs.h"
+
+namespace BNC_PPP {
+
+class t_pppOptions;
+
+// Ephemerides, orbit/clock corrections, biases and VTEC used by PPP rovers.
+// Writers build a new immutable snapshot (copy-on-write per satellite) and
+// publish it atomically, readers take the current snapshot without locking.
+// In real-time mode all rovers with the same correction (and ionosphere)
+// mountpoint share one store, which is fed once per incoming message.
+//////////////////////////////////////////////////////////////////////////////
+class t_pppCorrStore : public QObject {
+ Q_OBJECT
+ public:
+
+  class t_snapshot {
+   public:
+    t_snapshot() {_version = 0;}
+    t_irc getCrd(const t_prn& prn, const bncTime& tt,
+                 ColumnVector& xc, ColumnVector& vv) const;
+    int getChannel(const t_prn& prn) const;
+    const t_satCodeBias* satCodeBias(const t_prn& prn) const {
+      return _satCodeBiases[prn.toInt()].get();
+    }
+    const t_satPhaseBias* satPhaseBias(const t_prn& prn) const {
+      return _satPhaseBiases[prn.toInt()].get();
+    }
+    const t_vTec*  vTec() const {return _vTec.get();}
+    const bncTime& lastClkCorrTime() const {return _lastClkCorrTime;}
+    unsigned long  version() const {return _version;}
+   private:
+    friend class t_pppCorrStore;
+    typedef std::vector<std::shared_ptr<const t_eph> > t_ephList; // newest first
+    std::shared_ptr<const t_ephList>      _ephs[t_prn::MAXPRN+1];
+    std::shared_ptr<const t_satCodeBias>  _satCodeBiases[t_prn::MAXPRN+1];
+    std::shared_ptr<const t_satPhaseBias> _satPhaseBiases[t_prn::MAXPRN+1];
+    std::shared_ptr<const t_vTec>         _vTec;
+    bncTime                               _lastClkCorrTime;
+    unsigned long                         _version;
+  };
+
+  t_pppCorrStore(const std::string& corrMount = "", const std::string& ionoMount = "",
+                 unsigned maxQueueSize = 3);
+  ~t_pppCorrStore();
+
+  static t_pppCorrStore* channel(const t_pppOptions* opt);
+  static void            releaseChannel(t_pppCorrStore* store);
+
+  std::shared_ptr<const t_snapshot> snapshot() const {
+    return std::atomic_load(&_snapshot);
+  }
+
+  void putEphemeris(const t_eph* eph);
+  void putTec(const t_vTec* vTec);
+  void putOrbCorrections(const std::vector<t_orbCorr*>& corr);
+  void putClkCorrections(const std::vector<t_clkCorr*>& corr);
+  void putCodeBiases(const std::vector<t_satCodeBias*>& biases);
+  void putPhaseBiases(const std::vector<t_satPhaseBias*>& biases);
+  void reset();
+
+ public slots:
+  void slotNewGPSEph(t_ephGPS eph);
+  void slotNewGlonassEph(t_ephGlo eph);
+  void slotNewGalileoEph(t_ephGal eph);
+  void slotNewBDSEph(t_ephBDS eph);
+  void slotNewTec(t_vTec vTec);
+  void slotNewOrbCorrections(QList<t_orbCorr> orbCorr);
+  void slotNewClkCorrections(QList<t_clkCorr> clkCorr);
+  void slotNewCodeBiases(QList<t_satCodeBias> codeBiases);
+  void slotNewPhaseBiases(QList<t_satPhaseBias> phaseBiases);
+  void slotProviderIDChanged(QString mountPoint);
+
+ private:
+  std::shared_ptr<t_snapshot> beginUpdate() const;
+  void publish(std::shared_ptr<t_snapshot> snapshot);
+  void connectToCore();
+
+  typedef std::pair<std::string, std::string> t_channelKey;
+  static QMutex                                  _channelsMutex;
+  static std::map<t_channelKey, t_pppCorrStore*> _channels;
+
+  QMutex                            _mutex;     // serializes writers
+  std::shared_ptr<const t_snapshot> _snapshot;
+  std::string                       _corrMount;
+  std::string                       _ionoMount;
+  unsigned                          _maxQueueSize;
+  int                               _numUsers;  // rovers sharing the channel
+};
+
+}
+
+#endif
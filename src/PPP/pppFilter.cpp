@@ -114,6 +114,92 @@ t_irc t_pppFilter::processEpoch(t_pppObsPool* obsPool) {
   return success;
 }
 
+// Kalman update with the algorithm selected in the options
+////////////////////////////////////////////////////////////////////////////
+static void filterUpdate(const Matrix& AA, const ColumnVector& ll, const DiagonalMatrix& PP,
+                         SymmetricMatrix& QQ, ColumnVector& xx) {
+  if (OPT->_seqFilterUpdate) {
+    kalmanSequential(AA, ll, PP, QQ, xx);
+  }
+  else {
+    kalman(AA, ll, PP, QQ, xx);
+  }
+}
+
+// Index of the largest residual exceeding its limit (-1 if none)
+////////////////////////////////////////////////////////////////////////////
+static int maxResidual(const ColumnVector& vv, const vector<t_pppSatObs*>& usedObs,
+                       const vector<t_lc::type>& usedTypes, double& maxOutlier) {
+  maxOutlier = 0.0;
+  int maxOutlierIndex = -1;
+  for (unsigned ii = 0; ii < usedObs.size(); ii++) {
+    const t_lc::type tLC = usedTypes[ii];
+    double res = fabs(vv[ii]);
+    if (res > usedObs[ii]->maxRes(tLC)) {
+      if (res > fabs(maxOutlier)) {
+        maxOutlier = vv[ii];
+        maxOutlierIndex = ii;
+      }
+    }
+  }
+  return maxOutlierIndex;
+}
+
+// Remove all observations of one satellite from the updated solution
+////////////////////////////////////////////////////////////////////////////
+static t_irc removeSatObs(const t_pppSatObs* obs, Matrix& AA, ColumnVector& ll,
+                          DiagonalMatrix& PP, vector<t_pppSatObs*>& usedObs,
+                          vector<t_lc::type>& usedTypes,
+                          SymmetricMatrix& QQ, ColumnVector& xx) {
+
+  int nObs = usedObs.size();
+  int nRem = 0;
+  for (int ii = 0; ii < nObs; ii++) {
+    if (usedObs[ii] == obs) {
+      ++nRem;
+    }
+  }
+  if (nRem == 0 || nRem == nObs) {
+    return failure;
+  }
+
+  int nPar = AA.Ncols();
+  Matrix         AArem(nRem, nPar),        AAnew(nObs-nRem, nPar);
+  ColumnVector   llrem(nRem),              llnew(nObs-nRem);
+  DiagonalMatrix PPrem(nRem),              PPnew(nObs-nRem);
+  vector<t_pppSatObs*> obsNew;
+  vector<t_lc::type>   typesNew;
+  int iRem = 0;
+  int iNew = 0;
+  for (int ii = 0; ii < nObs; ii++) {
+    if (usedObs[ii] == obs) {
+      AArem.Row(iRem+1) = AA.Row(ii+1);
+      llrem[iRem] = ll[ii];
+      PPrem[iRem] = PP[ii];
+      ++iRem;
+    }
+    else {
+      AAnew.Row(iNew+1) = AA.Row(ii+1);
+      llnew[iNew] = ll[ii];
+      PPnew[iNew] = PP[ii];
+      obsNew.push_back(usedObs[ii]);
+      typesNew.push_back(usedTypes[ii]);
+      ++iNew;
+    }
+  }
+
+  if (kalmanRemoveObs(AArem, llrem, PPrem, QQ, xx) != success) {
+    return failure;
+  }
+
+  AA = AAnew;
+  ll = llnew;
+  PP = PPnew;
+  usedObs   = obsNew;
+  usedTypes = typesNew;
+  return success;
+}
+
 // Process Selected LCs
 ////////////////////////////////////////////////////////////////////////////
 t_irc t_pppFilter::processSystem(const vector<t_lc::type> &LCs,
@@ -140,118 +226,133 @@ t_irc t_pppFilter::processSystem(const vector<t_lc::type> &LCs,
   // max Obs
   unsigned maxObs = obsVector.size() * usedLCs;
 
-  // Outlier Detection Loop
-  // ----------------------
-  for (unsigned iOutlier = 0; iOutlier < maxObs; iOutlier++) {
-
-    if (iOutlier > 0) {
-      _xFlt = xSav;
-      _QFlt = QSav;
-    }
+  // Outlier Detection Loop (outliers are removed by downdating the solution,
+  // the accepted solution is the full update with the remaining observations)
+  // --------------------------------------------------------------------------
+  Matrix               AA;
+  ColumnVector         ll;
+  DiagonalMatrix       PP;
+  vector<t_pppSatObs*> usedObs;
+  vector<t_lc::type>   usedTypes;
+  bool                 buildObs = true;
+  bool                 exact    = false;
 
-    // First-Design Matrix, Terms Observed-Computed, Weight Matrix
-    // -----------------------------------------------------------
-    Matrix AA(maxObs, nPar);   AA = 0.0;
-    ColumnVector ll(maxObs);   ll = 0.0;
-    DiagonalMatrix PP(maxObs); PP = 0.0;
+  for (unsigned iOutlier = 0; iOutlier < maxObs; iOutlier++) {
 
-    int iObs = -1;
-    vector<t_pppSatObs*> usedObs;
-    vector<t_lc::type> usedTypes;
+    if (buildObs) {
+      buildObs = false;
+      exact    = true;
 
-    // Real Observations
-    // =================
-    int nSat = 0;
-    for (unsigned ii = 0; ii < obsVector.size(); ii++) {
-      t_pppSatObs *obs = obsVector[ii];
-      if (iOutlier == 0) {
-        obs->resetOutlier();
+      if (iOutlier > 0) {
+        _xFlt = xSav;
+        _QFlt = QSav;
       }
-      if (!obs->outlier()) {
-        nSat++;
-        for (unsigned jj = 0; jj < usedLCs; jj++) {
-          const t_lc::type tLC = LCs[jj];
-          if (tLC == t_lc::GIM) {
-            continue;
-          }
-          ++iObs;
-          usedObs.push_back(obs);
-          usedTypes.push_back(tLC);
-          for (unsigned iPar = 0; iPar < nPar; iPar++) {
-            const t_pppParam *par = params[iPar];
-            AA[iObs][iPar] = par->partial(_epoTime, obs, tLC);
-          }
 
-          ll[iObs] = obs->obsValue(tLC) - obs->cmpValue(tLC) - DotProduct(_x0, AA.Row(iObs + 1));
-          PP[iObs] = 1.0 / (obs->sigma(tLC) * obs->sigma(tLC));
-        }
-      }
-    }
+      // First-Design Matrix, Terms Observed-Computed, Weight Matrix
+      // -----------------------------------------------------------
+      AA.ReSize(maxObs, nPar); AA = 0.0;
+      ll.ReSize(maxObs);       ll = 0.0;
+      PP.ReSize(maxObs);       PP = 0.0;
 
-    // Check number of observations
-    // ----------------------------
-    if (!nSat) {
-      return failure;
-    }
+      int iObs = -1;
+      usedObs.clear();
+      usedTypes.clear();
 
-    // Pseudo Obs Iono
-    // ================
-    if (OPT->_pseudoObsIono && pseudoObsIonoAvailable) {
+      // Real Observations
+      // =================
+      int nSat = 0;
       for (unsigned ii = 0; ii < obsVector.size(); ii++) {
         t_pppSatObs *obs = obsVector[ii];
+        if (iOutlier == 0) {
+          obs->resetOutlier();
+        }
         if (!obs->outlier()) {
+          nSat++;
           for (unsigned jj = 0; jj < usedLCs; jj++) {
             const t_lc::type tLC = LCs[jj];
             if (tLC == t_lc::GIM) {
-              ++iObs;
-            } else {
               continue;
             }
+            ++iObs;
             usedObs.push_back(obs);
             usedTypes.push_back(tLC);
             for (unsigned iPar = 0; iPar < nPar; iPar++) {
               const t_pppParam *par = params[iPar];
               AA[iObs][iPar] = par->partial(_epoTime, obs, tLC);
             }
+
             ll[iObs] = obs->obsValue(tLC) - obs->cmpValue(tLC) - DotProduct(_x0, AA.Row(iObs + 1));
             PP[iObs] = 1.0 / (obs->sigma(tLC) * obs->sigma(tLC));
           }
         }
       }
-    }
 
-    // Truncate matrices
-    // -----------------
-    AA = AA.Rows(1, iObs + 1);
-    ll = ll.Rows(1, iObs + 1);
-    PP = PP.SymSubMatrix(1, iObs + 1);
+      // Check number of observations
+      // ----------------------------
+      if (!nSat) {
+        return failure;
+      }
+
+      // Pseudo Obs Iono
+      // ================
+      if (OPT->_pseudoObsIono && pseudoObsIonoAvailable) {
+        for (unsigned ii = 0; ii < obsVector.size(); ii++) {
+          t_pppSatObs *obs = obsVector[ii];
+          if (!obs->outlier()) {
+            for (unsigned jj = 0; jj < usedLCs; jj++) {
+              const t_lc::type tLC = LCs[jj];
+              if (tLC == t_lc::GIM) {
+                ++iObs;
+              } else {
+                continue;
+              }
+              usedObs.push_back(obs);
+              usedTypes.push_back(tLC);
+              for (unsigned iPar = 0; iPar < nPar; iPar++) {
+                const t_pppParam *par = params[iPar];
+                AA[iObs][iPar] = par->partial(_epoTime, obs, tLC);
+              }
+              ll[iObs] = obs->obsValue(tLC) - obs->cmpValue(tLC) - DotProduct(_x0, AA.Row(iObs + 1));
+              PP[iObs] = 1.0 / (obs->sigma(tLC) * obs->sigma(tLC));
+            }
+          }
+        }
+      }
 
-    // Kalman update step
-    // ------------------
-    kalman(AA, ll, PP, _QFlt, _xFlt);
+      // Truncate matrices
+      // -----------------
+      AA = AA.Rows(1, iObs + 1);
+      ll = ll.Rows(1, iObs + 1);
+      PP = PP.SymSubMatrix(1, iObs + 1);
+
+      // Kalman update step
+      // ------------------
+      filterUpdate(AA, ll, PP, _QFlt, _xFlt);
+    }
 
     // Check Residuals
     // ---------------
     ColumnVector vv = AA * _xFlt - ll;
     double maxOutlier = 0.0;
-    int maxOutlierIndex = -1;
-    t_lc::type maxOutlierLC = t_lc::dummy;
-    for (unsigned ii = 0; ii < usedObs.size(); ii++) {
-      const t_lc::type tLC = usedTypes[ii];
-      double res = fabs(vv[ii]);
-      if (res > usedObs[ii]->maxRes(tLC)) {
-        if (res > fabs(maxOutlier)) {
-          maxOutlier = vv[ii];
-          maxOutlierIndex = ii;
-          maxOutlierLC = tLC;
-        }
-      }
+    int maxOutlierIndex = maxResidual(vv, usedObs, usedTypes, maxOutlier);
+
+    // Downdated solution passed or no iteration left, replace it by the
+    // full update
+    // ------------------------------------------------------------------
+    if (!exact && (maxOutlierIndex == -1 || iOutlier + 1 == maxObs)) {
+      exact = true;
+      _xFlt = xSav;
+      _QFlt = QSav;
+      filterUpdate(AA, ll, PP, _QFlt, _xFlt);
+      vv = AA * _xFlt - ll;
+      maxOutlierIndex = maxResidual(vv, usedObs, usedTypes, maxOutlier);
     }
 
     // Mark outlier or break outlier detection loop
     // --------------------------------------------
     if (maxOutlierIndex > -1) {
       t_pppSatObs *obs = usedObs[maxOutlierIndex];
+      t_lc::type maxOutlierLC = usedTypes[maxOutlierIndex];
       t_pppParam *par = 0;
       LOG << epoTimeStr << " Outlier " << t_lc::toString(maxOutlierLC) << ' '
           << obs->prn().toString() << ' ' << setw(8) << setprecision(4)
@@ -266,9 +367,18 @@ t_irc t_pppFilter::processSystem(const vector<t_lc::type> &LCs,
       }
       if (par) {
         resetAmb(obs->prn(), obsVector, maxOutlierLC, &QSav, &xSav);
+        buildObs = true;
       }
       else {
         obs->setOutlier();
+        // no downdate in the last iteration, the loop ends with the full update
+        if (iOutlier + 1 < maxObs &&
+            removeSatObs(obs, AA, ll, PP, usedObs, usedTypes, _QFlt, _xFlt) == success) {
+          exact = false;
+        }
+        else {
+          buildObs = true;
+        }
       }
     }
     // Print Residuals
@@ -42,55 +42,17 @@ t_pppObsPool::t_epoch::~t_epoch() {
 // Constructor
 /////////////////////////////////////////////////////////////////////////////
 t_pppObsPool::t_pppObsPool() {
-  for (unsigned ii = 0; ii <= t_prn::MAXPRN; ii++) {
-    _satCodeBiases[ii] = 0;
-  }
-  for (unsigned ii = 0; ii <= t_prn::MAXPRN; ii++) {
-    _satPhaseBiases[ii] = 0;
-  }
-  _vTec = 0;
 }
 
 // Destructor
 /////////////////////////////////////////////////////////////////////////////
 t_pppObsPool::~t_pppObsPool() {
-  for (unsigned ii = 0; ii <= t_prn::MAXPRN; ii++) {
-    delete _satCodeBiases[ii];
-  }
-  for (unsigned ii = 0; ii <= t_prn::MAXPRN; ii++) {
-    delete _satPhaseBiases[ii];
-  }
-  delete _vTec;
   while (_epochs.size() > 0) {
     delete _epochs.front();
     _epochs.pop_front();
   }
 }
 
-//
-/////////////////////////////////////////////////////////////////////////////
-void t_pppObsPool::putCodeBias(t_satCodeBias* satCodeBias) {
-  int iPrn = satCodeBias->_prn.toInt();
-  delete _satCodeBiases[iPrn];
-  _satCodeBiases[iPrn] = satCodeBias;
-}
-
-//
-/////////////////////////////////////////////////////////////////////////////
-void t_pppObsPool::putPhaseBias(t_satPhaseBias* satPhaseBias) {
-  int iPrn = satPhaseBias->_prn.toInt();
-  delete _satPhaseBiases[iPrn];
-  _satPhaseBiases[iPrn] = satPhaseBias;
-}
-
-//
-/////////////////////////////////////////////////////////////////////////////
-void t_pppObsPool::putTec(t_vTec* vTec) {
-  delete _vTec;
-  _vTec = new t_vTec(*vTec);
-  delete vTec;
-}
-
 //
 /////////////////////////////////////////////////////////////////////////////
 void t_pppObsPool::putEpoch(const bncTime& epoTime, vector<t_pppSatObs*>& obsVector,
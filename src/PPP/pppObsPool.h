@@ -29,21 +29,9 @@ class t_pppObsPool {
 
   t_pppObsPool();
   ~t_pppObsPool();
-  void putCodeBias(t_satCodeBias* satCodeBias);
-  void putPhaseBias(t_satPhaseBias* satPhaseBias);
-  void putTec(t_vTec* _vTec);
-
   void putEpoch(const bncTime& epoTime, std::vector<t_pppSatObs*>& obsVector,
                 bool pseudoObsIono);
 
-  const t_satCodeBias* satCodeBias(const t_prn& prn) const {
-    return _satCodeBiases[prn.toInt()];
-  }
-  const t_satPhaseBias* satPhaseBias(const t_prn& prn) const {
-    return _satPhaseBiases[prn.toInt()];
-  }
-  const t_vTec* vTec() const {return _vTec;}
-
   t_epoch* lastEpoch() {
     if (_epochs.size()) {
       return _epochs.back();
@@ -54,9 +42,6 @@ class t_pppObsPool {
   }
 
  private:
-  t_satCodeBias*           _satCodeBiases[t_prn::MAXPRN+1];
-  t_satPhaseBias*          _satPhaseBiases[t_prn::MAXPRN+1];
-  t_vTec*                  _vTec;
   std::deque<t_epoch*>     _epochs;
 };
 
@@ -22,7 +22,6 @@
 
 #include "pppSatObs.h"
 #include "bncconst.h"
-#include "pppEphPool.h"
 #include "pppStation.h"
 #include "bncutils.h"
 #include "bncantex.h"
@@ -103,7 +102,7 @@ void t_pppSatObs::prepareObs(const t_satObs& pppSatObs) {
         QString obsType = QString("%1").arg(frqNum) + preferredAttrib[iPref];  //cout << "obstype: " << obsType.toStdString().c_str() << endl;
         if (_obs[iFreq] == 0) {
           for (unsigned ii = 0; ii < pppSatObs._obs.size(); ii++) {
-            const t_frqObs* obs = pppSatObs._obs[ii];
+            const t_frqObs* obs = &pppSatObs._obs[ii];
             //cout << "observation2char: " << obs->_rnxType2ch << " vs. " << obsType.toStdString().c_str()<< endl;
             if (obs->_rnxType2ch == obsType.toStdString() &&
                 obs->_codeValid  && obs->_code &&
@@ -135,7 +134,7 @@ void t_pppSatObs::prepareObs(const t_satObs& pppSatObs) {
   // Find GLONASS Channel Number
   // ---------------------------
   if (_prn.system() == 'R') {
-    _channel = PPP_CLIENT->ephPool()->getChannel(_prn);
+    _channel = PPP_CLIENT->corr()->getChannel(_prn);
   }
   else {
     _channel = 0;
@@ -164,7 +163,7 @@ void t_pppSatObs::prepareObs(const t_satObs& pppSatObs) {
   double prange = obsValue(tLC);
   for (int ii = 1; ii <= 10; ii++) {
     bncTime ToT = _time - prange / t_CST::c - _xcSat[3];
-    if (PPP_CLIENT->ephPool()->getCrd(_prn, ToT, _xcSat, _vvSat) != success) {
+    if (PPP_CLIENT->corr()->getCrd(_prn, ToT, _xcSat, _vvSat) != success) {
       _valid = false;
       return;
     }
@@ -506,7 +505,7 @@ t_irc t_pppSatObs::cmpModel(const t_pppStation* station) {
 
   // Code Biases
   // -----------
-  const t_satCodeBias* satCodeBias = PPP_CLIENT->obsPool()->satCodeBias(_prn);
+  const t_satCodeBias* satCodeBias = PPP_CLIENT->corr()->satCodeBias(_prn);
   if (satCodeBias) {
     for (unsigned ii = 0; ii < satCodeBias->_bias.size(); ii++) {
       const t_frqCodeBias& bias = satCodeBias->_bias[ii];
@@ -526,7 +525,7 @@ t_irc t_pppSatObs::cmpModel(const t_pppStation* station) {
 
   // Phase Biases
   // -----------
-  const t_satPhaseBias* satPhaseBias = PPP_CLIENT->obsPool()->satPhaseBias(_prn);
+  const t_satPhaseBias* satPhaseBias = PPP_CLIENT->corr()->satPhaseBias(_prn);
   double yaw = 0.0;
   bool ssr = false;
   if (satPhaseBias) {
@@ -570,7 +569,7 @@ t_irc t_pppSatObs::cmpModel(const t_pppStation* station) {
 
   // Ionospheric Delay
   // -----------------
-  const t_vTec* vTec = PPP_CLIENT->obsPool()->vTec();
+  const t_vTec* vTec = PPP_CLIENT->corr()->vTec();
   bool vTecUsage = true;
   for (unsigned ii = 0; ii < OPT->LCs(_prn.system()).size(); ii++) {
     t_lc::type tLC = OPT->LCs(_prn.system())[ii];
@@ -77,7 +77,7 @@ t_pppClient::~t_pppClient() {
 
 //
 ////////////////////////////////////////////////////////////////////////////
-void t_pppClient::processEpoch(const vector<t_satObs*>& satObs, t_output* output) {
+void t_pppClient::processEpoch(const vector<const t_satObs*>& satObs, t_output* output) {
 
   // Convert and store observations
   // ------------------------------
@@ -105,7 +105,7 @@ void t_pppClient::processEpoch(const vector<t_satObs*>& satObs, t_output* output
     satData->L6       = 0.0;
     satData->L7       = 0.0;
     for (unsigned ifrq = 0; ifrq < obs->_obs.size(); ifrq++) {
-      t_frqObs* frqObs = obs->_obs[ifrq];
+      const t_frqObs* frqObs = &obs->_obs[ifrq];
       double cb = 0.0;
       const t_satCodeBias* satCB = _pppUtils->satCodeBias(prn);
       if (satCB && satCB->_bias.size()) {
@@ -42,7 +42,7 @@ class t_pppClient : public interface_pppClient {
  public:
   t_pppClient(const t_pppOptions* opt);
   ~t_pppClient();
-  void                processEpoch(const std::vector<t_satObs*>& satObs, t_output* output);
+  void                processEpoch(const std::vector<const t_satObs*>& satObs, t_output* output);
   void                putEphemeris(const t_eph* eph);
   void                putTec(const t_vTec* vTec);
   void                putOrbCorrections(const std::vector<t_orbCorr*>& corr);
@@ -147,28 +147,28 @@ t_irc RTCM2Decoder::Decode(char* buffer, int bufLen, vector<string>& errmsg) {
           obs._prn.set(sys, num, flag);
           obs._time.set(epochWeek, epochSecs);
 
-          t_frqObs* frqObs1C = new t_frqObs;
-          frqObs1C->_rnxType2ch = "1C";
-          frqObs1C->_codeValid = true;
-          frqObs1C->_code = _ObsBlock.rng_C1[iSat];
+          t_frqObs frqObs1C;
+          frqObs1C._rnxType2ch = "1C";
+          frqObs1C._codeValid = true;
+          frqObs1C._code = _ObsBlock.rng_C1[iSat];
           obs._obs.push_back(frqObs1C);
 
-          t_frqObs* frqObs1P = new t_frqObs;
-          frqObs1P->_rnxType2ch = (sys == 'G') ? "1W" : "1P";
-          frqObs1P->_codeValid = true;
-          frqObs1P->_code = _ObsBlock.rng_P1[iSat];
-          frqObs1P->_phaseValid = true;
-          frqObs1P->_phase = _ObsBlock.resolvedPhase_L1(iSat);
-          frqObs1P->_slipCounter = _ObsBlock.slip_L1[iSat];
+          t_frqObs frqObs1P;
+          frqObs1P._rnxType2ch = (sys == 'G') ? "1W" : "1P";
+          frqObs1P._codeValid = true;
+          frqObs1P._code = _ObsBlock.rng_P1[iSat];
+          frqObs1P._phaseValid = true;
+          frqObs1P._phase = _ObsBlock.resolvedPhase_L1(iSat);
+          frqObs1P._slipCounter = _ObsBlock.slip_L1[iSat];
           obs._obs.push_back(frqObs1P);
 
-          t_frqObs* frqObs2P = new t_frqObs;
-          frqObs2P->_rnxType2ch = (sys == 'G') ? "2W" : "2P";
-          frqObs2P->_codeValid = true;
-          frqObs2P->_code = _ObsBlock.rng_P2[iSat];
-          frqObs2P->_phaseValid = true;
-          frqObs2P->_phase = _ObsBlock.resolvedPhase_L2(iSat);
-          frqObs2P->_slipCounter = _ObsBlock.slip_L2[iSat];
+          t_frqObs frqObs2P;
+          frqObs2P._rnxType2ch = (sys == 'G') ? "2W" : "2P";
+          frqObs2P._codeValid = true;
+          frqObs2P._code = _ObsBlock.rng_P2[iSat];
+          frqObs2P._phaseValid = true;
+          frqObs2P._phase = _ObsBlock.resolvedPhase_L2(iSat);
+          frqObs2P._slipCounter = _ObsBlock.slip_L2[iSat];
           obs._obs.push_back(frqObs2P);
 
           _obsList.push_back(obs);
@@ -311,17 +311,19 @@ void RTCM2Decoder::translateCorr2Obs(vector<string>& errmsg) {
     // new observation
     t_satObs new_obs;
 
-    t_frqObs* frqObs1C = new t_frqObs;
-    frqObs1C->_rnxType2ch = "1C";
-    new_obs._obs.push_back(frqObs1C);
+    t_frqObs frqObs;
+    frqObs._rnxType2ch = "1C";
+    new_obs._obs.push_back(frqObs);
 
-    t_frqObs* frqObs1P = new t_frqObs;
-    frqObs1P->_rnxType2ch = (sys == 'G') ? "1W" : "1P";
-    new_obs._obs.push_back(frqObs1P);
+    frqObs._rnxType2ch = (sys == 'G') ? "1W" : "1P";
+    new_obs._obs.push_back(frqObs);
 
-    t_frqObs* frqObs2P = new t_frqObs;
-    frqObs2P->_rnxType2ch = (sys == 'G') ? "2W" : "2P";
-    new_obs._obs.push_back(frqObs2P);
+    frqObs._rnxType2ch = (sys == 'G') ? "2W" : "2P";
+    new_obs._obs.push_back(frqObs);
+
+    t_frqObs* frqObs1C = &new_obs._obs[0];
+    t_frqObs* frqObs1P = &new_obs._obs[1];
+    t_frqObs* frqObs2P = &new_obs._obs[2];
 
     // missing IOD
     vector<string> missingIOD;
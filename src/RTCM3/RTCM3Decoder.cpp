@@ -45,6 +45,7 @@
 #include <string.h>
 
 #include "bits.h"
+#include "bitReader.h"
 #include "gnss.h"
 #include "RTCM3Decoder.h"
 #include "rtcm_utils.h"
@@ -75,8 +76,6 @@ RTCM3Decoder::RTCM3Decoder(const QString& staID, bncRawFile* rawFile) :
   connect(this, SIGNAL(newGalileoEph(t_ephGal)), BNC_CORE, SLOT(slotNewGalileoEph(t_ephGal)));
   connect(this, SIGNAL(newSBASEph(t_ephSBAS)),   BNC_CORE, SLOT(slotNewSBASEph(t_ephSBAS)));
   connect(this, SIGNAL(newBDSEph(t_ephBDS)),     BNC_CORE, SLOT(slotNewBDSEph(t_ephBDS)));
-
-  _MessageSize = _SkipBytes = _BlockSize = _NeedBytes = 0;
 }
 
 // Destructor
@@ -141,71 +140,71 @@ bool RTCM3Decoder::DecodeRTCM3GPS(unsigned char* data, int size) {
     flag = t_corrSSR::getSsrNavTypeFlag(sys, num);
     CurrentObs._prn.set(sys, num, flag);
 
-    t_frqObs *frqObs = new t_frqObs;
+    t_frqObs frqObs;
     /* L1 */
     GETBITS(code, 1);
     (code) ?
-        frqObs->_rnxType2ch.assign("1W") : frqObs->_rnxType2ch.assign("1C");
+        frqObs._rnxType2ch.assign("1W") : frqObs._rnxType2ch.assign("1C");
     GETBITS(l1range, 24);
     GETBITSSIGN(i, 20);
     if ((i & ((1 << 20) - 1)) != 0x80000) {
-      frqObs->_code = l1range * 0.02;
-      frqObs->_phase = (l1range * 0.02 + i * 0.0005) / GPS_WAVELENGTH_L1;
-      frqObs->_codeValid = frqObs->_phaseValid = true;
+      frqObs._code = l1range * 0.02;
+      frqObs._phase = (l1range * 0.02 + i * 0.0005) / GPS_WAVELENGTH_L1;
+      frqObs._codeValid = frqObs._phaseValid = true;
     }
-    GETBITS(frqObs->_lockTimeIndicator, 7);
-    frqObs->_lockTime = lti2sec(type, frqObs->_lockTimeIndicator);
-    frqObs->_lockTimeValid = (frqObs->_lockTime >= 0.0 && frqObs->_phaseValid);
+    GETBITS(frqObs._lockTimeIndicator, 7);
+    frqObs._lockTime = lti2sec(type, frqObs._lockTimeIndicator);
+    frqObs._lockTimeValid = (frqObs._lockTime >= 0.0 && frqObs._phaseValid);
     if (type == 1002 || type == 1004) {
       GETBITS(amb, 8);
       if (amb) {
-        frqObs->_code += amb * 299792.458;
-        frqObs->_phase += (amb * 299792.458) / GPS_WAVELENGTH_L1;
+        frqObs._code += amb * 299792.458;
+        frqObs._phase += (amb * 299792.458) / GPS_WAVELENGTH_L1;
       }
       GETBITS(i, 8);
       if (i) {
-        frqObs->_snr = i * 0.25;
-        frqObs->_snrValid = true;
+        frqObs._snr = i * 0.25;
+        frqObs._snrValid = true;
       }
     }
     CurrentObs._obs.push_back(frqObs);
     if (type == 1003 || type == 1004) {
-      frqObs = new t_frqObs;
+      frqObs = t_frqObs();
       /* L2 */
       GETBITS(code, 2);
       switch (code) {
         case 3:
-          frqObs->_rnxType2ch.assign("2W"); /* or "2Y"? */
+          frqObs._rnxType2ch.assign("2W"); /* or "2Y"? */
           break;
         case 2:
-          frqObs->_rnxType2ch.assign("2W");
+          frqObs._rnxType2ch.assign("2W");
           break;
         case 1:
-          frqObs->_rnxType2ch.assign("2P");
+          frqObs._rnxType2ch.assign("2P");
           break;
         case 0:
-          frqObs->_rnxType2ch.assign("2X"); /* or "2S" or "2L"? */
+          frqObs._rnxType2ch.assign("2X"); /* or "2S" or "2L"? */
           break;
       }
       GETBITSSIGN(i, 14);
       if ((i & ((1 << 14) - 1)) != 0x2000) {
-        frqObs->_code = l1range * 0.02 + i * 0.02 + amb * 299792.458;
-        frqObs->_codeValid = true;
+        frqObs._code = l1range * 0.02 + i * 0.02 + amb * 299792.458;
+        frqObs._codeValid = true;
       }
       GETBITSSIGN(i, 20);
       if ((i & ((1 << 20) - 1)) != 0x80000) {
-        frqObs->_phase = (l1range * 0.02 + i * 0.0005 + amb * 299792.458)
+        frqObs._phase = (l1range * 0.02 + i * 0.0005 + amb * 299792.458)
             / GPS_WAVELENGTH_L2;
-        frqObs->_phaseValid = true;
+        frqObs._phaseValid = true;
       }
-      GETBITS(frqObs->_lockTimeIndicator, 7);
-      frqObs->_lockTime = lti2sec(type, frqObs->_lockTimeIndicator);
-      frqObs->_lockTimeValid = (frqObs->_lockTime >= 0.0 && frqObs->_phaseValid);
+      GETBITS(frqObs._lockTimeIndicator, 7);
+      frqObs._lockTime = lti2sec(type, frqObs._lockTimeIndicator);
+      frqObs._lockTimeValid = (frqObs._lockTime >= 0.0 && frqObs._phaseValid);
       if (type == 1004) {
         GETBITS(i, 8);
         if (i) {
-          frqObs->_snr = i * 0.25;
-          frqObs->_snrValid = true;
+          frqObs._snr = i * 0.25;
+          frqObs._snrValid = true;
         }
       }
       CurrentObs._obs.push_back(frqObs);
@@ -467,13 +466,13 @@ static struct CodeData irn[RTCM3_MSM_NUMSIG] = {
 bool RTCM3Decoder::DecodeRTCM3MSM(unsigned char* data, int size) {
   bool decoded = false;
   int type, syncf, i;
-  uint64_t numbits = 0, bitfield = 0;
 
   data += 3; /* header */
   size -= 6; /* header + crc */
+  t_bitReader bits(data, size);
 
-  GETBITS(type, 12)
-  SKIPBITS(12)
+  type = bits.getBits(12);
+  bits.skipBits(12);
   /* id */
   char sys;
   if      (type >= 1131 && type <= 1137) {
@@ -502,19 +501,22 @@ bool RTCM3Decoder::DecodeRTCM3MSM(unsigned char* data, int size) {
   }
   bncTime CurrentObsTime;
   if      (sys == 'C') /* BDS */ {
-    GETBITS(i, 30)
+    i = bits.getBits(30);
     CurrentObsTime.setBDS(i);
   }
   else if (sys == 'R') /* GLONASS */ {
-    SKIPBITS(3)
-    GETBITS(i, 27)
+    bits.skipBits(3);
+    i = bits.getBits(27);
     /* tk */
     CurrentObsTime.setTk(i);
   }
   else /* GPS style date */ {
-    GETBITS(i, 30)
+    i = bits.getBits(30);
     CurrentObsTime.set(i);
   }
+  if (!bits.ok()) {
+    return false;
+  }
   if (_CurrentTime.valid() && CurrentObsTime != _CurrentTime) {
     decoded = true;
     _obsList.append(_CurrentObsList);
@@ -522,7 +524,10 @@ bool RTCM3Decoder::DecodeRTCM3MSM(unsigned char* data, int size) {
   }
   _CurrentTime = CurrentObsTime;
 
-  GETBITS(syncf, 1)
+  syncf = bits.getBits(1);
+  if (!bits.ok()) {
+    return false;
+  }
   /**
    * Ignore unknown types except for sync flag
    *
@@ -545,20 +550,20 @@ bool RTCM3Decoder::DecodeRTCM3MSM(unsigned char* data, int size) {
     double psr[RTCM3_MSM_NUMCELLS]; // fine psr
     double dop[RTCM3_MSM_NUMCELLS]; // fine phase range rates
 
-    SKIPBITS(3 + 7 + 2 + 2 + 1 + 3)
-    GETBITS64(satmask, RTCM3_MSM_NUMSAT)
+    bits.skipBits(3 + 7 + 2 + 2 + 1 + 3);
+    satmask = bits.getBits(RTCM3_MSM_NUMSAT);
 
     /* http://gurmeetsingh.wordpress.com/2008/08/05/fast-bit-counting-routines/ */
     for (ui = satmask; ui; ui &= (ui - 1) /* remove rightmost bit */)
       ++numsat;
-    GETBITS(sigmask, RTCM3_MSM_NUMSIG)
+    sigmask = bits.getBits(RTCM3_MSM_NUMSIG);
     for (i = sigmask; i; i &= (i - 1) /* remove rightmost bit */)
       ++numsig;
     for (i = 0; i < RTCM3_MSM_NUMSAT; ++i)
       extsat[i] = 15;
 
     i = numsat * numsig;
-    GETBITS64(cellmask, (unsigned )i)
+    cellmask = bits.getBits((unsigned )i);
     // satellite data
     switch (type % 10) {
       case 1:
@@ -566,27 +571,30 @@ bool RTCM3Decoder::DecodeRTCM3MSM(unsigned char* data, int size) {
       case 3:
         /* partial data, already skipped above, but implemented for future expansion ! */
         for (int j = numsat; j--;)
-          GETFLOAT(rrmod[j], 10, 1.0 / 1024.0)
+          rrmod[j] = bits.getFloat(10, 1.0 / 1024.0);
         break;
       case 4:
       case 6:
         for (int j = numsat; j--;)
-          GETBITS(rrint[j], 8)
+          rrint[j] = bits.getBits(8);
         for (int j = numsat; j--;)
-          GETFLOAT(rrmod[j], 10, 1.0 / 1024.0)
+          rrmod[j] = bits.getFloat(10, 1.0 / 1024.0);
         break;
       case 5:
       case 7:
         for (int j = numsat; j--;)
-          GETBITS(rrint[j], 8)
+          rrint[j] = bits.getBits(8);
         for (int j = numsat; j--;)
-          GETBITS(extsat[j], 4)
+          extsat[j] = bits.getBits(4);
         for (int j = numsat; j--;)
-          GETFLOAT(rrmod[j], 10, 1.0 / 1024.0)
+          rrmod[j] = bits.getFloat(10, 1.0 / 1024.0);
         for (int j = numsat; j--;)
-          GETBITSSIGN(rdop[j], 14)
+          rdop[j] = bits.getBitsSign(14);
         break;
     }
+    if (!bits.ok()) {
+      return false;
+    }
     // signal data
     int numcells = numsat * numsig;
     /** Drop anything which exceeds our cell limit. Increase limit definition
@@ -594,110 +602,53 @@ bool RTCM3Decoder::DecodeRTCM3MSM(unsigned char* data, int size) {
     if (numcells <= RTCM3_MSM_NUMCELLS) {
       switch (type % 10) {
         case 1:
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETFLOATSIGN(psr[count], 15, 1.0 / (1 << 24))
+          bits.getCellsFloatSign(psr, 15, 1.0 / (1 << 24), cellmask, numcells);
           break;
         case 2:
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETFLOATSIGN(cp[count], 22, 1.0 / (1 << 29))
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETBITS(ll[count], 4)
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              SKIPBITS(1)/*GETBITS(hc[count], 1)*/
+          bits.getCellsFloatSign(cp, 22, 1.0 / (1 << 29), cellmask, numcells);
+          bits.getCells(ll, 4, cellmask, numcells);
+          bits.skipCells(1, cellmask); /*GETBITS(hc[count], 1)*/
           break;
         case 3:
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETFLOATSIGN(psr[count], 15, 1.0 / (1 << 24))
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETFLOATSIGN(cp[count], 22, 1.0 / (1 << 29))
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETBITS(ll[count], 4)
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              SKIPBITS(1)/*GETBITS(hc[count], 1)*/
+          bits.getCellsFloatSign(psr, 15, 1.0 / (1 << 24), cellmask, numcells);
+          bits.getCellsFloatSign(cp, 22, 1.0 / (1 << 29), cellmask, numcells);
+          bits.getCells(ll, 4, cellmask, numcells);
+          bits.skipCells(1, cellmask); /*GETBITS(hc[count], 1)*/
           break;
         case 4:
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETFLOATSIGN(psr[count], 15, 1.0 / (1 << 24))
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETFLOATSIGN(cp[count], 22, 1.0 / (1 << 29))
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETBITS(ll[count], 4)
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              SKIPBITS(1)/*GETBITS(hc[count], 1)*/
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETBITS(cnr[count], 6)
+          bits.getCellsFloatSign(psr, 15, 1.0 / (1 << 24), cellmask, numcells);
+          bits.getCellsFloatSign(cp, 22, 1.0 / (1 << 29), cellmask, numcells);
+          bits.getCells(ll, 4, cellmask, numcells);
+          bits.skipCells(1, cellmask); /*GETBITS(hc[count], 1)*/
+          bits.getCells(cnr, 6, cellmask, numcells);
           break;
         case 5:
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETFLOATSIGN(psr[count], 15, 1.0 / (1 << 24))
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETFLOATSIGN(cp[count], 22, 1.0 / (1 << 29))
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETBITS(ll[count], 4)
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              SKIPBITS(1)/*GETBITS(hc[count], 1)*/
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETFLOAT(cnr[count], 6, 1.0)
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETFLOATSIGN(dop[count], 15, 0.0001)
+          bits.getCellsFloatSign(psr, 15, 1.0 / (1 << 24), cellmask, numcells);
+          bits.getCellsFloatSign(cp, 22, 1.0 / (1 << 29), cellmask, numcells);
+          bits.getCells(ll, 4, cellmask, numcells);
+          bits.skipCells(1, cellmask); /*GETBITS(hc[count], 1)*/
+          bits.getCellsFloat(cnr, 6, 1.0, cellmask, numcells);
+          bits.getCellsFloatSign(dop, 15, 0.0001, cellmask, numcells);
           break;
         case 6:
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETFLOATSIGN(psr[count], 20, 1.0 / (1 << 29))
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETFLOATSIGN(cp[count], 24, 1.0 / (1U << 31))
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETBITS(ll[count], 10)
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              SKIPBITS(1)/*GETBITS(hc[count], 1)*/
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETFLOAT(cnr[count], 10, 1.0 / (1 << 4))
+          bits.getCellsFloatSign(psr, 20, 1.0 / (1 << 29), cellmask, numcells);
+          bits.getCellsFloatSign(cp, 24, 1.0 / (1U << 31), cellmask, numcells);
+          bits.getCells(ll, 10, cellmask, numcells);
+          bits.skipCells(1, cellmask); /*GETBITS(hc[count], 1)*/
+          bits.getCellsFloat(cnr, 10, 1.0 / (1 << 4), cellmask, numcells);
           break;
         case 7:
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETFLOATSIGN(psr[count], 20, 1.0 / (1 << 29))
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETFLOATSIGN(cp[count], 24, 1.0 / (1U << 31))
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETBITS(ll[count], 10)
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              SKIPBITS(1)/*GETBITS(hc[count], 1)*/
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETFLOAT(cnr[count], 10, 1.0 / (1 << 4))
-          for (int count = numcells; count--;)
-            if (cellmask & (UINT64(1) << count))
-              GETFLOATSIGN(dop[count], 15, 0.0001)
+          bits.getCellsFloatSign(psr, 20, 1.0 / (1 << 29), cellmask, numcells);
+          bits.getCellsFloatSign(cp, 24, 1.0 / (1U << 31), cellmask, numcells);
+          bits.getCells(ll, 10, cellmask, numcells);
+          bits.skipCells(1, cellmask); /*GETBITS(hc[count], 1)*/
+          bits.getCellsFloat(cnr, 10, 1.0 / (1 << 4), cellmask, numcells);
+          bits.getCellsFloatSign(dop, 15, 0.0001, cellmask, numcells);
           break;
       }
+      if (!bits.ok()) {
+        return false;
+      }
       i = RTCM3_MSM_NUMSAT;
       int j = -1;
       t_satObs CurrentObs;
@@ -768,119 +719,119 @@ bool RTCM3Decoder::DecodeRTCM3MSM(unsigned char* data, int size) {
               break;
           }
           if (cd.code) {
-            t_frqObs *frqObs = new t_frqObs;
-            frqObs->_rnxType2ch.assign(cd.code);
+            t_frqObs frqObs;
+            frqObs._rnxType2ch.assign(cd.code);
 
             switch (type % 10) {
               case 1:
                 if (psr[count] > -1.0 / (1 << 10)) {
-                  frqObs->_code = psr[count] * LIGHTSPEED / 1000.0
-                                + (rrmod[numsat]) * LIGHTSPEED / 1000.0;
-                  frqObs->_codeValid = true;
+                  frqObs._code = psr[count] * LIGHTSPEED / 1000.0
+                               + (rrmod[numsat]) * LIGHTSPEED / 1000.0;
+                  frqObs._codeValid = true;
                 }
                 break;
               case 2:
                 if (cp[count] > -1.0 / (1 << 8)) {
-                  frqObs->_phase = cp[count] * LIGHTSPEED / 1000.0 / cd.wl
-                                 + (rrmod[numsat]) * LIGHTSPEED / 1000.0 / cd.wl;
-                  frqObs->_phaseValid = true;
-                  frqObs->_lockTime = lti2sec(type,ll[count]);
-                  frqObs->_lockTimeValid = (frqObs->_lockTime >= 0.0);
-                  frqObs->_lockTimeIndicator = ll[count];
+                  frqObs._phase = cp[count] * LIGHTSPEED / 1000.0 / cd.wl
+                                + (rrmod[numsat]) * LIGHTSPEED / 1000.0 / cd.wl;
+                  frqObs._phaseValid = true;
+                  frqObs._lockTime = lti2sec(type,ll[count]);
+                  frqObs._lockTimeValid = (frqObs._lockTime >= 0.0);
+                  frqObs._lockTimeIndicator = ll[count];
                 }
                 break;
               case 3:
                 if (psr[count] > -1.0 / (1 << 10)) {
-                  frqObs->_code = psr[count] * LIGHTSPEED / 1000.0
-                                + (rrmod[numsat]) * LIGHTSPEED / 1000.0;
-                  frqObs->_codeValid = true;
+                  frqObs._code = psr[count] * LIGHTSPEED / 1000.0
+                               + (rrmod[numsat]) * LIGHTSPEED / 1000.0;
+                  frqObs._codeValid = true;
                 }
                 if (cp[count] > -1.0 / (1 << 8)) {
-                  frqObs->_phase = cp[count] * LIGHTSPEED / 1000.0 / cd.wl
-                                 + rrmod[numsat] * LIGHTSPEED / 1000.0 / cd.wl;
-                  frqObs->_phaseValid = true;
-                  frqObs->_lockTime = lti2sec(type,ll[count]);
-                  frqObs->_lockTimeValid = (frqObs->_lockTime >= 0.0);
-                  frqObs->_lockTimeIndicator = ll[count];
+                  frqObs._phase = cp[count] * LIGHTSPEED / 1000.0 / cd.wl
+                                + rrmod[numsat] * LIGHTSPEED / 1000.0 / cd.wl;
+                  frqObs._phaseValid = true;
+                  frqObs._lockTime = lti2sec(type,ll[count]);
+                  frqObs._lockTimeValid = (frqObs._lockTime >= 0.0);
+                  frqObs._lockTimeIndicator = ll[count];
                 }
                 break;
               case 4:
                 if (psr[count] > -1.0 / (1 << 10)) {
-                  frqObs->_code = psr[count] * LIGHTSPEED / 1000.0
-                                + (rrmod[numsat] +  rrint[numsat]) * LIGHTSPEED / 1000.0;
-                  frqObs->_codeValid = true;
+                  frqObs._code = psr[count] * LIGHTSPEED / 1000.0
+                               + (rrmod[numsat] +  rrint[numsat]) * LIGHTSPEED / 1000.0;
+                  frqObs._codeValid = true;
                 }
                 if (cp[count] > -1.0 / (1 << 8)) {
-                  frqObs->_phase = cp[count] * LIGHTSPEED / 1000.0 / cd.wl
-                                 + (rrmod[numsat] +  rrint[numsat]) * LIGHTSPEED / 1000.0 / cd.wl;
-                  frqObs->_phaseValid = true;
-                  frqObs->_lockTime = lti2sec(type,ll[count]);
-                  frqObs->_lockTimeValid = (frqObs->_lockTime >= 0.0);
-                  frqObs->_lockTimeIndicator = ll[count];
+                  frqObs._phase = cp[count] * LIGHTSPEED / 1000.0 / cd.wl
+                                + (rrmod[numsat] +  rrint[numsat]) * LIGHTSPEED / 1000.0 / cd.wl;
+                  frqObs._phaseValid = true;
+                  frqObs._lockTime = lti2sec(type,ll[count]);
+                  frqObs._lockTimeValid = (frqObs._lockTime >= 0.0);
+                  frqObs._lockTimeIndicator = ll[count];
                 }
-                frqObs->_snr = cnr[count];
-                frqObs->_snrValid = true;
+                frqObs._snr = cnr[count];
+                frqObs._snrValid = true;
                 break;
               case 5:
                 if (psr[count] > -1.0 / (1 << 10)) {
-                  frqObs->_code = psr[count] * LIGHTSPEED / 1000.0
-                                + (rrmod[numsat] + rrint[numsat]) * LIGHTSPEED / 1000.0;
-                  frqObs->_codeValid = true;
+                  frqObs._code = psr[count] * LIGHTSPEED / 1000.0
+                               + (rrmod[numsat] + rrint[numsat]) * LIGHTSPEED / 1000.0;
+                  frqObs._codeValid = true;
                 }
                 if (cp[count] > -1.0 / (1 << 8)) {
-                  frqObs->_phase = cp[count] * LIGHTSPEED / 1000.0 / cd.wl
-                                 + (rrmod[numsat] + rrint[numsat]) * LIGHTSPEED / 1000.0 / cd.wl;
-                  frqObs->_phaseValid = true;
-                  frqObs->_lockTime = lti2sec(type,ll[count]);
-                  frqObs->_lockTimeValid = (frqObs->_lockTime >= 0.0);
-                  frqObs->_lockTimeIndicator = ll[count];
+                  frqObs._phase = cp[count] * LIGHTSPEED / 1000.0 / cd.wl
+                                + (rrmod[numsat] + rrint[numsat]) * LIGHTSPEED / 1000.0 / cd.wl;
+                  frqObs._phaseValid = true;
+                  frqObs._lockTime = lti2sec(type,ll[count]);
+                  frqObs._lockTimeValid = (frqObs._lockTime >= 0.0);
+                  frqObs._lockTimeIndicator = ll[count];
                 }
-                frqObs->_snr = cnr[count];
-                frqObs->_snrValid = true;
+                frqObs._snr = cnr[count];
+                frqObs._snrValid = true;
                 if (dop[count] > -1.6384) {
-                  frqObs->_doppler = -(dop[count] + rdop[numsat]) / cd.wl;
-                  frqObs->_dopplerValid = true;
+                  frqObs._doppler = -(dop[count] + rdop[numsat]) / cd.wl;
+                  frqObs._dopplerValid = true;
                 }
                 break;
               case 6:
                 if (psr[count] > -1.0 / (1 << 10)) {
-                  frqObs->_code = psr[count] * LIGHTSPEED / 1000.0
-                                + (rrmod[numsat] + rrint[numsat]) * LIGHTSPEED / 1000.0;
-                  frqObs->_codeValid = true;
+                  frqObs._code = psr[count] * LIGHTSPEED / 1000.0
+                               + (rrmod[numsat] + rrint[numsat]) * LIGHTSPEED / 1000.0;
+                  frqObs._codeValid = true;
                 }
                 if (cp[count] > -1.0 / (1 << 8)) {
-                  frqObs->_phase = cp[count] * LIGHTSPEED / 1000.0 / cd.wl
-                                 + (rrmod[numsat] + rrint[numsat]) * LIGHTSPEED / 1000.0 / cd.wl;
-                  frqObs->_phaseValid = true;
-                  frqObs->_lockTime = lti2sec(type,ll[count]);
-                  frqObs->_lockTimeValid = (frqObs->_lockTime >= 0.0);
-                  frqObs->_lockTimeIndicator = ll[count];
+                  frqObs._phase = cp[count] * LIGHTSPEED / 1000.0 / cd.wl
+                                + (rrmod[numsat] + rrint[numsat]) * LIGHTSPEED / 1000.0 / cd.wl;
+                  frqObs._phaseValid = true;
+                  frqObs._lockTime = lti2sec(type,ll[count]);
+                  frqObs._lockTimeValid = (frqObs._lockTime >= 0.0);
+                  frqObs._lockTimeIndicator = ll[count];
                 }
 
-                frqObs->_snr = cnr[count];
-                frqObs->_snrValid = true;
+                frqObs._snr = cnr[count];
+                frqObs._snrValid = true;
                 break;
               case 7:
                 if (psr[count] > -1.0 / (1 << 10)) {
-                  frqObs->_code = psr[count] * LIGHTSPEED / 1000.0
-                                + (rrmod[numsat] + rrint[numsat]) * LIGHTSPEED / 1000.0;
-                  frqObs->_codeValid = true;
+                  frqObs._code = psr[count] * LIGHTSPEED / 1000.0
+                               + (rrmod[numsat] + rrint[numsat]) * LIGHTSPEED / 1000.0;
+                  frqObs._codeValid = true;
                 }
                 if (cp[count] > -1.0 / (1 << 8)) {
-                  frqObs->_phase = cp[count] * LIGHTSPEED / 1000.0 / cd.wl
-                                 + (rrmod[numsat] + rrint[numsat]) * LIGHTSPEED / 1000.0 / cd.wl;
-                  frqObs->_phaseValid = true;
-                  frqObs->_lockTime = lti2sec(type,ll[count]);
-                  frqObs->_lockTimeValid = (frqObs->_lockTime >= 0.0);
-                  frqObs->_lockTimeIndicator = ll[count];
+                  frqObs._phase = cp[count] * LIGHTSPEED / 1000.0 / cd.wl
+                                + (rrmod[numsat] + rrint[numsat]) * LIGHTSPEED / 1000.0 / cd.wl;
+                  frqObs._phaseValid = true;
+                  frqObs._lockTime = lti2sec(type,ll[count]);
+                  frqObs._lockTimeValid = (frqObs._lockTime >= 0.0);
+                  frqObs._lockTimeIndicator = ll[count];
                 }
 
-                frqObs->_snr = cnr[count];
-                frqObs->_snrValid = true;
+                frqObs._snr = cnr[count];
+                frqObs._snrValid = true;
 
                 if (dop[count] > -1.6384) {
-                  frqObs->_doppler = -(dop[count] + rdop[numsat]) / cd.wl;
-                  frqObs->_dopplerValid = true;
+                  frqObs._doppler = -(dop[count] + rdop[numsat]) / cd.wl;
+                  frqObs._dopplerValid = true;
                 }
                 break;
             }
@@ -957,70 +908,70 @@ bool RTCM3Decoder::DecodeRTCM3GLONASS(unsigned char* data, int size) {
     GETBITS(freq, 5)
     GLOFreq[sv - 1] = 100 + freq - 7; /* store frequency for other users (MSM) */
 
-    t_frqObs *frqObs = new t_frqObs;
+    t_frqObs frqObs;
     /* L1 */
     (code) ?
-        frqObs->_rnxType2ch.assign("1P") : frqObs->_rnxType2ch.assign("1C");
+        frqObs._rnxType2ch.assign("1P") : frqObs._rnxType2ch.assign("1C");
     GETBITS(l1range, 25);
     GETBITSSIGN(i, 20);
     if ((i & ((1 << 20) - 1)) != 0x80000) {
-      frqObs->_code = l1range * 0.02;
-      frqObs->_phase = (l1range * 0.02 + i * 0.0005) / GLO_WAVELENGTH_L1(freq - 7);
-      frqObs->_codeValid = frqObs->_phaseValid = true;
+      frqObs._code = l1range * 0.02;
+      frqObs._phase = (l1range * 0.02 + i * 0.0005) / GLO_WAVELENGTH_L1(freq - 7);
+      frqObs._codeValid = frqObs._phaseValid = true;
     }
-    GETBITS(frqObs->_lockTimeIndicator, 7);
-    frqObs->_lockTime = lti2sec(type, frqObs->_lockTimeIndicator);
-    frqObs->_lockTimeValid = (frqObs->_lockTime >= 0.0 && frqObs->_phaseValid);
+    GETBITS(frqObs._lockTimeIndicator, 7);
+    frqObs._lockTime = lti2sec(type, frqObs._lockTimeIndicator);
+    frqObs._lockTimeValid = (frqObs._lockTime >= 0.0 && frqObs._phaseValid);
     if (type == 1010 || type == 1012) {
       GETBITS(amb, 7);
       if (amb) {
-        frqObs->_code += amb * 599584.916;
-        frqObs->_phase += (amb * 599584.916) / GLO_WAVELENGTH_L1(freq - 7);
+        frqObs._code += amb * 599584.916;
+        frqObs._phase += (amb * 599584.916) / GLO_WAVELENGTH_L1(freq - 7);
       }
       GETBITS(i, 8);
       if (i) {
-        frqObs->_snr = i * 0.25;
-        frqObs->_snrValid = true;
+        frqObs._snr = i * 0.25;
+        frqObs._snrValid = true;
       }
     }
     CurrentObs._obs.push_back(frqObs);
     if (type == 1011 || type == 1012) {
-      frqObs = new t_frqObs;
+      frqObs = t_frqObs();
       /* L2 */
       GETBITS(code, 2);
       switch (code) {
         case 3:
-          frqObs->_rnxType2ch.assign("2P");
+          frqObs._rnxType2ch.assign("2P");
           break;
         case 2:
-          frqObs->_rnxType2ch.assign("2P");
+          frqObs._rnxType2ch.assign("2P");
           break;
         case 1:
-          frqObs->_rnxType2ch.assign("2P");
+          frqObs._rnxType2ch.assign("2P");
           break;
         case 0:
-          frqObs->_rnxType2ch.assign("2C");
+          frqObs._rnxType2ch.assign("2C");
           break;
       }
       GETBITSSIGN(i, 14);
       if ((i & ((1 << 14) - 1)) != 0x2000) {
-        frqObs->_code = l1range * 0.02 + i * 0.02 + amb * 599584.916;
-        frqObs->_codeValid = true;
+        frqObs._code = l1range * 0.02 + i * 0.02 + amb * 599584.916;
+        frqObs._codeValid = true;
       }
       GETBITSSIGN(i, 20);
       if ((i & ((1 << 20) - 1)) != 0x80000) {
-        frqObs->_phase = (l1range * 0.02 + i * 0.0005 + amb * 599584.916)
+        frqObs._phase = (l1range * 0.02 + i * 0.0005 + amb * 599584.916)
             / GLO_WAVELENGTH_L2(freq - 7);
-        frqObs->_phaseValid = true;
+        frqObs._phaseValid = true;
       }
-      GETBITS(frqObs->_lockTimeIndicator, 7);
-      frqObs->_lockTime = lti2sec(type, frqObs->_lockTimeIndicator);
-      frqObs->_lockTimeValid = (frqObs->_lockTime >= 0.0 && frqObs->_phaseValid);
+      GETBITS(frqObs._lockTimeIndicator, 7);
+      frqObs._lockTime = lti2sec(type, frqObs._lockTimeIndicator);
+      frqObs._lockTimeValid = (frqObs._lockTime >= 0.0 && frqObs._phaseValid);
       if (type == 1012) {
         GETBITS(i, 8);
         if (i) {
-          frqObs->_snr = i * 0.25;
-          frqObs->_snrValid = true;
+          frqObs._snr = i * 0.25;
+          frqObs._snrValid = true;
         }
       }
       CurrentObs._obs.push_back(frqObs);
@@ -1044,17 +995,17 @@ bool RTCM3Decoder::DecodeGPSEphemeris(unsigned char* data, int size) {
   if (size == 67) {
     t_ephGPS eph;
     int i, week;
-    uint64_t numbits = 0, bitfield = 0;
     int fitIntervalFalg = 0;
 
     data += 3; /* header */
     size -= 6; /* header + crc */
-    SKIPBITS(12)
+    t_bitReader bits(data, size);
+    bits.skipBits(12);
 
     eph._receptDateTime = currentDateAndTimeGPS();
     eph._receptStaID = _staID;
 
-    GETBITS(i, 6)
+    i = bits.getBits(6);
     if (i < 1 || i > 63 ) {
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (G) PRN# is out of range: %3!")
@@ -1065,7 +1016,7 @@ bool RTCM3Decoder::DecodeGPSEphemeris(unsigned char* data, int size) {
       return false;
     }
     eph._prn.set('G', i);
-    GETBITS(week, 10)
+    week = bits.getBits(10);
     if (week < 0 || week > 1023) {
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (%3) WEEK # is out of range: %4!")
@@ -1076,12 +1027,12 @@ bool RTCM3Decoder::DecodeGPSEphemeris(unsigned char* data, int size) {
 #endif
       return false;
     }
-    GETBITS(i, 4)
+    i = bits.getBits(4);
     eph._ura = accuracyFromIndex(i, eph.system());
-    GETBITS(eph._L2Codes, 2)
-    GETFLOATSIGN(eph._IDOT, 14, R2R_PI/(double)(1<<30)/(double)(1<<13))
-    GETBITS(eph._IODE, 8)
-    GETBITS(i, 16)
+    eph._L2Codes = bits.getBits(2);
+    eph._IDOT = bits.getFloatSign(14, R2R_PI/(double)(1<<30)/(double)(1<<13));
+    eph._IODE = bits.getBits(8);
+    i = bits.getBits(16);
     i <<= 4;
     if (i < 0 || i > 604784) {
 #ifdef BNC_DEBUG_BCE
@@ -1094,17 +1045,17 @@ bool RTCM3Decoder::DecodeGPSEphemeris(unsigned char* data, int size) {
       return false;
     }
     eph._TOC.set(i * 1000);
-    GETFLOATSIGN(eph._clock_driftrate, 8, 1.0 / (double )(1 << 30) / (double )(1 << 25))
-    GETFLOATSIGN(eph._clock_drift,    16, 1.0 / (double )(1 << 30) / (double )(1 << 13))
-    GETFLOATSIGN(eph._clock_bias,     22, 1.0 / (double )(1 << 30) / (double )(1 << 1))
-    GETBITS(eph._IODC, 10)
-    GETFLOATSIGN(eph._Crs,            16, 1.0 / (double )(1 << 5))
-    GETFLOATSIGN(eph._Delta_n,        16, R2R_PI/(double)(1<<30)/(double)(1<<13))
-    GETFLOATSIGN(eph._M0,             32, R2R_PI/(double)(1<<30)/(double)(1<<1))
-    GETFLOATSIGN(eph._Cuc,            16, 1.0 / (double )(1 << 29))
-    GETFLOAT(eph._e,                  32, 1.0 / (double )(1 << 30) / (double )(1 << 3))
-    GETFLOATSIGN(eph._Cus,            16, 1.0 / (double )(1 << 29))
-    GETFLOAT(eph._sqrt_A,             32, 1.0 / (double )(1 << 19))
+    eph._clock_driftrate = bits.getFloatSign(8, 1.0 / (double )(1 << 30) / (double )(1 << 25));
+    eph._clock_drift = bits.getFloatSign(16, 1.0 / (double )(1 << 30) / (double )(1 << 13));
+    eph._clock_bias = bits.getFloatSign(22, 1.0 / (double )(1 << 30) / (double )(1 << 1));
+    eph._IODC = bits.getBits(10);
+    eph._Crs = bits.getFloatSign(16, 1.0 / (double )(1 << 5));
+    eph._Delta_n = bits.getFloatSign(16, R2R_PI/(double)(1<<30)/(double)(1<<13));
+    eph._M0 = bits.getFloatSign(32, R2R_PI/(double)(1<<30)/(double)(1<<1));
+    eph._Cuc = bits.getFloatSign(16, 1.0 / (double )(1 << 29));
+    eph._e = bits.getFloat(32, 1.0 / (double )(1 << 30) / (double )(1 << 3));
+    eph._Cus = bits.getFloatSign(16, 1.0 / (double )(1 << 29));
+    eph._sqrt_A = bits.getFloat(32, 1.0 / (double )(1 << 19));
     if (eph._sqrt_A < 1000.0) {
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (%3) SQRT_A %4 m!")
@@ -1113,7 +1064,7 @@ bool RTCM3Decoder::DecodeGPSEphemeris(unsigned char* data, int size) {
 #endif
       return false;
     }
-    GETBITS(i, 16)
+    i = bits.getBits(16);
     i <<= 4;
     if (i < 0 || i > 604784) {
 #ifdef BNC_DEBUG_BCE
@@ -1134,22 +1085,25 @@ bool RTCM3Decoder::DecodeGPSEphemeris(unsigned char* data, int size) {
     /* week from HOW, differs from TOC, TOE week, we use adapted value instead */
     if (eph._TOEweek > week + 1 || eph._TOEweek < week - 1) /* invalid week */
       return false;
-    GETFLOATSIGN(eph._Cic,      16, 1.0 / (double )(1 << 29))
-    GETFLOATSIGN(eph._OMEGA0,   32, R2R_PI/(double)(1<<30)/(double)(1<<1))
-    GETFLOATSIGN(eph._Cis,      16, 1.0 / (double )(1 << 29))
-    GETFLOATSIGN(eph._i0,       32, R2R_PI/(double)(1<<30)/(double)(1<<1))
-    GETFLOATSIGN(eph._Crc,      16, 1.0 / (double )(1 << 5))
-    GETFLOATSIGN(eph._omega,    32, R2R_PI/(double)(1<<30)/(double)(1<<1))
-    GETFLOATSIGN(eph._OMEGADOT, 24, R2R_PI/(double)(1<<30)/(double)(1<<13))
-    GETFLOATSIGN(eph._TGD,       8, 1.0 / (double )(1 << 30) / (double )(1 << 1))
-    GETBITS(eph._health, 6)
-    GETBITS(eph._L2PFlag, 1)
-    GETBITS(fitIntervalFalg, 1)
+    eph._Cic = bits.getFloatSign(16, 1.0 / (double )(1 << 29));
+    eph._OMEGA0 = bits.getFloatSign(32, R2R_PI/(double)(1<<30)/(double)(1<<1));
+    eph._Cis = bits.getFloatSign(16, 1.0 / (double )(1 << 29));
+    eph._i0 = bits.getFloatSign(32, R2R_PI/(double)(1<<30)/(double)(1<<1));
+    eph._Crc = bits.getFloatSign(16, 1.0 / (double )(1 << 5));
+    eph._omega = bits.getFloatSign(32, R2R_PI/(double)(1<<30)/(double)(1<<1));
+    eph._OMEGADOT = bits.getFloatSign(24, R2R_PI/(double)(1<<30)/(double)(1<<13));
+    eph._TGD = bits.getFloatSign(8, 1.0 / (double )(1 << 30) / (double )(1 << 1));
+    eph._health = bits.getBits(6);
+    eph._L2PFlag = bits.getBits(1);
+    fitIntervalFalg = bits.getBits(1);
     eph._fitInterval = fitIntervalFromFlag(fitIntervalFalg, eph._IODC, eph.system());
     eph._TOT = 0.9999e9;
     eph._type = t_eph::LNAV;
     eph._prn.setFlag(eph._type);
 
+    if (!bits.ok()) {
+      return false;
+    }
     emit newGPSEph(eph);
     decoded = true;
   }
@@ -1164,16 +1118,16 @@ bool RTCM3Decoder::DecodeGLONASSEphemeris(unsigned char* data, int size) {
   if (size == 51) {
     t_ephGlo eph;
     int sv, i, tk;
-    uint64_t numbits = 0, bitfield = 0;
 
     data += 3; /* header */
     size -= 6; /* header + crc */
-    SKIPBITS(12)
+    t_bitReader bits(data, size);
+    bits.skipBits(12);
 
     eph._receptDateTime = currentDateAndTimeGPS();
     eph._receptStaID = _staID;
 
-    GETBITS(sv, 6)
+    sv = bits.getBits(6);
     if (sv < 1 || sv > 63) {
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (R):  SLOT# is unknown (0) or out of range: %3!")
@@ -1185,7 +1139,7 @@ bool RTCM3Decoder::DecodeGLONASSEphemeris(unsigned char* data, int size) {
     }
     eph._prn.set('R', sv);
 
-    GETBITS(i, 5)
+    i = bits.getBits(5);
     if (i < 0 || i > 20) {
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (%3): FRQ CHN# is out of range: %4")
@@ -1197,11 +1151,11 @@ bool RTCM3Decoder::DecodeGLONASSEphemeris(unsigned char* data, int size) {
       return false;
     }
     eph._frq_num = i - 7;
-    GETBITS(eph._almanac_health, 1) /* almanac healthy */
-    GETBITS(eph._almanac_health_availablility_indicator, 1) /* almanac health ok */
-    GETBITS(eph._P1, 2) /*  P1 */
+    eph._almanac_health = bits.getBits(1); /* almanac healthy */
+    eph._almanac_health_availablility_indicator = bits.getBits(1); /* almanac health ok */
+    eph._P1 = bits.getBits(2); /*  P1 */
     /* tk */
-    GETBITS(i, 5)
+    i = bits.getBits(5);
     if (i < 0 || i > 23) {
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (%3): T_k (bits 11-7) is out of range: %4")
@@ -1213,7 +1167,7 @@ bool RTCM3Decoder::DecodeGLONASSEphemeris(unsigned char* data, int size) {
       return false;
     }
     tk = i * 60 * 60;
-    GETBITS(i, 6)
+    i = bits.getBits(6);
     if (i < 0 || i > 59) {
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (%3): T_k (bits 6-1) is out of range: %4")
@@ -1225,7 +1179,7 @@ bool RTCM3Decoder::DecodeGLONASSEphemeris(unsigned char* data, int size) {
       return false;
     }
     tk += i * 60;
-    GETBITS(i, 1)
+    i = bits.getBits(1);
     if (i < 0 || i > 1) {
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (%3): T_k (bit 0) is out of range: %4")
@@ -1241,9 +1195,9 @@ bool RTCM3Decoder::DecodeGLONASSEphemeris(unsigned char* data, int size) {
     if(eph._tki < 0.0) {
       eph._tki += 86400.0;
     }
-    GETBITS(eph._health, 1) /* MSB of Bn*/
-    GETBITS(eph._P2, 1)  /* P2 */
-    GETBITS(i, 7)
+    eph._health = bits.getBits(1); /* MSB of Bn*/
+    eph._P2 = bits.getBits(1);  /* P2 */
+    i = bits.getBits(7);
     i *= 15;
     if (i < 15 || i > 1425) {
 #ifdef BNC_DEBUG_BCE
@@ -1257,25 +1211,25 @@ bool RTCM3Decoder::DecodeGLONASSEphemeris(unsigned char* data, int size) {
     }
     eph._TOC.setTk(i * 60 * 1000); /* tb */
 
-    GETFLOATSIGNM(eph._x_vel, 24, 1.0 / (double )(1 << 20))
-    GETFLOATSIGNM(eph._x_pos, 27, 1.0 / (double )(1 << 11))
-    GETFLOATSIGNM(eph._x_acc,  5, 1.0 / (double )(1 << 30))
-    GETFLOATSIGNM(eph._y_vel, 24, 1.0 / (double )(1 << 20))
-    GETFLOATSIGNM(eph._y_pos, 27, 1.0 / (double )(1 << 11))
-    GETFLOATSIGNM(eph._y_acc,  5, 1.0 / (double )(1 << 30))
-    GETFLOATSIGNM(eph._z_vel, 24, 1.0 / (double )(1 << 20))
-    GETFLOATSIGNM(eph._z_pos, 27, 1.0 / (double )(1 << 11))
-    GETFLOATSIGNM(eph._z_acc,  5, 1.0 / (double )(1 << 30))
-    GETBITS(eph._P3, 1)    /* P3 */
-    GETFLOATSIGNM(eph._gamma,      11, 1.0 / (double )(1 << 30) / (double )(1 << 10))
-    GETBITS(eph._M_P,  2) /* GLONASS-M P, */
-    GETBITS(eph._M_l3, 1) /* GLONASS-M ln (third string) */
-    GETFLOATSIGNM(eph._tau,        22, 1.0 / (double )(1 << 30))  /* GLONASS tau n(tb) */
-    GETFLOATSIGNM(eph._M_delta_tau, 5, 1.0 / (double )(1 << 30))  /* GLONASS-M delta tau n(tb) */
-    GETBITS(eph._E, 5)
-    GETBITS(eph._M_P4,  1) /* GLONASS-M P4 */
-    GETBITS(eph._M_FT,  4) /* GLONASS-M Ft */
-    GETBITS(eph._M_NT, 11) /* GLONASS-M Nt */
+    eph._x_vel = bits.getFloatSignM(24, 1.0 / (double )(1 << 20));
+    eph._x_pos = bits.getFloatSignM(27, 1.0 / (double )(1 << 11));
+    eph._x_acc = bits.getFloatSignM(5, 1.0 / (double )(1 << 30));
+    eph._y_vel = bits.getFloatSignM(24, 1.0 / (double )(1 << 20));
+    eph._y_pos = bits.getFloatSignM(27, 1.0 / (double )(1 << 11));
+    eph._y_acc = bits.getFloatSignM(5, 1.0 / (double )(1 << 30));
+    eph._z_vel = bits.getFloatSignM(24, 1.0 / (double )(1 << 20));
+    eph._z_pos = bits.getFloatSignM(27, 1.0 / (double )(1 << 11));
+    eph._z_acc = bits.getFloatSignM(5, 1.0 / (double )(1 << 30));
+    eph._P3 = bits.getBits(1);    /* P3 */
+    eph._gamma = bits.getFloatSignM(11, 1.0 / (double )(1 << 30) / (double )(1 << 10));
+    eph._M_P = bits.getBits(2); /* GLONASS-M P, */
+    eph._M_l3 = bits.getBits(1); /* GLONASS-M ln (third string) */
+    eph._tau = bits.getFloatSignM(22, 1.0 / (double )(1 << 30));  /* GLONASS tau n(tb) */
+    eph._M_delta_tau = bits.getFloatSignM(5, 1.0 / (double )(1 << 30));  /* GLONASS-M delta tau n(tb) */
+    eph._E = bits.getBits(5);
+    eph._M_P4 = bits.getBits(1); /* GLONASS-M P4 */
+    eph._M_FT = bits.getBits(4); /* GLONASS-M Ft */
+    eph._M_NT = bits.getBits(11); /* GLONASS-M Nt */
     if (eph._M_NT == 0.0) {
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (%3): NT = %4: missing data!")
@@ -1283,8 +1237,8 @@ bool RTCM3Decoder::DecodeGLONASSEphemeris(unsigned char* data, int size) {
 #endif
       return false;
     }
-    GETBITS(eph._M_M,   2) /* GLONASS-M M */
-    GETBITS(eph._additional_data_availability, 1) /* GLONASS-M The Availability of Additional Data */
+    eph._M_M = bits.getBits(2); /* GLONASS-M M */
+    eph._additional_data_availability = bits.getBits(1); /* GLONASS-M The Availability of Additional Data */
     if (eph._additional_data_availability == 0.0) {
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (%3): ADD = %4: missing data!")
@@ -1293,11 +1247,11 @@ bool RTCM3Decoder::DecodeGLONASSEphemeris(unsigned char* data, int size) {
 #endif
       return false;
     }
-    GETBITS(eph._M_NA,  11) /* GLONASS-M Na */
-    GETFLOATSIGNM(eph._tauC,       32, 1.0/(double)(1<<30)/(double)(1<<1)) /* GLONASS tau c */
-    GETBITS(eph._M_N4, 5) /* GLONASS-M N4 */
-    GETFLOATSIGNM(eph._M_tau_GPS,  22, 1.0/(double)(1<<30)) /* GLONASS-M tau GPS */
-    GETBITS(eph._M_l5, 1) /* GLONASS-M ln (fifth string) */
+    eph._M_NA = bits.getBits(11); /* GLONASS-M Na */
+    eph._tauC = bits.getFloatSignM(32, 1.0/(double)(1<<30)/(double)(1<<1)); /* GLONASS tau c */
+    eph._M_N4 = bits.getBits(5); /* GLONASS-M N4 */
+    eph._M_tau_GPS = bits.getFloatSignM(22, 1.0/(double)(1<<30)); /* GLONASS-M tau GPS */
+    eph._M_l5 = bits.getBits(1); /* GLONASS-M ln (fifth string) */
 
     unsigned year, month, day;
     eph._TOC.civil_date(year, month, day);
@@ -1337,6 +1291,9 @@ bool RTCM3Decoder::DecodeGLONASSEphemeris(unsigned char* data, int size) {
     eph._healthflags_unknown = false;
     eph._statusflags_unknown = false;
 
+    if (!bits.ok()) {
+      return false;
+    }
     emit newGlonassEph(eph);
     decoded = true;
   }
@@ -1351,17 +1308,17 @@ bool RTCM3Decoder::DecodeQZSSEphemeris(unsigned char* data, int size) {
   if (size == 67) {
     t_ephGPS eph;
     int i, week;
-    uint64_t numbits = 0, bitfield = 0;
     int fitIntervalFalg = 0;
 
     data += 3; /* header */
     size -= 6; /* header + crc */
-    SKIPBITS(12)
+    t_bitReader bits(data, size);
+    bits.skipBits(12);
 
     eph._receptDateTime = currentDateAndTimeGPS();
     eph._receptStaID = _staID;
 
-    GETBITS(i, 4)
+    i = bits.getBits(4);
     if (i < 1 || i > 10 ) {
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (J) SAT ID is out of range: %3!")
@@ -1373,7 +1330,7 @@ bool RTCM3Decoder::DecodeQZSSEphemeris(unsigned char* data, int size) {
     }
     eph._prn.set('J', i);
 
-    GETBITS(i, 16)
+    i = bits.getBits(16);
     i <<= 4;
     if (i < 0 || i > 604784) {
 #ifdef BNC_DEBUG_BCE
@@ -1387,17 +1344,17 @@ bool RTCM3Decoder::DecodeQZSSEphemeris(unsigned char* data, int size) {
     }
     eph._TOC.set(i * 1000);
 
-    GETFLOATSIGN(eph._clock_driftrate, 8, 1.0 / (double )(1 << 30) / (double )(1 << 25))
-    GETFLOATSIGN(eph._clock_drift,    16, 1.0 / (double )(1 << 30) / (double )(1 << 13))
-    GETFLOATSIGN(eph._clock_bias,     22, 1.0 / (double )(1 << 30) / (double )(1 << 1))
-    GETBITS(eph._IODE, 8)
-    GETFLOATSIGN(eph._Crs,     16, 1.0 / (double )(1 << 5))
-    GETFLOATSIGN(eph._Delta_n, 16, R2R_PI/(double)(1<<30)/(double)(1<<13))
-    GETFLOATSIGN(eph._M0,      32, R2R_PI/(double)(1<<30)/(double)(1<<1))
-    GETFLOATSIGN(eph._Cuc,     16, 1.0 / (double )(1 << 29))
-    GETFLOAT(eph._e,           32, 1.0 / (double )(1 << 30) / (double )(1 << 3))
-    GETFLOATSIGN(eph._Cus,     16, 1.0 / (double )(1 << 29))
-    GETFLOAT(eph._sqrt_A,      32, 1.0 / (double )(1 << 19))
+    eph._clock_driftrate = bits.getFloatSign(8, 1.0 / (double )(1 << 30) / (double )(1 << 25));
+    eph._clock_drift = bits.getFloatSign(16, 1.0 / (double )(1 << 30) / (double )(1 << 13));
+    eph._clock_bias = bits.getFloatSign(22, 1.0 / (double )(1 << 30) / (double )(1 << 1));
+    eph._IODE = bits.getBits(8);
+    eph._Crs = bits.getFloatSign(16, 1.0 / (double )(1 << 5));
+    eph._Delta_n = bits.getFloatSign(16, R2R_PI/(double)(1<<30)/(double)(1<<13));
+    eph._M0 = bits.getFloatSign(32, R2R_PI/(double)(1<<30)/(double)(1<<1));
+    eph._Cuc = bits.getFloatSign(16, 1.0 / (double )(1 << 29));
+    eph._e = bits.getFloat(32, 1.0 / (double )(1 << 30) / (double )(1 << 3));
+    eph._Cus = bits.getFloatSign(16, 1.0 / (double )(1 << 29));
+    eph._sqrt_A = bits.getFloat(32, 1.0 / (double )(1 << 19));
     if (eph._sqrt_A < 1000.0) {
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (%3) SQRT_A %4 m!")
@@ -1406,7 +1363,7 @@ bool RTCM3Decoder::DecodeQZSSEphemeris(unsigned char* data, int size) {
 #endif
       return false;
     }
-    GETBITS(i, 16)
+    i = bits.getBits(16);
     i <<= 4;
     if (i < 0 || i > 604784) {
 #ifdef BNC_DEBUG_BCE
@@ -1422,16 +1379,16 @@ bool RTCM3Decoder::DecodeQZSSEphemeris(unsigned char* data, int size) {
     bncTime t;
     t.set(i*1000);
     eph._TOEweek = t.gpsw();
-    GETFLOATSIGN(eph._Cic,      16, 1.0 / (double )(1 << 29))
-    GETFLOATSIGN(eph._OMEGA0,   32, R2R_PI/(double)(1<<30)/(double)(1<<1))
-    GETFLOATSIGN(eph._Cis,      16, 1.0 / (double )(1 << 29))
-    GETFLOATSIGN(eph._i0,       32, R2R_PI/(double)(1<<30)/(double)(1<<1))
-    GETFLOATSIGN(eph._Crc,      16, 1.0 / (double )(1 << 5))
-    GETFLOATSIGN(eph._omega,    32, R2R_PI/(double)(1<<30)/(double)(1<<1))
-    GETFLOATSIGN(eph._OMEGADOT, 24, R2R_PI/(double)(1<<30)/(double)(1<<13))
-    GETFLOATSIGN(eph._IDOT,     14, R2R_PI/(double)(1<<30)/(double)(1<<13))
-    GETBITS(eph._L2Codes, 2)
-    GETBITS(week, 10)
+    eph._Cic = bits.getFloatSign(16, 1.0 / (double )(1 << 29));
+    eph._OMEGA0 = bits.getFloatSign(32, R2R_PI/(double)(1<<30)/(double)(1<<1));
+    eph._Cis = bits.getFloatSign(16, 1.0 / (double )(1 << 29));
+    eph._i0 = bits.getFloatSign(32, R2R_PI/(double)(1<<30)/(double)(1<<1));
+    eph._Crc = bits.getFloatSign(16, 1.0 / (double )(1 << 5));
+    eph._omega = bits.getFloatSign(32, R2R_PI/(double)(1<<30)/(double)(1<<1));
+    eph._OMEGADOT = bits.getFloatSign(24, R2R_PI/(double)(1<<30)/(double)(1<<13));
+    eph._IDOT = bits.getFloatSign(14, R2R_PI/(double)(1<<30)/(double)(1<<13));
+    eph._L2Codes = bits.getBits(2);
+    week = bits.getBits(10);
     if (week < 0 || week > 1023) {
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (%3) WEEK # is out of range: %4!")
@@ -1448,16 +1405,19 @@ bool RTCM3Decoder::DecodeQZSSEphemeris(unsigned char* data, int size) {
     if (eph._TOEweek > week + 1 || eph._TOEweek < week - 1) /* invalid week */
       return false;
 
-    GETBITS(i, 4)
+    i = bits.getBits(4);
     eph._ura = accuracyFromIndex(i, eph.system());
-    GETBITS(eph._health, 6)
-    GETFLOATSIGN(eph._TGD,       8, 1.0 / (double )(1 << 30) / (double )(1 << 1))
-    GETBITS(eph._IODC, 10)
-    GETBITS(fitIntervalFalg, 1)
+    eph._health = bits.getBits(6);
+    eph._TGD = bits.getFloatSign(8, 1.0 / (double )(1 << 30) / (double )(1 << 1));
+    eph._IODC = bits.getBits(10);
+    fitIntervalFalg = bits.getBits(1);
     eph._fitInterval = fitIntervalFromFlag(fitIntervalFalg, eph._IODC, eph.system());
     eph._TOT = 0.9999e9;
     eph._type = t_eph::LNAV;
 
+    if (!bits.ok()) {
+      return false;
+    }
     emit newGPSEph(eph);
     decoded = true;
   }
@@ -1472,16 +1432,16 @@ bool RTCM3Decoder::DecodeNavICEphemeris(unsigned char* data, int size) {
   if (size == 67) {
     t_ephGPS eph;
     int i, week, L5Flag, SFlag;
-    uint64_t numbits = 0, bitfield = 0;
 
     data += 3; /* header */
     size -= 6; /* header + crc */
-    SKIPBITS(12)
+    t_bitReader bits(data, size);
+    bits.skipBits(12);
 
     eph._receptDateTime = currentDateAndTimeGPS();
     eph._receptStaID = _staID;
 
-    GETBITS(i, 6)
+    i = bits.getBits(6);
     if (i < 1 || i > 63 ) {
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (I) PRN# is out of range: %3!")
@@ -1492,7 +1452,7 @@ bool RTCM3Decoder::DecodeNavICEphemeris(unsigned char* data, int size) {
       return false;
     }
     eph._prn.set('I', i);
-    GETBITS(week, 10)
+    week = bits.getBits(10);
     if (week < 0 || week > 1023) {
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (%3) WEEK # is out of range: %4!")
@@ -1503,12 +1463,12 @@ bool RTCM3Decoder::DecodeNavICEphemeris(unsigned char* data, int size) {
 #endif
       return false;
     }
-    GETFLOATSIGN(eph._clock_bias,     22, 1.0 / (double )(1 << 30) / (double )(1 << 1))
-    GETFLOATSIGN(eph._clock_drift,    16, 1.0 / (double )(1 << 30) / (double )(1 << 13))
-    GETFLOATSIGN(eph._clock_driftrate, 8, 1.0 / (double )(1 << 30) / (double )(1 << 25))
-    GETBITS(i, 4)
+    eph._clock_bias = bits.getFloatSign(22, 1.0 / (double )(1 << 30) / (double )(1 << 1));
+    eph._clock_drift = bits.getFloatSign(16, 1.0 / (double )(1 << 30) / (double )(1 << 13));
+    eph._clock_driftrate = bits.getFloatSign(8, 1.0 / (double )(1 << 30) / (double )(1 << 25));
+    i = bits.getBits(4);
     eph._ura = accuracyFromIndex(i, eph.system());
-    GETBITS(i, 16)
+    i = bits.getBits(16);
     i <<= 4;
     if (i < 0 || i > 1048560) {
 #ifdef BNC_DEBUG_BCE
@@ -1521,14 +1481,14 @@ bool RTCM3Decoder::DecodeNavICEphemeris(unsigned char* data, int size) {
       return false;
     }
     eph._TOC.set(i * 1000);
-    GETFLOATSIGN(eph._TGD, 8, 1.0 / (double )(1 << 30) / (double )(1 <<  1))
-    GETFLOATSIGN(eph._Delta_n, 22, R2R_PI/(double)(1<<30)/(double)(1 << 11))
+    eph._TGD = bits.getFloatSign(8, 1.0 / (double )(1 << 30) / (double )(1 <<  1));
+    eph._Delta_n = bits.getFloatSign(22, R2R_PI/(double)(1<<30)/(double)(1 << 11));
     // IODCE
-    GETBITS(eph._IODE, 8)
+    eph._IODE = bits.getBits(8);
     eph._IODC = eph._IODE;
-    SKIPBITS(10)
-    GETBITS(L5Flag, 1)
-    GETBITS(SFlag, 1)
+    bits.skipBits(10);
+    L5Flag = bits.getBits(1);
+    SFlag = bits.getBits(1);
     if      (L5Flag == 0 && SFlag == 0) {
       eph._health = 0.0;
     }
@@ -1541,16 +1501,16 @@ bool RTCM3Decoder::DecodeNavICEphemeris(unsigned char* data, int size) {
     else if (L5Flag == 1 && SFlag == 1) {
       eph._health = 3.0;
     }
-    GETFLOATSIGN(eph._Cuc,  15, 1.0 / (double )(1 << 28))
-    GETFLOATSIGN(eph._Cus,  15, 1.0 / (double )(1 << 28))
-    GETFLOATSIGN(eph._Cic,  15, 1.0 / (double )(1 << 28))
-    GETFLOATSIGN(eph._Cis,  15, 1.0 / (double )(1 << 28))
-    GETFLOATSIGN(eph._Crc,  15, 1.0 / (double )(1 <<  4))
-    GETFLOATSIGN(eph._Crs,  15, 1.0 / (double )(1 <<  4))
-    GETFLOATSIGN(eph._IDOT, 14, R2R_PI/(double)(1<<30)/(double)(1<<13))
-    SKIPBITS(2)
-    GETFLOATSIGN(eph._M0,   32, R2R_PI/(double)(1<<30)/(double)(1<< 1))
-    GETBITS(i, 16)
+    eph._Cuc = bits.getFloatSign(15, 1.0 / (double )(1 << 28));
+    eph._Cus = bits.getFloatSign(15, 1.0 / (double )(1 << 28));
+    eph._Cic = bits.getFloatSign(15, 1.0 / (double )(1 << 28));
+    eph._Cis = bits.getFloatSign(15, 1.0 / (double )(1 << 28));
+    eph._Crc = bits.getFloatSign(15, 1.0 / (double )(1 <<  4));
+    eph._Crs = bits.getFloatSign(15, 1.0 / (double )(1 <<  4));
+    eph._IDOT = bits.getFloatSign(14, R2R_PI/(double)(1<<30)/(double)(1<<13));
+    bits.skipBits(2);
+    eph._M0 = bits.getFloatSign(32, R2R_PI/(double)(1<<30)/(double)(1<< 1));
+    i = bits.getBits(16);
     i <<= 4;
     if (i < 0 || i > 1048560) {
 #ifdef BNC_DEBUG_BCE
@@ -1571,8 +1531,8 @@ bool RTCM3Decoder::DecodeNavICEphemeris(unsigned char* data, int size) {
     /* week from HOW, differs from TOC, TOE week, we use adapted value instead */
     if (eph._TOEweek > week + 1 || eph._TOEweek < week - 1) /* invalid week */
       return false;
-    GETFLOAT(eph._e,            32, 1.0 / (double )(1 << 30) / (double )(1 << 3))
-    GETFLOAT(eph._sqrt_A,       32, 1.0 / (double )(1 << 19))
+    eph._e = bits.getFloat(32, 1.0 / (double )(1 << 30) / (double )(1 << 3));
+    eph._sqrt_A = bits.getFloat(32, 1.0 / (double )(1 << 19));
     if (eph._sqrt_A < 1000.0) {
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (%3) SQRT_A %4 m!")
@@ -1581,15 +1541,18 @@ bool RTCM3Decoder::DecodeNavICEphemeris(unsigned char* data, int size) {
 #endif
       return false;
     }
-    GETFLOATSIGN(eph._OMEGA0,   32, R2R_PI/(double)(1<<30)/(double)(1<< 1))
-    GETFLOATSIGN(eph._omega,    32, R2R_PI/(double)(1<<30)/(double)(1<< 1))
-    GETFLOATSIGN(eph._OMEGADOT, 22, R2R_PI/(double)(1<<30)/(double)(1<<11))
-    GETFLOATSIGN(eph._i0,       32, R2R_PI/(double)(1<<30)/(double)(1<< 1))
-    SKIPBITS(2)
+    eph._OMEGA0 = bits.getFloatSign(32, R2R_PI/(double)(1<<30)/(double)(1<< 1));
+    eph._omega = bits.getFloatSign(32, R2R_PI/(double)(1<<30)/(double)(1<< 1));
+    eph._OMEGADOT = bits.getFloatSign(22, R2R_PI/(double)(1<<30)/(double)(1<<11));
+    eph._i0 = bits.getFloatSign(32, R2R_PI/(double)(1<<30)/(double)(1<< 1));
+    bits.skipBits(2);
     eph._TOT = 0.9999e9;
     eph._type = t_eph::LNAV;
     eph._prn.setFlag(eph._type);
 
+    if (!bits.ok()) {
+      return false;
+    }
     emit newGPSEph(eph);
     decoded = true;
   }
@@ -1605,16 +1568,16 @@ bool RTCM3Decoder::DecodeSBASEphemeris(unsigned char* data, int size) {
     t_ephSBAS eph;
     int i;
     eph._health = 0;
-    uint64_t numbits = 0, bitfield = 0;
 
     data += 3; /* header */
     size -= 6; /* header + crc */
-    SKIPBITS(12)
+    t_bitReader bits(data, size);
+    bits.skipBits(12);
 
     eph._receptDateTime = currentDateAndTimeGPS();
     eph._receptStaID = _staID;
 
-    GETBITS(i, 6)
+    i = bits.getBits(6);
     if (i < 0 || i > 38 ) {
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (S) PRN# is out of range: %3!")
@@ -1625,8 +1588,8 @@ bool RTCM3Decoder::DecodeSBASEphemeris(unsigned char* data, int size) {
       return false;
     }
     eph._prn.set('S', 20 + i);
-    GETBITS(eph._IODN, 8)
-    GETBITS(i, 13)
+    eph._IODN = bits.getBits(8);
+    i = bits.getBits(13);
     i <<= 4;
     if (i < 0 || i > 86384) {
 #ifdef BNC_DEBUG_BCE
@@ -1639,7 +1602,7 @@ bool RTCM3Decoder::DecodeSBASEphemeris(unsigned char* data, int size) {
       return false;
     }
     eph._TOC.setTOD(i * 1000);
-    GETBITS(i, 4)
+    i = bits.getBits(4);
     int health = 0;
     if (i == 15) {
       health |= (1 << 5);
@@ -1652,9 +1615,9 @@ bool RTCM3Decoder::DecodeSBASEphemeris(unsigned char* data, int size) {
       eph._health = double(health);
     }
     eph._ura = accuracyFromIndex(i, eph.system());
-    GETFLOATSIGN(eph._x_pos, 30, 0.08)
-    GETFLOATSIGN(eph._y_pos, 30, 0.08)
-    GETFLOATSIGN(eph._z_pos, 25, 0.4)
+    eph._x_pos = bits.getFloatSign(30, 0.08);
+    eph._y_pos = bits.getFloatSign(30, 0.08);
+    eph._z_pos = bits.getFloatSign(25, 0.4);
     ColumnVector pos(3);
     pos(1) = eph._x_pos; pos(2) = eph._y_pos; pos(3) = eph._z_pos;
     if (pos.NormFrobenius() < 1.0) {
@@ -1664,20 +1627,23 @@ bool RTCM3Decoder::DecodeSBASEphemeris(unsigned char* data, int size) {
 #endif
       return false;
     }
-    GETFLOATSIGN(eph._x_vel, 17, 0.000625)
-    GETFLOATSIGN(eph._y_vel, 17, 0.000625)
-    GETFLOATSIGN(eph._z_vel, 18, 0.004)
-    GETFLOATSIGN(eph._x_acc, 10, 0.0000125)
-    GETFLOATSIGN(eph._y_acc, 10, 0.0000125)
-    GETFLOATSIGN(eph._z_acc, 10, 0.0000625)
-    GETFLOATSIGN(eph._agf0, 12, 1.0 / (1 << 30) / (1 << 1))
-    GETFLOATSIGN(eph._agf1, 8, 1.0 / (1 << 30) / (1 << 10))
+    eph._x_vel = bits.getFloatSign(17, 0.000625);
+    eph._y_vel = bits.getFloatSign(17, 0.000625);
+    eph._z_vel = bits.getFloatSign(18, 0.004);
+    eph._x_acc = bits.getFloatSign(10, 0.0000125);
+    eph._y_acc = bits.getFloatSign(10, 0.0000125);
+    eph._z_acc = bits.getFloatSign(10, 0.0000625);
+    eph._agf0 = bits.getFloatSign(12, 1.0 / (1 << 30) / (1 << 1));
+    eph._agf1 = bits.getFloatSign(8, 1.0 / (1 << 30) / (1 << 10));
 
     eph._TOT = 0.9999E9;
 
     eph._type = t_eph::SBASL1;
     eph._prn.setFlag(eph._type);
 
+    if (!bits.ok()) {
+      return false;
+    }
     emit newSBASEph(eph);
     decoded = true;
   }
@@ -1688,12 +1654,12 @@ bool RTCM3Decoder::DecodeSBASEphemeris(unsigned char* data, int size) {
 ////////////////////////////////////////////////////////////////////////////
 bool RTCM3Decoder::DecodeGalileoEphemeris(unsigned char* data, int size) {
   bool decoded = false;
-  uint64_t numbits = 0, bitfield = 0;
   int i, week, mnum;
 
   data += 3; /* header */
   size -= 6; /* header + crc */
-  GETBITS(i, 12)
+  t_bitReader bits(data, size);
+  i = bits.getBits(12);
 
   if ((i == 1046 && size == 61) ||
       (i == 1045 && size == 60)) {
@@ -1704,7 +1670,7 @@ bool RTCM3Decoder::DecodeGalileoEphemeris(unsigned char* data, int size) {
     eph._inav = (i == 1046);
     eph._fnav = (i == 1045);
     mnum = i;
-    GETBITS(i, 6)
+    i = bits.getBits(6);
     if (i < 1 || i > 36 ) { // max. constellation within I/NAV / F/NAV frames is 36
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (E) PRN# is out of range: %3!")
@@ -1716,7 +1682,7 @@ bool RTCM3Decoder::DecodeGalileoEphemeris(unsigned char* data, int size) {
     }
     eph._prn.set('E', i, eph._inav ? t_eph::INAV : t_eph::FNAV);
 
-    GETBITS(week, 12) //FIXME: roll-over after week 4095!!
+    week = bits.getBits(12); //FIXME: roll-over after week 4095!!
     if (week < 0 || week > 4095) {
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (%3) WEEK # is out of range: %4!")
@@ -1728,11 +1694,11 @@ bool RTCM3Decoder::DecodeGalileoEphemeris(unsigned char* data, int size) {
       return false;
     }
     eph._TOEweek = week;
-    GETBITS(eph._IODnav, 10)
-    GETBITS(i, 8)
+    eph._IODnav = bits.getBits(10);
+    i = bits.getBits(8);
     eph._SISA = accuracyFromIndex(i, eph.system());
-    GETFLOATSIGN(eph._IDOT, 14, R2R_PI/(double)(1<<30)/(double)(1<<13))
-    GETBITSFACTOR(i, 14, 60)
+    eph._IDOT = bits.getFloatSign(14, R2R_PI/(double)(1<<30)/(double)(1<<13));
+    i = bits.getBits(14) * 60;
     if (i < 0 || i > 604740) {
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (%3) TOC is out of range: %4!")
@@ -1744,17 +1710,17 @@ bool RTCM3Decoder::DecodeGalileoEphemeris(unsigned char* data, int size) {
       return false;
     }
     eph._TOC.set(1024 + eph._TOEweek, i);// Period #2 = + 1 x 1024 (has to be determined)
-    GETFLOATSIGN(eph._clock_driftrate, 6, 1.0 / (double )(1 << 30) / (double )(1 << 29))
-    GETFLOATSIGN(eph._clock_drift,    21, 1.0 / (double )(1 << 30) / (double )(1 << 16))
-    GETFLOATSIGN(eph._clock_bias,     31, 1.0 / (double )(1 << 30) / (double )(1 << 4))
-    GETFLOATSIGN(eph._Crs,            16, 1.0 / (double )(1 << 5))
-    GETFLOATSIGN(eph._Delta_n,        16, R2R_PI/(double)(1<<30)/(double)(1<<13))
-    GETFLOATSIGN(eph._M0,             32, R2R_PI/(double)(1<<30)/(double)(1<<1))
-    GETFLOATSIGN(eph._Cuc,            16, 1.0 / (double )(1 << 29))
-    GETFLOAT(eph._e,                  32, 1.0 / (double )(1 << 30) / (double )(1 << 3))
-    GETFLOATSIGN(eph._Cus,            16, 1.0 / (double )(1 << 29))
-    GETFLOAT(eph._sqrt_A,             32, 1.0 / (double )(1 << 19))
-    GETBITSFACTOR(eph._TOEsec, 14, 60)
+    eph._clock_driftrate = bits.getFloatSign(6, 1.0 / (double )(1 << 30) / (double )(1 << 29));
+    eph._clock_drift = bits.getFloatSign(21, 1.0 / (double )(1 << 30) / (double )(1 << 16));
+    eph._clock_bias = bits.getFloatSign(31, 1.0 / (double )(1 << 30) / (double )(1 << 4));
+    eph._Crs = bits.getFloatSign(16, 1.0 / (double )(1 << 5));
+    eph._Delta_n = bits.getFloatSign(16, R2R_PI/(double)(1<<30)/(double)(1<<13));
+    eph._M0 = bits.getFloatSign(32, R2R_PI/(double)(1<<30)/(double)(1<<1));
+    eph._Cuc = bits.getFloatSign(16, 1.0 / (double )(1 << 29));
+    eph._e = bits.getFloat(32, 1.0 / (double )(1 << 30) / (double )(1 << 3));
+    eph._Cus = bits.getFloatSign(16, 1.0 / (double )(1 << 29));
+    eph._sqrt_A = bits.getFloat(32, 1.0 / (double )(1 << 19));
+    eph._TOEsec = bits.getBits(14) * 60;
     if (i < 0 || i > 604740) {
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (%3) TOE is out of range: %4!")
@@ -1767,25 +1733,25 @@ bool RTCM3Decoder::DecodeGalileoEphemeris(unsigned char* data, int size) {
     }
     /* FIXME: overwrite value, copied from old code */
     //eph._TOEsec = eph._TOC.gpssec();
-    GETFLOATSIGN(eph._Cic,      16, 1.0 / (double )(1 << 29))
-    GETFLOATSIGN(eph._OMEGA0,   32, R2R_PI/(double)(1<<30)/(double)(1<<1))
-    GETFLOATSIGN(eph._Cis,      16, 1.0 / (double )(1 << 29))
-    GETFLOATSIGN(eph._i0,       32, R2R_PI/(double)(1<<30)/(double)(1<<1))
-    GETFLOATSIGN(eph._Crc,      16, 1.0 / (double )(1 << 5))
-    GETFLOATSIGN(eph._omega,    32, R2R_PI/(double)(1<<30)/(double)(1<<1))
-    GETFLOATSIGN(eph._OMEGADOT, 24, R2R_PI/(double)(1<<30)/(double)(1<<13))
-    GETFLOATSIGN(eph._BGD_1_5A, 10, 1.0 / (double )(1 << 30) / (double )(1 << 2))
+    eph._Cic = bits.getFloatSign(16, 1.0 / (double )(1 << 29));
+    eph._OMEGA0 = bits.getFloatSign(32, R2R_PI/(double)(1<<30)/(double)(1<<1));
+    eph._Cis = bits.getFloatSign(16, 1.0 / (double )(1 << 29));
+    eph._i0 = bits.getFloatSign(32, R2R_PI/(double)(1<<30)/(double)(1<<1));
+    eph._Crc = bits.getFloatSign(16, 1.0 / (double )(1 << 5));
+    eph._omega = bits.getFloatSign(32, R2R_PI/(double)(1<<30)/(double)(1<<1));
+    eph._OMEGADOT = bits.getFloatSign(24, R2R_PI/(double)(1<<30)/(double)(1<<13));
+    eph._BGD_1_5A = bits.getFloatSign(10, 1.0 / (double )(1 << 30) / (double )(1 << 2));
     if (eph._inav) {
       eph._type = t_eph::INAV;
       /* set unused F/NAV values */
       eph._E5a_HS = 0.0;
       eph._E5a_DataInvalid = false;
 
-      GETFLOATSIGN(eph._BGD_1_5B, 10, 1.0 / (double )(1 << 30) / (double )(1 << 2))
-      GETBITS(eph._E5b_HS, 2)
-      GETBITS(eph._E5b_DataInvalid, 1)
-      GETBITS(eph._E1B_HS, 2)
-      GETBITS(eph._E1B_DataInvalid, 1)
+      eph._BGD_1_5B = bits.getFloatSign(10, 1.0 / (double )(1 << 30) / (double )(1 << 2));
+      eph._E5b_HS = bits.getBits(2);
+      eph._E5b_DataInvalid = bits.getBits(1);
+      eph._E1B_HS = bits.getBits(2);
+      eph._E1B_DataInvalid = bits.getBits(1);
       if (eph._E5b_HS != eph._E1B_HS) {
 #ifdef BNC_DEBUG_BCE
         emit(newMessage(QString("%1: Block %2 (%3) SHS E5b %4 E1B %5: inconsistent health!")
@@ -1813,8 +1779,8 @@ bool RTCM3Decoder::DecodeGalileoEphemeris(unsigned char* data, int size) {
       eph._E1B_DataInvalid = false;
       eph._E5b_DataInvalid = false;
 
-      GETBITS(eph._E5a_HS, 2)
-      GETBITS(eph._E5a_DataInvalid, 1)
+      eph._E5a_HS = bits.getBits(2);
+      eph._E5a_DataInvalid = bits.getBits(1);
     }
     eph._TOT = 0.9999e9;
 
@@ -1827,6 +1793,9 @@ bool RTCM3Decoder::DecodeGalileoEphemeris(unsigned char* data, int size) {
       return false;
     }
 
+    if (!bits.ok()) {
+      return false;
+    }
     emit newGalileoEph(eph);
     decoded = true;
   }
@@ -1842,16 +1811,16 @@ bool RTCM3Decoder::DecodeBDSEphemeris(unsigned char* data, int size) {
   if (size == 70) {
     t_ephBDS eph;
     int i, week;
-    uint64_t numbits = 0, bitfield = 0;
 
     data += 3; /* header */
     size -= 6; /* header + crc */
-    SKIPBITS(12)
+    t_bitReader bits(data, size);
+    bits.skipBits(12);
 
     eph._receptDateTime = currentDateAndTimeGPS();
     eph._receptStaID = _staID;
 
-    GETBITS(i, 6)
+    i = bits.getBits(6);
     if (i < 1 || i > 63 ) {
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (C) PRN# is out of range: %3!")
@@ -1863,7 +1832,7 @@ bool RTCM3Decoder::DecodeBDSEphemeris(unsigned char* data, int size) {
     }
     eph._prn.set('C', i);
 
-    GETBITS(week, 13)
+    week = bits.getBits(13);
     if (week < 0 || week > 8191) {
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (%3) WEEK # is out of range: %4!")
@@ -1875,11 +1844,11 @@ bool RTCM3Decoder::DecodeBDSEphemeris(unsigned char* data, int size) {
       return false;
     }
     eph._BDTweek = week;
-    GETBITS(i, 4)
+    i = bits.getBits(4);
     eph._ura = accuracyFromIndex(i, eph.system());
-    GETFLOATSIGN(eph._IDOT, 14, R2R_PI/(double)(1<<30)/(double)(1<<13))
-    GETBITS(eph._AODE, 5)
-    GETBITS(i, 17)
+    eph._IDOT = bits.getFloatSign(14, R2R_PI/(double)(1<<30)/(double)(1<<13));
+    eph._AODE = bits.getBits(5);
+    i = bits.getBits(17);
     i <<= 3;
     if (i < 0 || i > 604792) {
 #ifdef BNC_DEBUG_BCE
@@ -1892,17 +1861,17 @@ bool RTCM3Decoder::DecodeBDSEphemeris(unsigned char* data, int size) {
       return false;
     }
     eph._TOC.setBDS(eph._BDTweek, i);
-    GETFLOATSIGN(eph._clock_driftrate, 11,  1.0 / (double )(1 << 30) / (double )(1 << 30) / (double )(1 << 6))
-    GETFLOATSIGN(eph._clock_drift,     22,  1.0 / (double )(1 << 30) / (double )(1 << 20))
-    GETFLOATSIGN(eph._clock_bias,      24,  1.0 / (double )(1 << 30) / (double )(1 << 3))
-    GETBITS(eph._AODC, 5)
-    GETFLOATSIGN(eph._Crs,     18, 1.0 / (double )(1 << 6))
-    GETFLOATSIGN(eph._Delta_n, 16, R2R_PI/(double)(1<<30)/(double)(1<<13))
-    GETFLOATSIGN(eph._M0,      32, R2R_PI/(double)(1<<30)/(double)(1<<1))
-    GETFLOATSIGN(eph._Cuc,     18, 1.0 / (double )(1 << 30) / (double )(1 << 1))
-    GETFLOAT(eph._e,           32, 1.0 / (double )(1 << 30) / (double )(1 << 3))
-    GETFLOATSIGN(eph._Cus,     18, 1.0 / (double )(1 << 30) / (double )(1 << 1))
-    GETFLOAT(eph._sqrt_A,      32, 1.0 / (double )(1 << 19))
+    eph._clock_driftrate = bits.getFloatSign(11, 1.0 / (double )(1 << 30) / (double )(1 << 30) / (double )(1 << 6));
+    eph._clock_drift = bits.getFloatSign(22, 1.0 / (double )(1 << 30) / (double )(1 << 20));
+    eph._clock_bias = bits.getFloatSign(24, 1.0 / (double )(1 << 30) / (double )(1 << 3));
+    eph._AODC = bits.getBits(5);
+    eph._Crs = bits.getFloatSign(18, 1.0 / (double )(1 << 6));
+    eph._Delta_n = bits.getFloatSign(16, R2R_PI/(double)(1<<30)/(double)(1<<13));
+    eph._M0 = bits.getFloatSign(32, R2R_PI/(double)(1<<30)/(double)(1<<1));
+    eph._Cuc = bits.getFloatSign(18, 1.0 / (double )(1 << 30) / (double )(1 << 1));
+    eph._e = bits.getFloat(32, 1.0 / (double )(1 << 30) / (double )(1 << 3));
+    eph._Cus = bits.getFloatSign(18, 1.0 / (double )(1 << 30) / (double )(1 << 1));
+    eph._sqrt_A = bits.getFloat(32, 1.0 / (double )(1 << 19));
     if (eph._sqrt_A < 1000.0) {
 #ifdef BNC_DEBUG_BCE
       emit(newMessage(QString("%1: Block %2 (%3) SQRT_A %4 m!")
@@ -1911,7 +1880,7 @@ bool RTCM3Decoder::DecodeBDSEphemeris(unsigned char* data, int size) {
 #endif
       return false;
     }
-    GETBITS(i, 17)
+    i = bits.getBits(17);
     i <<= 3;
     if (i < 0 || i > 604792) {
 #ifdef BNC_DEBUG_BCE
@@ -1925,16 +1894,16 @@ bool RTCM3Decoder::DecodeBDSEphemeris(unsigned char* data, int size) {
     }
     eph._TOEsec = i;
     eph._TOE.setBDS(eph._BDTweek, i);
-    GETFLOATSIGN(eph._Cic,      18, 1.0 / (double )(1 << 30) / (double )(1 << 1))
-    GETFLOATSIGN(eph._OMEGA0,   32, R2R_PI/(double)(1<<30)/(double)(1<<1))
-    GETFLOATSIGN(eph._Cis,      18, 1.0 / (double )(1 << 30) / (double )(1 << 1))
-    GETFLOATSIGN(eph._i0,       32, R2R_PI/(double)(1<<30)/(double)(1<<1))
-    GETFLOATSIGN(eph._Crc,      18, 1.0 / (double )(1 << 6))
-    GETFLOATSIGN(eph._omega,    32, R2R_PI/(double)(1<<30)/(double)(1<<1))
-    GETFLOATSIGN(eph._OMEGADOT, 24, R2R_PI/(double)(1<<30)/(double)(1<<13))
-    GETFLOATSIGN(eph._TGD1,     10, 0.0000000001)
-    GETFLOATSIGN(eph._TGD2,     10, 0.0000000001)
-    GETBITS(eph._SatH1, 1)
+    eph._Cic = bits.getFloatSign(18, 1.0 / (double )(1 << 30) / (double )(1 << 1));
+    eph._OMEGA0 = bits.getFloatSign(32, R2R_PI/(double)(1<<30)/(double)(1<<1));
+    eph._Cis = bits.getFloatSign(18, 1.0 / (double )(1 << 30) / (double )(1 << 1));
+    eph._i0 = bits.getFloatSign(32, R2R_PI/(double)(1<<30)/(double)(1<<1));
+    eph._Crc = bits.getFloatSign(18, 1.0 / (double )(1 << 6));
+    eph._omega = bits.getFloatSign(32, R2R_PI/(double)(1<<30)/(double)(1<<1));
+    eph._OMEGADOT = bits.getFloatSign(24, R2R_PI/(double)(1<<30)/(double)(1<<13));
+    eph._TGD1 = bits.getFloatSign(10, 0.0000000001);
+    eph._TGD2 = bits.getFloatSign(10, 0.0000000001);
+    eph._SatH1 = bits.getBits(1);
 
     eph._TOT = 0.9999E9;
     if (eph._i0 > iMaxGEO) {
@@ -1945,6 +1914,9 @@ bool RTCM3Decoder::DecodeBDSEphemeris(unsigned char* data, int size) {
     }
     eph._prn.setFlag(eph._type);
 
+    if (!bits.ok()) {
+      return false;
+    }
     emit newBDSEph(eph);
     decoded = true;
   }
@@ -2195,121 +2167,115 @@ t_irc RTCM3Decoder::Decode(char* buffer, int bufLen, vector<string>& errmsg) {
 
   errmsg.clear();
 
-  while (bufLen && _MessageSize < sizeof(_Message)) {
-    int l = sizeof(_Message) - _MessageSize;
-    if (l > bufLen)
-      l = bufLen;
-    memcpy(_Message + _MessageSize, buffer, l);
-    _MessageSize += l;
-    bufLen -= l;
-    buffer += l;
-    int id;
-    while ((id = GetMessage())) {
-      /* reset station ID for file loading as it can change */
-      if (_rawFile)
-        _staID = _rawFile->staID();
-      /* store the id into the list of loaded blocks */
-      _typeList.push_back(id);
-
-      /* SSR I+II data handled in another function, already pass the
-       * extracted data block. That does no harm, as it anyway skip everything
-       * else. */
-      if ((id >= 1057 && id <= 1068) ||
-          (id >= 1240 && id <= 1270) ||
-          (id == 4076)) {
-        if (!_coDecoders.contains(_staID.toLatin1())) {
-          _coDecoders[_staID.toLatin1()] = new RTCM3coDecoder(_staID);
-          if (id == 4076) {
-            _coDecoders[_staID.toLatin1()]->initSsrFormatType(RTCM3coDecoder::IGSssr);
-          }
-          else {
-            _coDecoders[_staID.toLatin1()]->initSsrFormatType(RTCM3coDecoder::RTCMssr);
-          }
+  _framer.feed(buffer, bufLen);
+  RTCM3Framer::t_frame frame;
+  while (_framer.next(frame)) {
+    int id = frame.type;
+    /* reset station ID for file loading as it can change */
+    if (_rawFile)
+      _staID = _rawFile->staID();
+    /* store the id into the list of loaded blocks */
+    _typeList.push_back(id);
+    _typeSizeList.push_back(static_cast<int>(frame.size));
+
+    /* SSR I+II data handled in another function, already pass the
+     * extracted data block. That does no harm, as it anyway skip everything
+     * else. */
+    if ((id >= 1057 && id <= 1068) ||
+        (id >= 1240 && id <= 1270) ||
+        (id == 4076)) {
+      if (!_coDecoders.contains(_staID.toLatin1())) {
+        _coDecoders[_staID.toLatin1()] = new RTCM3coDecoder(_staID);
+        if (id == 4076) {
+          _coDecoders[_staID.toLatin1()]->initSsrFormatType(RTCM3coDecoder::IGSssr);
         }
-        RTCM3coDecoder* coDecoder = _coDecoders[_staID.toLatin1()];
-        if (coDecoder->Decode(reinterpret_cast<char *>(_Message), _BlockSize, errmsg) == success) {
-          decoded = true;
+        else {
+          _coDecoders[_staID.toLatin1()]->initSsrFormatType(RTCM3coDecoder::RTCMssr);
         }
       }
-      else if (id >= 1070 && id <= 1237) { /* MSM */
-        if (DecodeRTCM3MSM(_Message, _BlockSize))
-          decoded = true;
+      RTCM3coDecoder* coDecoder = _coDecoders[_staID.toLatin1()];
+      if (coDecoder->Decode(reinterpret_cast<char *>(frame.data), frame.size, errmsg) == success) {
+        decoded = true;
       }
-      else {
-        switch (id) {
-          case 1001:
-          case 1003:
+    }
+    else if (id >= 1070 && id <= 1237) { /* MSM */
+      if (DecodeRTCM3MSM(frame.data, frame.size))
+        decoded = true;
+    }
+    else {
+      switch (id) {
+        case 1001:
+        case 1003:
 #ifdef BNC_DEBUG_OBS
-            emit(newMessage(QString("%1: Block %2 contain partial data! Ignored!")
-                 .arg(_staID).arg(id).toLatin1(), true));
+          emit(newMessage(QString("%1: Block %2 contain partial data! Ignored!")
+               .arg(_staID).arg(id).toLatin1(), true));
 #endif
-            break; /* no use decoding partial data ATM, remove break when data can be used */
-          case 1002:
-          case 1004:
-            if (DecodeRTCM3GPS(_Message, _BlockSize))
-              decoded = true;
-            break;
-          case 1009:
-          case 1011:
+          break; /* no use decoding partial data ATM, remove break when data can be used */
+        case 1002:
+        case 1004:
+          if (DecodeRTCM3GPS(frame.data, frame.size))
+            decoded = true;
+          break;
+        case 1009:
+        case 1011:
 #ifdef BNC_DEBUG_OBS
-            emit(newMessage(QString("%1: Block %2 contain partial data! Ignored!")
-                 .arg(_staID).arg(id).toLatin1(), true));
+          emit(newMessage(QString("%1: Block %2 contain partial data! Ignored!")
+               .arg(_staID).arg(id).toLatin1(), true));
 #endif
-            break; /* no use decoding partial data ATM, remove break when data can be used */
-          case 1010:
-          case 1012:
-            if (DecodeRTCM3GLONASS(_Message, _BlockSize))
-              decoded = true;
-            break;
-          case 1019:
-            if (DecodeGPSEphemeris(_Message, _BlockSize))
-              decoded = true;
-            break;
-          case 1020:
-            if (DecodeGLONASSEphemeris(_Message, _BlockSize))
-              decoded = true;
-            break;
-          case 1043:
-            if (DecodeSBASEphemeris(_Message, _BlockSize))
-              decoded = true;
-            break;
-          case 1044:
-            if (DecodeQZSSEphemeris(_Message, _BlockSize))
-              decoded = true;
-            break;
-          case 1041:
-            if (DecodeNavICEphemeris(_Message, _BlockSize))
-              decoded = true;
-            break;
-          case 1045:
-          case 1046:
-            if (DecodeGalileoEphemeris(_Message, _BlockSize))
-              decoded = true;
-            break;
-          case 1042:
-            if (DecodeBDSEphemeris(_Message, _BlockSize))
-              decoded = true;
-            break;
-          case 1007:
-          case 1008:
-          case 1033:
-            DecodeAntennaReceiver(_Message, _BlockSize);
-            break;
-          case 1005:
-          case 1006:
-            DecodeAntennaPosition(_Message, _BlockSize);
-            break;
-          case 1300:
-            DecodeServiceCRS(_Message, _BlockSize);
-            break;
-          case 1301:
-            DecodeHelmertTrafoParameters(_Message, _BlockSize);
-            break;
-          case 1302:
-          case 35:
-            DecodeRTCMCRS(_Message, _BlockSize);
-            break;
-        }
+          break; /* no use decoding partial data ATM, remove break when data can be used */
+        case 1010:
+        case 1012:
+          if (DecodeRTCM3GLONASS(frame.data, frame.size))
+            decoded = true;
+          break;
+        case 1019:
+          if (DecodeGPSEphemeris(frame.data, frame.size))
+            decoded = true;
+          break;
+        case 1020:
+          if (DecodeGLONASSEphemeris(frame.data, frame.size))
+            decoded = true;
+          break;
+        case 1043:
+          if (DecodeSBASEphemeris(frame.data, frame.size))
+            decoded = true;
+          break;
+        case 1044:
+          if (DecodeQZSSEphemeris(frame.data, frame.size))
+            decoded = true;
+          break;
+        case 1041:
+          if (DecodeNavICEphemeris(frame.data, frame.size))
+            decoded = true;
+          break;
+        case 1045:
+        case 1046:
+          if (DecodeGalileoEphemeris(frame.data, frame.size))
+            decoded = true;
+          break;
+        case 1042:
+          if (DecodeBDSEphemeris(frame.data, frame.size))
+            decoded = true;
+          break;
+        case 1007:
+        case 1008:
+        case 1033:
+          DecodeAntennaReceiver(frame.data, frame.size);
+          break;
+        case 1005:
+        case 1006:
+          DecodeAntennaPosition(frame.data, frame.size);
+          break;
+        case 1300:
+          DecodeServiceCRS(frame.data, frame.size);
+          break;
+        case 1301:
+          DecodeHelmertTrafoParameters(frame.data, frame.size);
+          break;
+        case 1302:
+        case 35:
+          DecodeRTCMCRS(frame.data, frame.size);
+          break;
       }
     }
   }
@@ -2323,60 +2289,7 @@ t_irc RTCM3Decoder::Decode(char* buffer, int bufLen, vector<string>& errmsg) {
 //
 ////////////////////////////////////////////////////////////////////////////
 uint32_t RTCM3Decoder::CRC24(long size, const unsigned char *buf) {
-  uint32_t crc = 0;
-  int ii;
-  while (size--) {
-    crc ^= (*buf++) << (16);
-    for (ii = 0; ii < 8; ii++) {
-      crc <<= 1;
-      if (crc & 0x1000000)
-        crc ^= 0x01864cfb;
-    }
-  }
-  return crc;
-}
-
-//
-////////////////////////////////////////////////////////////////////////////
-int RTCM3Decoder::GetMessage(void) {
-  unsigned char *m, *e;
-  int i;
-
-  m = _Message + _SkipBytes;
-  e = _Message + _MessageSize;
-  _NeedBytes = _SkipBytes = 0;
-  while (e - m >= 3) {
-    if (m[0] == 0xD3) {
-      _BlockSize = ((m[1] & 3) << 8) | m[2];
-      if (e - m >= static_cast<int>(_BlockSize + 6)) {
-        if (static_cast<uint32_t>((m[3 + _BlockSize] << 16)
-            | (m[3 + _BlockSize + 1] << 8)
-            | (m[3 + _BlockSize + 2])) == CRC24(_BlockSize + 3, m)) {
-          _BlockSize += 6;
-          _SkipBytes = _BlockSize;
-          break;
-        }
-        else
-          ++m;
-      }
-      else {
-        _NeedBytes = _BlockSize;
-        break;
-      }
-    }
-    else
-      ++m;
-  }
-  if (e - m < 3)
-    _NeedBytes = 3;
-
-  /* copy buffer to front */
-  i = m - _Message;
-  if (i && m < e)
-    memmove(_Message, m, static_cast<size_t>(_MessageSize - i));
-  _MessageSize -= i;
-
-  return !_NeedBytes ? ((_Message[3] << 4) | (_Message[4] >> 4)) : 0;
+  return static_cast<uint32_t>(::CRC24(size, buf));
 }
 
 // Time of Corrections
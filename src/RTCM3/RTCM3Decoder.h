@@ -31,6 +31,7 @@
 #include <stdint.h>
 #include "GPSDecoder.h"
 #include "RTCM3coDecoder.h"
+#include "RTCM3Framer.h"
 #include "crs.h"
 #include "bncrawfile.h"
 #include "ephemeris.h"
@@ -44,6 +45,7 @@ Q_OBJECT
   virtual int corrGPSEpochTime() const;
   /**
    * CRC24Q checksum calculation function (only full bytes supported).
+   * Uses the shared table-driven CRC24 from bncutils.
    * @param size Size of the passed data
    * @param buf Data buffer containing the data to checksum
    * @return the CRC24Q checksum of the data
@@ -59,20 +61,6 @@ Q_OBJECT
   void newBDSEph(t_ephBDS eph);
 
  private:
-  /**
-   * Extract a RTCM3 message. Data is passed in the follow fields:<br>
-   * {@link _Message}: contains the message bytes<br>
-   * {@link _MessageSize}: contains to current amount of bytes in the buffer<br>
-   * {@link _SkipBytes}: amount of bytes to skip at the beginning of the buffer
-   *
-   * The functions sets following variables:<br>
-   * {@link _NeedBytes}: Minimum number of bytes needed on next call<br>
-   * {@link _SkipBytes}: internal, Bytes to skip before next call (usually the amount of
-   *   found bytes)<br>
-   * {@link _MessageSize}: Updated size after processed bytes have been removed from buffer
-   * @return message number when message found, 0 otherwise
-   */
-  int GetMessage(void);
   /**
    * Extract data from old 1001-1004 RTCM3 messages.
    * @param buffer the buffer containing an 1001-1004 RTCM block
@@ -197,18 +185,8 @@ Q_OBJECT
   /** List of decoders for Clock and Orbit data */
   QMap<QByteArray, RTCM3coDecoder*> _coDecoders;
 
-  /** Message buffer for input parsing */
-  unsigned char _Message[2048];
-  /** Current size of the message buffer */
-  size_t _MessageSize;
-  /** Minimum bytes required to have success during next {@link GetMessage()} call */
-  size_t _NeedBytes;
-  /** Bytes to skip in next {@link GetMessage()} call, intrnal to that function */
-  size_t _SkipBytes;
-  /** Size of the current RTCM3 block beginning at buffer start after a successful
-   *  {@link GetMessage()} call
-   */
-  size_t _BlockSize;
+  /** Splits the input into RTCM3 frames */
+  RTCM3Framer _framer;
 
   /**
    * Current observation epoch. Used to link together blocks in one epoch.
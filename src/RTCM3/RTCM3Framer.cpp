@@ -0,0 +1,221 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      RTCM3Framer
+ *
+ * Purpose:    Extraction of RTCM3 transport frames from a byte stream
+ *             without copying the input into a message buffer
+ *
+ * Created:    16-Oct-2026
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include <algorithm>
+
+#include "RTCM3Framer.h"
+#include "bncutils.h"
+
+using namespace std;
+
+namespace {
+
+  // Frame size from the header, requires 3 bytes
+  inline size_t frameSize(const unsigned char* m) {
+    return (((m[1] & 3) << 8) | m[2]) + 6;
+  }
+
+  // CRC24Q stored behind the message equals the computed one
+  inline bool crcOk(const unsigned char* m, size_t size) {
+    const unsigned char* c = m + size - 3;
+    unsigned long crc = (c[0] << 16) | (c[1] << 8) | c[2];
+    return crc == CRC24(static_cast<long>(size - 3), m);
+  }
+
+  // Message number (12 bits following the header)
+  inline int frameType(const unsigned char* m) {
+    return (m[3] << 4) | (m[4] >> 4);
+  }
+}
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+RTCM3Framer::RTCM3Framer() {
+  _carry.reserve(MAXFRAMESIZE);
+  _in          = 0;
+  _inLen       = 0;
+  _inPos       = 0;
+  _carryFromIn = 0;
+  _carryFrame  = 0;
+}
+
+//
+////////////////////////////////////////////////////////////////////////////
+void RTCM3Framer::reset() {
+  _carry.clear();
+  _in          = 0;
+  _inLen       = 0;
+  _inPos       = 0;
+  _carryFromIn = 0;
+  _carryFrame  = 0;
+}
+
+//
+////////////////////////////////////////////////////////////////////////////
+void RTCM3Framer::feed(char* buffer, size_t bufLen) {
+  if (_carryFrame) {
+    _carry.erase(_carry.begin(), _carry.begin() + _carryFrame);
+    _carryFrame = 0;
+  }
+  if (_in) {
+    keepTail();
+  }
+  _in          = reinterpret_cast<unsigned char*>(buffer);
+  _inLen       = bufLen;
+  _inPos       = 0;
+  _carryFromIn = 0;
+}
+
+// Next frame: first the one started in a previous chunk, then frames
+// inside the current chunk
+////////////////////////////////////////////////////////////////////////////
+bool RTCM3Framer::next(t_frame& frame) {
+  if (_carryFrame) {
+    _carry.erase(_carry.begin(), _carry.begin() + _carryFrame);
+    _carryFrame = 0;
+  }
+
+  while (!_carry.empty()) {
+    int irc = nextFromCarry(frame);
+    if      (irc > 0) {
+      return true;
+    }
+    else if (irc == 0) {
+      _in = 0;
+      _inLen = _inPos = 0;
+      return false;
+    }
+  }
+
+  if (!_in) {
+    return false;
+  }
+
+  unsigned char* m = _in + _inPos;
+  unsigned char* e = _in + _inLen;
+  while (e - m >= 3) {
+    if (m[0] == 0xD3) {
+      size_t size = frameSize(m);
+      if (static_cast<size_t>(e - m) < size) {
+        break;
+      }
+      if (crcOk(m, size)) {
+        frame.data = m;
+        frame.size = size;
+        frame.type = frameType(m);
+        _inPos = (m - _in) + size;
+        return true;
+      }
+    }
+    ++m;
+  }
+  _inPos = m - _in;
+  keepTail();
+  return false;
+}
+
+// Completes the frame at the begin of the carry buffer.
+// Returns 1 if a frame is available, 0 if the input is exhausted,
+// -1 after a resynchronization (try again).
+////////////////////////////////////////////////////////////////////////////
+int RTCM3Framer::nextFromCarry(t_frame& frame) {
+
+  // Bytes left behind a frame returned from the carry buffer
+  // --------------------------------------------------------
+  if (_carry[0] != 0xD3) {
+    _carry.erase(_carry.begin(), find(_carry.begin(), _carry.end(), 0xD3));
+    return -1;
+  }
+
+  pull(3);
+  if (_carry.size() < 3) {
+    return 0;
+  }
+  size_t size = frameSize(&_carry[0]);
+  pull(size);
+  if (_carry.size() < size) {
+    return 0;
+  }
+
+  if (crcOk(&_carry[0], size)) {
+    frame.data  = &_carry[0];
+    frame.size  = size;
+    frame.type  = frameType(&_carry[0]);
+    _carryFrame = size;
+    _carryFromIn = 0;
+    return 1;
+  }
+
+  // Wrong preamble: give back the bytes of the current chunk, they are
+  // scanned in place, and search the next preamble in the remaining bytes
+  // ---------------------------------------------------------------------
+  _inPos -= _carryFromIn;
+  _carry.resize(_carry.size() - _carryFromIn);
+  _carryFromIn = 0;
+  vector<unsigned char>::iterator it = find(_carry.begin() + 1, _carry.end(), 0xD3);
+  _carry.erase(_carry.begin(), it);
+  return -1;
+}
+
+// Appends bytes of the current chunk until the carry buffer holds need bytes
+////////////////////////////////////////////////////////////////////////////
+void RTCM3Framer::pull(size_t need) {
+  if (!_in || _carry.size() >= need) {
+    return;
+  }
+  size_t num = min(need - _carry.size(), _inLen - _inPos);
+  _carry.insert(_carry.end(), _in + _inPos, _in + _inPos + num);
+  _inPos       += num;
+  _carryFromIn += num;
+}
+
+// Moves the unread part of the current chunk into the carry buffer,
+// leading bytes without preamble are dropped
+////////////////////////////////////////////////////////////////////////////
+void RTCM3Framer::keepTail() {
+  unsigned char* m = _in + _inPos;
+  unsigned char* e = _in + _inLen;
+  if (_carry.empty()) {
+    m = find(m, e, 0xD3);
+  }
+  _carry.insert(_carry.end(), m, e);
+  _in = 0;
+  _inLen = _inPos = 0;
+  _carryFromIn = 0;
+}
@@ -0,0 +1,87 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+#ifndef RTCM3FRAMER_H
+#define RTCM3FRAMER_H
+
+#include <stddef.h>
+#include <vector>
+
+/**
+ * Splits a byte stream into RTCM3 transport frames (preamble 0xD3, 10 bit
+ * message length, CRC24Q).
+ *
+ * Frames lying completely inside a chunk passed to {@link feed()} are
+ * returned as pointers into that chunk, nothing is copied. Only a frame cut
+ * at the end of a chunk is kept in a small carry buffer and completed with
+ * the first bytes of the next chunk. Consumed input is never moved.
+ */
+class RTCM3Framer {
+ public:
+  /** View of one frame, valid until the next call of {@link feed()} or {@link next()} */
+  struct t_frame {
+    unsigned char* data;   ///< frame start (preamble)
+    size_t         size;   ///< frame size including 3 bytes header and 3 bytes CRC
+    int            type;   ///< message number
+  };
+
+  /** Maximal frame size (1023 bytes message plus header and CRC) */
+  static const size_t MAXFRAMESIZE = 1029;
+
+  RTCM3Framer();
+
+  /**
+   * Sets the next chunk of input. The chunk must stay valid until
+   * {@link next()} returned false. Unread data of the previous chunk is
+   * kept in the carry buffer.
+   */
+  void feed(char* buffer, size_t bufLen);
+
+  /**
+   * Extracts the next frame with valid CRC. Bytes not belonging to a valid
+   * frame are skipped.
+   * @return false if more input is required
+   */
+  bool next(t_frame& frame);
+
+  /** Discards buffered data */
+  void reset();
+
+  /** Number of bytes kept from previous chunks */
+  size_t pending() const {return _carry.size();}
+
+ private:
+  int  nextFromCarry(t_frame& frame);
+  void pull(size_t need);
+  void keepTail();
+
+  unsigned char*             _in;          // current chunk
+  size_t                     _inLen;
+  size_t                     _inPos;       // first unread byte of the chunk
+  std::vector<unsigned char> _carry;       // incomplete frame from previous chunks
+  size_t                     _carryFromIn; // trailing bytes of _carry taken from the current chunk
+  size_t                     _carryFrame;  // size of the frame returned from _carry, erased on next call
+};
+
+#endif
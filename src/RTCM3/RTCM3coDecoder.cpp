@@ -168,41 +168,41 @@ t_irc RTCM3coDecoder::Decode(char* buffer, int bufLen, vector<string>& errmsg) {
 
   errmsg.clear();
 
-  _buffer.append(QByteArray(buffer,bufLen));
+  // Decode in place unless an incomplete message is left from the last call
+  // ------------------------------------------------------------------------
+  const char* data     = buffer;
+  int         size     = bufLen;
+  bool        buffered = !_buffer.isEmpty();
+  if (buffered) {
+    _buffer.append(buffer, bufLen);
+    data = _buffer.constData();
+    size = _buffer.size();
+  }
 
   t_irc retCode = failure;
+  int   pos     = 0;
 
-  while(_buffer.size()) {
-
-    struct SsrCorr::ClockOrbit clkOrbSav;
-    struct SsrCorr::CodeBias   codeBiasSav;
-    struct SsrCorr::PhaseBias  phaseBiasSav;
-    struct SsrCorr::VTEC       vTECSav;
-    memcpy(&clkOrbSav,     &_clkOrb,    sizeof(clkOrbSav)); // save state
-    memcpy(&codeBiasSav,   &_codeBias,  sizeof(codeBiasSav));
-    memcpy(&phaseBiasSav,  &_phaseBias, sizeof(phaseBiasSav));
-    memcpy(&vTECSav,       &_vTEC,      sizeof(vTECSav));
+  while (pos < size) {
 
     int bytesused = 0;
 
+    // GetSSR checks header, length and CRC before it writes to any of the
+    // correction structures, so an incomplete message leaves them untouched
+    // ----------------------------------------------------------------------
     GCOB_RETURN irc = _ssrCorr->GetSSR(&_clkOrb, &_codeBias, &_vTEC, &_phaseBias,
-                                       _buffer.data(), _buffer.size(), &bytesused);
+                                       data + pos, size - pos, &bytesused);
 
-    if      (irc <= -30) { // not enough data - restore state and exit loop
-      memcpy(&_clkOrb,    &clkOrbSav,    sizeof(clkOrbSav));
-      memcpy(&_codeBias,  &codeBiasSav,  sizeof(codeBiasSav));
-      memcpy(&_phaseBias, &phaseBiasSav, sizeof(phaseBiasSav));
-      memcpy(&_vTEC,      &vTECSav,      sizeof(vTECSav));
+    if      (irc <= -30) { // not enough data - keep the rest and exit loop
       break;
     }
 
     else if (irc < 0) {    // error  - skip 1 byte and retry
       reset();
-      _buffer = _buffer.mid(bytesused ? bytesused : 1);
+      pos += bytesused ? bytesused : 1;
     }
 
     else {                 // OK or MESSAGEFOLLOWS
-      _buffer = _buffer.mid(bytesused);
+      pos += bytesused;
 
       if (irc == GCOBR_OK || irc == GCOBR_MESSAGEFOLLOWS ) {
         setEpochTime(); // sets _lastTime
@@ -222,6 +222,15 @@ t_irc RTCM3coDecoder::Decode(char* buffer, int bufLen, vector<string>& errmsg) {
     }
   }
 
+  // Keep the unused rest
+  // --------------------
+  if (buffered) {
+    _buffer.remove(0, pos);
+  }
+  else if (pos < size) {
+    _buffer = QByteArray(data + pos, size - pos);
+  }
+
   return retCode;
 }
 
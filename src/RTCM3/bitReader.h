@@ -0,0 +1,215 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+#ifndef BITREADER_H
+#define BITREADER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Bounds-checked reader for big-endian bit fields (RTCM3 message body).
+ *
+ * Fields are extracted from a 64-bit big-endian word loaded at the current
+ * byte position, so a field of up to 57 bits costs one load and two shifts.
+ * Reading beyond the end returns 0 and clears {@link ok()}; callers check
+ * ok() once before they use the decoded values. Results are identical to
+ * the GETBITS family of macros in bits.h.
+ */
+class t_bitReader {
+ public:
+  t_bitReader(const unsigned char* data, int size) {
+    _data    = data;
+    _byteLen = size > 0 ? static_cast<size_t>(size) : 0;
+    _bitLen  = _byteLen * 8;
+    _bitPos  = 0;
+    _ok      = true;
+  }
+
+  /** false if any field exceeded the end of the data */
+  bool ok() const {return _ok;}
+
+  /** number of unread bits */
+  size_t bitsLeft() const {return _bitLen - _bitPos;}
+
+  /** unsigned field of n <= 64 bits */
+  uint64_t getBits(unsigned n) {
+    if (!reserve(n)) {
+      return 0;
+    }
+    uint64_t b = peek(_bitPos, n);
+    _bitPos += n;
+    return b;
+  }
+
+  /** two's complement field of n <= 64 bits */
+  int64_t getBitsSign(unsigned n) {
+    if (n == 0 || !reserve(n)) {
+      return 0;
+    }
+    int64_t b = static_cast<int64_t>(peek(_bitPos, n) << (64 - n)) >> (64 - n);
+    _bitPos += n;
+    return b;
+  }
+
+  /** unsigned field scaled by c */
+  double getFloat(unsigned n, double c) {
+    return static_cast<double>(getBits(n)) * c;
+  }
+
+  /** two's complement field scaled by c */
+  double getFloatSign(unsigned n, double c) {
+    return static_cast<double>(getBitsSign(n)) * c;
+  }
+
+  /** sign-magnitude field (sign bit first) scaled by c */
+  double getFloatSignM(unsigned n, double c) {
+    if (n == 0 || !reserve(n)) {
+      return 0.0;
+    }
+    bool     neg = peek(_bitPos, 1) != 0;
+    double   b   = static_cast<double>(peek(_bitPos + 1, n - 1)) * c;
+    _bitPos += n;
+    return neg ? -b : b;
+  }
+
+  void skipBits(unsigned n) {
+    if (reserve(n)) {
+      _bitPos += n;
+    }
+  }
+
+  /**
+   * MSM cell fields: for count = numCells-1 down to 0 with bit count set
+   * in cellMask one field of n <= 64 bits is stored to out[count], in
+   * message order. The bounds are checked once for the whole block.
+   */
+  template<class T>
+  void getCells(T* out, unsigned n, uint64_t cellMask, int numCells) {
+    if (!reserveCells(n, cellMask)) {
+      return;
+    }
+    for (int count = numCells; count--;) {
+      if (cellMask & (uint64_t(1) << count)) {
+        out[count] = static_cast<T>(peek(_bitPos, n));
+        _bitPos += n;
+      }
+    }
+  }
+
+  template<class T>
+  void getCellsFloat(T* out, unsigned n, double c, uint64_t cellMask, int numCells) {
+    if (!reserveCells(n, cellMask)) {
+      return;
+    }
+    for (int count = numCells; count--;) {
+      if (cellMask & (uint64_t(1) << count)) {
+        out[count] = static_cast<double>(peek(_bitPos, n)) * c;
+        _bitPos += n;
+      }
+    }
+  }
+
+  template<class T>
+  void getCellsFloatSign(T* out, unsigned n, double c, uint64_t cellMask, int numCells) {
+    if (!reserveCells(n, cellMask)) {
+      return;
+    }
+    for (int count = numCells; count--;) {
+      if (cellMask & (uint64_t(1) << count)) {
+        int64_t b = static_cast<int64_t>(peek(_bitPos, n) << (64 - n)) >> (64 - n);
+        out[count] = static_cast<double>(b) * c;
+        _bitPos += n;
+      }
+    }
+  }
+
+  /** skips one field of n bits per cell */
+  void skipCells(unsigned n, uint64_t cellMask) {
+    if (reserveCells(n, cellMask)) {
+      _bitPos += n * popCount(cellMask);
+    }
+  }
+
+ private:
+  bool reserve(size_t n) {
+    if (!_ok || n > _bitLen - _bitPos) {
+      _ok = false;
+      return false;
+    }
+    return true;
+  }
+
+  bool reserveCells(unsigned n, uint64_t cellMask) {
+    return reserve(n * popCount(cellMask)) && n > 0;
+  }
+
+  static size_t popCount(uint64_t mask) {
+    size_t num = 0;
+    for (; mask; mask &= (mask - 1)) {
+      ++num;
+    }
+    return num;
+  }
+
+  // Big-endian word starting at byte pos, missing bytes behind the end are 0
+  uint64_t word(size_t pos) const {
+    if (pos + 8 <= _byteLen) {
+      const unsigned char* p = _data + pos;
+      return (uint64_t(p[0]) << 56) | (uint64_t(p[1]) << 48)
+           | (uint64_t(p[2]) << 40) | (uint64_t(p[3]) << 32)
+           | (uint64_t(p[4]) << 24) | (uint64_t(p[5]) << 16)
+           | (uint64_t(p[6]) <<  8) |  uint64_t(p[7]);
+    }
+    uint64_t w = 0;
+    for (size_t ii = pos; ii < pos + 8; ii++) {
+      w <<= 8;
+      if (ii < _byteLen) {
+        w |= _data[ii];
+      }
+    }
+    return w;
+  }
+
+  // n bits at bit position pos, range already checked
+  uint64_t peek(size_t pos, unsigned n) const {
+    if (n == 0) {
+      return 0;
+    }
+    unsigned shift = pos & 7;
+    uint64_t w     = word(pos >> 3) << shift;
+    if (n + shift > 64) {
+      w |= word((pos >> 3) + 8) >> (64 - shift);
+    }
+    return w >> (64 - n);
+  }
+
+  const unsigned char* _data;
+  size_t               _byteLen;
+  size_t               _bitLen;
+  size_t               _bitPos;
+  bool                 _ok;
+};
+
+#endif
@@ -398,7 +398,9 @@ public:
   virtual size_t MakeVTEC(const struct VTEC *v, int moremessagesfollow,
       char *buffer, size_t size) = 0;
 
-  /* buffer should point to a RTCM3 block */
+  /* buffer should point to a RTCM3 block; a block not yet complete in the
+     buffer (GCOBR_SHORTBUFFER, GCOBR_MESSAGEEXCEEDSBUFFER) is detected before
+     any of co, b, v, pb is written, callers need not save them */
   virtual enum GCOB_RETURN GetSSR(struct ClockOrbit *co, struct CodeBias *b,
       struct VTEC *v, struct PhaseBias *pb, const char *buffer, size_t size,
       int *bytesused) = 0;
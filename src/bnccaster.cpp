@@ -52,8 +52,11 @@
 #include "bncrinex.h"
 #include "bnccore.h"
 #include "bncgetthread.h"
+#include "bncingestpool.h"
+#include "bncoutsockets.h"
 #include "bncutils.h"
 #include "bncsettings.h"
+#include "MQTT/mqttPublisher.h"
 
 using namespace std;
 
@@ -67,7 +70,7 @@ bncCaster::bncCaster() {
           BNC_CORE, SLOT(slotMessage(const QByteArray,bool)));
 
   _outFile = 0;
-  _out     = 0;
+  _epoBuffer.reserve(64 * 1024);
   reopenOutFile();
 
   int port = settings.value("outPort").toInt();
@@ -82,7 +85,7 @@ bncCaster::bncCaster() {
       emit newMessage(message.toLatin1(), true);
     }
     connect(_server, SIGNAL(newConnection()), this, SLOT(slotNewConnection()));
-    _sockets = new QList<QTcpSocket*>;
+    _sockets = newOutSockets("Sync port");
   }
   else {
     _server  = 0;
@@ -100,7 +103,7 @@ bncCaster::bncCaster() {
       emit newMessage(message.toLatin1(), true);
     }
     connect(_uServer, SIGNAL(newConnection()), this, SLOT(slotNewUConnection()));
-    _uSockets = new QList<QTcpSocket*>;
+    _uSockets = newOutSockets("Usync port");
   }
   else {
     _uServer  = 0;
@@ -114,6 +117,9 @@ bncCaster::bncCaster() {
     _outWait = 0.01;
   }
   _confInterval = -1;
+  _confTimer    = new QTimer(this);
+  _confTimer->setSingleShot(true);
+  connect(_confTimer, SIGNAL(timeout()), this, SLOT(slotReadMountPoints()));
 
   // Miscellaneous output port
   // -------------------------
@@ -129,12 +135,27 @@ bncCaster::bncCaster() {
       emit newMessage(message.toLatin1(), true);
     }
     connect(_miscServer, SIGNAL(newConnection()), this, SLOT(slotNewMiscConnection()));
-    _miscSockets = new QList<QTcpSocket*>;
+    _miscSockets = newOutSockets("Miscellaneous port");
   }
   else {
     _miscServer  = 0;
     _miscSockets = 0;
   }
+
+  // MQTT status publisher (started with the first mountpoint list)
+  // --------------------------------------------------------------
+  _mqttPublisher = 0;
+
+  // Event-driven stream input (pool of worker threads)
+  // --------------------------------------------------
+  if (Qt::CheckState(settings.value("ingestPool").toInt()) == Qt::Checked) {
+    _ingestPool = new bncIngestPool();
+    emit newMessage(QString("Ingest pool: %1 worker thread(s)")
+                    .arg(_ingestPool->numThreads()).toLatin1(), true);
+  }
+  else {
+    _ingestPool = 0;
+  }
 }
 
 // Destructor
@@ -152,8 +173,8 @@ bncCaster::~bncCaster() {
     _threads.removeAll(thread);
     thread->terminate();
   }
+  delete _ingestPool;
 
-  delete _out;
   delete _outFile;
   delete _server;
   delete _sockets;
@@ -161,58 +182,39 @@ bncCaster::~bncCaster() {
   delete _uSockets;
   delete _miscServer;
   delete _miscSockets;
+  delete _mqttPublisher;
 }
 
 // New Observations
 ////////////////////////////////////////////////////////////////////////////
-void bncCaster::slotNewObs(const QByteArray staID, QList<t_satObs> obsList) {
+void bncCaster::slotNewObs(const QByteArray staID, t_satObsBatch obsBatch) {
 
   QMutexLocker locker(&_mutex);
 
   reopenOutFile();
 
-  unsigned index = 0;
-  QMutableListIterator<t_satObs> it(obsList);
-  while (it.hasNext()) {
-    ++index;
-    t_satObs& obs = it.next();
+  string     staIDStr(staID.data());
+  QByteArray uOut;
 
-    // Rename the Station
-    // ------------------
-    obs._staID = staID.data();
+  for (int index = 0; index < obsBatch->size(); index++) {
+    const t_satObs& obs = obsBatch->at(index);
 
-    // Update/Set Slip Counters
-    // ------------------------
-    setSlipCounters(obs);
+    // Slip Counter (the shared observations are not modified)
+    // -------------------------------------------------------
+    int slipCnt = slipCounter(staIDStr, obs);
 
-    // Output into the socket
-    // ----------------------
-    if (_uSockets) {
-
-      ostringstream oStr;
-      oStr.setf(ios::showpoint | ios::fixed);
-      oStr << obs._staID                                        << " "
-           << setw(4)  << obs._time.gpsw()                      << " "
-           << setw(14) << setprecision(7) << obs._time.gpssec() << " "
-           << bncRinex::asciiSatLine(obs,_outLockTime) << endl;
-
-      string hlpStr = oStr.str();
-
-      QMutableListIterator<QTcpSocket*> is(*_uSockets);
-      while (is.hasNext()) {
-        QTcpSocket* sock = is.next();
-        if (sock->state() == QAbstractSocket::ConnectedState) {
-          int numBytes = hlpStr.length();
-          if (myWrite(sock, hlpStr.c_str(), numBytes) != numBytes) {
-            delete sock;
-            is.remove();
-          }
-        }
-        else if (sock->state() != QAbstractSocket::ConnectingState) {
-          delete sock;
-          is.remove();
-        }
-      }
+    // Output into the socket (collected, sent once per batch)
+    // -------------------------------------------------------
+    if (_uSockets && _uSockets->numClients() > 0) {
+
+      uOut.append(staID);
+      uOut.append(' ');
+      appendInt(uOut, obs._time.gpsw(), 4);
+      uOut.append(' ');
+      appendFixed(uOut, obs._time.gpssec(), 14, 7);
+      uOut.append(' ');
+      bncRinex::asciiSatLine(uOut, obs, _outLockTime, slipCnt);
+      uOut.append('\n');
     }
 
     // First time: set the _lastDumpTime
@@ -224,7 +226,7 @@ void bncCaster::slotNewObs(const QByteArray staID, QList<t_satObs> obsList) {
     // An old observation - throw it away
     // ----------------------------------
     if (obs._time <= _lastDumpTime) {
-      if (index == 1) {
+      if (index == 0) {
         bncSettings settings;
         if ( !settings.value("outFile").toString().isEmpty() ||
              !settings.value("outPort").toString().isEmpty() ) {
@@ -238,9 +240,14 @@ void bncCaster::slotNewObs(const QByteArray staID, QList<t_satObs> obsList) {
       continue;
     }
 
-    // Save the observation
-    // --------------------
-    _epochs[obs._time].append(obs);
+    // Save a reference to the observation
+    // -----------------------------------
+    t_epoObs epoObs;
+    epoObs._batch       = obsBatch;
+    epoObs._index       = index;
+    epoObs._staID       = staID;
+    epoObs._slipCounter = slipCnt;
+    _epochs[obs._time].append(epoObs);
 
     // Dump Epochs
     // -----------
@@ -249,20 +256,55 @@ void bncCaster::slotNewObs(const QByteArray staID, QList<t_satObs> obsList) {
       _lastDumpTime = obs._time - _outWait;
     }
   }
+
+  if (_uSockets) {
+    _uSockets->write(uOut);
+  }
+}
+
+// Route object of a station: receivers connected to its newObs signal get
+// the observations of this station only (e.g. one PPP rover each), so the
+// cost per batch does not grow with the number of receivers of the others
+////////////////////////////////////////////////////////////////////////////
+bncObsRoute* bncCaster::obsRoute(const QByteArray& staID) {
+  QWriteLocker locker(&_routeLock);
+  bncObsRoute* route = _obsRoutes.value(staID, 0);
+  if (!route) {
+    route = new bncObsRoute;
+    route->moveToThread(thread()); // may be called from a PPP thread
+    route->setParent(this);
+    _obsRoutes[staID] = route;
+  }
+  return route;
+}
+
+// Forward observations to the route of the station (called directly in the
+// thread of the emitting bncGetThread, route objects live as long as the
+// caster)
+////////////////////////////////////////////////////////////////////////////
+void bncCaster::slotRouteObs(QByteArray staID, t_satObsBatch obsBatch) {
+  bncObsRoute* route = 0;
+  {
+    QReadLocker locker(&_routeLock);
+    route = _obsRoutes.value(staID, 0);
+  }
+  if (route) {
+    emit route->newObs(staID, obsBatch);
+  }
 }
 
 // New Connection
 ////////////////////////////////////////////////////////////////////////////
 void bncCaster::slotNewConnection() {
-  _sockets->push_back( _server->nextPendingConnection() );
+  _sockets->addSocket( _server->nextPendingConnection() );
   emit( newMessage(QString("New client connection on sync port: # %1")
-                   .arg(_sockets->size()).toLatin1(), true) );
+                   .arg(_sockets->numClients()).toLatin1(), true) );
 }
 
 void bncCaster::slotNewUConnection() {
-  _uSockets->push_back( _uServer->nextPendingConnection() );
+  _uSockets->addSocket( _uServer->nextPendingConnection() );
   emit( newMessage(QString("New client connection on usync port: # %1")
-                   .arg(_uSockets->size()).toLatin1(), true) );
+                   .arg(_uSockets->numClients()).toLatin1(), true) );
 }
 
 // Add New Thread
@@ -271,12 +313,17 @@ void bncCaster::addGetThread(bncGetThread* getThread, bool noNewThread) {
 
   qRegisterMetaType<t_satObs>("t_satObs");
   qRegisterMetaType< QList<t_satObs> >("QList<t_satObs>");
+  qRegisterMetaType<t_satObsBatch>("t_satObsBatch");
+
+  connect(getThread, SIGNAL(newObs(QByteArray, t_satObsBatch)),
+          this,      SLOT(slotNewObs(QByteArray, t_satObsBatch)));
 
-  connect(getThread, SIGNAL(newObs(QByteArray, QList<t_satObs>)),
-          this,      SLOT(slotNewObs(QByteArray, QList<t_satObs>)));
+  connect(getThread, SIGNAL(newObs(QByteArray, t_satObsBatch)),
+          this,      SIGNAL(newObs(QByteArray, t_satObsBatch)));
 
-  connect(getThread, SIGNAL(newObs(QByteArray, QList<t_satObs>)),
-          this,      SIGNAL(newObs(QByteArray, QList<t_satObs>)));
+  connect(getThread, SIGNAL(newObs(QByteArray, t_satObsBatch)),
+          this,      SLOT(slotRouteObs(QByteArray, t_satObsBatch)),
+          Qt::DirectConnection);
 
   connect(getThread, SIGNAL(newRawData(QByteArray, QByteArray)),
           this,      SLOT(slotNewRawData(QByteArray, QByteArray)));
@@ -284,13 +331,20 @@ void bncCaster::addGetThread(bncGetThread* getThread, bool noNewThread) {
   connect(getThread, SIGNAL(getThreadFinished(QByteArray)),
           this, SLOT(slotGetThreadFinished(QByteArray)));
 
+  connect(getThread, SIGNAL(ingestFinished()),
+          this, SLOT(slotIngestFinished()));
+
+  if (_mqttPublisher) {
+    _mqttPublisher->addGetThread(getThread);
+  }
+
   _staIDs.push_back(getThread->staID());
   _threads.push_back(getThread);
 
   if (noNewThread) {
     getThread->run();
   }
-  else {
+  else if (!_ingestPool || !_ingestPool->addStream(getThread)) {
     getThread->start();
   }
 }
@@ -316,63 +370,66 @@ void bncCaster::slotGetThreadFinished(QByteArray staID) {
 
 }
 
+// Stream of the ingest pool gave up: remove it from the list, then let the
+// pool delete it (the object may already be gone if it was removed before)
+////////////////////////////////////////////////////////////////////////////
+void bncCaster::slotIngestFinished() {
+  QObject* obj = sender();
+  QListIterator<bncGetThread*> it(_threads);
+  while (it.hasNext()) {
+    bncGetThread* thread = it.next();
+    if (thread == obj) {
+      _threads.removeOne(thread);
+      thread->terminate();
+      return;
+    }
+  }
+}
+
 // Dump Complete Epochs
 ////////////////////////////////////////////////////////////////////////////
 void bncCaster::dumpEpochs(const bncTime& maxTime) {
 
-  QMutableMapIterator<bncTime, QList<t_satObs> > itEpo(_epochs);
+  QMutableMapIterator<bncTime, QList<t_epoObs> > itEpo(_epochs);
   while (itEpo.hasNext()) {
     itEpo.next();
     const bncTime& epoTime = itEpo.key();
     if (epoTime <= maxTime) {
-      const QList<t_satObs>& allObs = itEpo.value();
+      const QList<t_epoObs>& allObs = itEpo.value();
       int sec = int(nint(epoTime.gpssec()*10));
-      if ( (_out || _sockets) && (sec % (_samplingRateMult10) == 0) ) {
-        QListIterator<t_satObs> it(allObs);
-        bool firstObs = true;
+      if ( (_outFile || _sockets) && (sec % (_samplingRateMult10) == 0) &&
+           !allObs.isEmpty() ) {
+
+        // Format the whole epoch into the reused buffer
+        // ---------------------------------------------
+        _epoBuffer.resize(0);
+        _epoBuffer.append("> ");
+        appendInt(_epoBuffer, epoTime.gpsw(), 0);
+        _epoBuffer.append(' ');
+        appendFixed(_epoBuffer, epoTime.gpssec(), 0, 7);
+        _epoBuffer.append('\n');
+        QListIterator<t_epoObs> it(allObs);
         while (it.hasNext()) {
-          const t_satObs& obs = it.next();
-
-          ostringstream oStr;
-          oStr.setf(ios::showpoint | ios::fixed);
-          if (firstObs) {
-            firstObs = false;
-            oStr << "> " << obs._time.gpsw() << ' '
-                 << setprecision(7) << obs._time.gpssec() << endl;
-          }
-          oStr << obs._staID << ' '
-               << bncRinex::asciiSatLine(obs,_outLockTime) << endl;
-          if (!it.hasNext()) {
-            oStr << endl;
-          }
-          string hlpStr = oStr.str();
-
-          // Output into the File
-          // --------------------
-          if (_out) {
-            *_out << hlpStr.c_str();
-            _out->flush();
-          }
-
-          // Output into the socket
-          // ----------------------
-          if (_sockets) {
-            QMutableListIterator<QTcpSocket*> is(*_sockets);
-            while (is.hasNext()) {
-              QTcpSocket* sock = is.next();
-              if (sock->state() == QAbstractSocket::ConnectedState) {
-                int numBytes = hlpStr.length();
-                if (myWrite(sock, hlpStr.c_str(), numBytes) != numBytes) {
-                  delete sock;
-                  is.remove();
-                }
-              }
-              else if (sock->state() != QAbstractSocket::ConnectingState) {
-                delete sock;
-                is.remove();
-              }
-            }
-          }
+          const t_epoObs& epoObs = it.next();
+          _epoBuffer.append(epoObs._staID);
+          _epoBuffer.append(' ');
+          bncRinex::asciiSatLine(_epoBuffer, epoObs.obs(), _outLockTime,
+                                 epoObs._slipCounter);
+          _epoBuffer.append('\n');
+        }
+        _epoBuffer.append('\n');
+
+        // Output into the File (flushed once per epoch)
+        // ---------------------------------------------
+        if (_outFile) {
+          _outFile->write(_epoBuffer);
+          _outFile->flush();
+        }
+
+        // Output into the sockets (formatted once for all clients)
+        // --------------------------------------------------------
+        if (_sockets) {
+          _sockets->write(_epoBuffer);
         }
       }
        //_epochs.remove(epoTime);
@@ -406,6 +463,15 @@ void bncCaster::readMountPoints() {
     _outWait = 0.01;
   }
 
+  // Start the MQTT status publisher
+  // --------------------------------
+  if (!_mqttPublisher && MqttPublisher::isConfigured()) {
+    _mqttPublisher = new MqttPublisher();
+    connect(_mqttPublisher, SIGNAL(reReadRequested()),
+            this, SLOT(slotReadMountPoints()), Qt::QueuedConnection);
+    _mqttPublisher->start();
+  }
+
   // Add new mountpoints
   // -------------------
   int iMount = -1;
@@ -465,6 +531,9 @@ void bncCaster::readMountPoints() {
 
     if (!existFlg) {
       disconnect(thread, 0, 0, 0);
+      if (_mqttPublisher) {
+        _mqttPublisher->removeStation(thread->staID());
+      }
       _staIDs.removeAll(thread->staID());
       _threads.removeAll(thread);
       thread->terminate();
@@ -477,6 +546,7 @@ void bncCaster::readMountPoints() {
   // (Re-) Start the configuration timer
   // -----------------------------------
   if      (settings.value("onTheFlyInterval").toString() == "no") {
+    _confTimer->stop();
     return;
   }
 
@@ -510,19 +580,21 @@ void bncCaster::readMountPoints() {
     }
   }
 
-  QTimer::singleShot(ms, this, SLOT(slotReadMountPoints()));
+  _confTimer->start(ms);
 }
 
-//
+// Output port clients with bounded send queues
 ////////////////////////////////////////////////////////////////////////////
-int bncCaster::myWrite(QTcpSocket* sock, const char* buf, int bufLen) {
-  sock->write(buf, bufLen);
-  for (int ii = 1; ii <= 10; ii++) {
-    if (sock->waitForBytesWritten(10)) {  // wait 10 ms
-      return bufLen;
-    }
-  }
-  return -1;
+bncOutSockets* bncCaster::newOutSockets(const QString& portName) {
+
+  bncSettings settings;
+
+  bncOutSockets* sockets = new bncOutSockets(portName);
+  sockets->setQueueLimit(settings.value("outQueueSize").toLongLong() * 1024,
+        bncOutSockets::policyFromString(settings.value("outQueuePolicy").toString()));
+  connect(sockets, SIGNAL(newMessage(QByteArray,bool)),
+          this,    SIGNAL(newMessage(QByteArray,bool)));
+  return sockets;
 }
 
 //
@@ -535,7 +607,6 @@ void bncCaster::reopenOutFile() {
   if ( !outFileName.isEmpty() ) {
     expandEnvVar(outFileName);
     if (!_outFile || _outFile->fileName() != outFileName) {
-      delete _out;
       delete _outFile;
       _outFile = new QFile(outFileName);
       if ( Qt::CheckState(settings.value("rnxAppend").toInt()) == Qt::Checked) {
@@ -544,12 +615,9 @@ void bncCaster::reopenOutFile() {
       else {
         _outFile->open(QIODevice::WriteOnly);
       }
-      _out = new QTextStream(_outFile);
-      _out->setRealNumberNotation(QTextStream::FixedNotation);
     }
   }
   else {
-    delete _out;     _out     = 0;
     delete _outFile; _outFile = 0;
   }
 }
@@ -558,35 +626,25 @@ void bncCaster::reopenOutFile() {
 ////////////////////////////////////////////////////////////////////////////
 void bncCaster::slotNewRawData(QByteArray staID, QByteArray data) {
   if (_miscSockets && (_miscMount == "ALL" || _miscMount == staID)) {
-    QMutableListIterator<QTcpSocket*> is(*_miscSockets);
-    while (is.hasNext()) {
-      QTcpSocket* sock = is.next();
-      if (sock->state() == QAbstractSocket::ConnectedState) {
-        sock->write(data);
-      }
-      else if (sock->state() != QAbstractSocket::ConnectingState) {
-        delete sock;
-        is.remove();
-      }
-    }
+    _miscSockets->write(data);
   }
 }
 
 // New Connection
 ////////////////////////////////////////////////////////////////////////////
 void bncCaster::slotNewMiscConnection() {
-  _miscSockets->push_back( _miscServer->nextPendingConnection() );
+  _miscSockets->addSocket( _miscServer->nextPendingConnection() );
   emit( newMessage(QString("New client connection on Miscellaneous Output Port: # %1")
-                   .arg(_miscSockets->size()).toLatin1(), true) );
+                   .arg(_miscSockets->numClients()).toLatin1(), true) );
 }
 
-// Set/Update Slip Counters
+// Update the Slip Counter of a Satellite (-1: no lock times available)
 ////////////////////////////////////////////////////////////////////////////
-void bncCaster::setSlipCounters(t_satObs& obs) {
+int bncCaster::slipCounter(const string& staID, const t_satObs& obs) {
 
   double minLockTime = -1.0;
   for (unsigned ii = 0; ii < obs._obs.size(); ii++) {
-    const t_frqObs* frqObs = obs._obs[ii];
+    const t_frqObs* frqObs = &obs._obs[ii];
     if (frqObs->_lockTimeValid) {
       if (minLockTime == -1.0 || minLockTime < frqObs->_lockTime) {
         minLockTime = frqObs->_lockTime;
@@ -595,11 +653,11 @@ void bncCaster::setSlipCounters(t_satObs& obs) {
   }
 
   if (minLockTime == -1.0) {
-    return;
+    return -1;
   }
 
-  QMap<t_prn, double>& ltMap = _lockTimeMap[obs._staID];
-  QMap<t_prn, int>&    jcMap = _jumpCounterMap[obs._staID];
+  QMap<t_prn, double>& ltMap = _lockTimeMap[staID];
+  QMap<t_prn, int>&    jcMap = _jumpCounterMap[staID];
   QMap<t_prn, double>::const_iterator it = ltMap.find(obs._prn);
   if (it == ltMap.end()) { // init satellite
     ltMap[obs._prn] = minLockTime;
@@ -614,8 +672,5 @@ void bncCaster::setSlipCounters(t_satObs& obs) {
     }
     ltMap[obs._prn] = minLockTime;
   }
-  for (unsigned ii = 0; ii < obs._obs.size(); ii++) {
-    t_frqObs* frqObs = obs._obs[ii];
-    frqObs->_slipCounter = jcMap[obs._prn];
-  }
+  return jcMap[obs._prn];
 }
@@ -30,10 +30,24 @@
 #include <QTcpServer>
 #include <QTcpSocket>
 #include <QNetworkProxy>
+#include <QReadWriteLock>
+#include <QTimer>
 
 #include "satObs.h"
 
 class bncGetThread;
+class MqttPublisher;
+class bncIngestPool;
+class bncOutSockets;
+
+// Observations of a single station (see bncCaster::obsRoute)
+////////////////////////////////////////////////////////////////////////////
+class bncObsRoute : public QObject {
+ Q_OBJECT
+
+ signals:
+   void newObs(QByteArray staID, t_satObsBatch obsBatch);
+};
 
 class bncCaster : public QObject {
  Q_OBJECT
@@ -44,9 +58,11 @@ class bncCaster : public QObject {
    void addGetThread(bncGetThread* getThread, bool noNewThread = false);
    int  numStations() const {return _staIDs.size();}
    void readMountPoints();
+   bncObsRoute* obsRoute(const QByteArray& staID);
 
  public slots:
-   void slotNewObs(QByteArray staID, QList<t_satObs> obsList);
+   void slotNewObs(QByteArray staID, t_satObsBatch obsBatch);
+   void slotRouteObs(QByteArray staID, t_satObsBatch obsBatch);
    void slotNewRawData(QByteArray staID, QByteArray data);
    void slotNewMiscConnection();
 
@@ -54,28 +70,39 @@ class bncCaster : public QObject {
    void mountPointsRead(QList<bncGetThread*>);
    void getThreadsFinished();
    void newMessage(QByteArray msg, bool showOnScreen);
-   void newObs(QByteArray staID, QList<t_satObs> obsList);
+   void newObs(QByteArray staID, t_satObsBatch obsBatch);
 
    private slots:
    void slotReadMountPoints();
    void slotNewConnection();
    void slotNewUConnection();
    void slotGetThreadFinished(QByteArray staID);
+   void slotIngestFinished();
 
  private:
+   // Observation in a shared batch plus the caster's own annotations
+   class t_epoObs {
+    public:
+     const t_satObs& obs() const {return _batch->at(_index);}
+     t_satObsBatch _batch;
+     int           _index;
+     QByteArray    _staID;
+     int           _slipCounter; // -1: keep the decoder's slip counters
+   };
+
    void dumpEpochs(const bncTime& maxTime);
-   static int myWrite(QTcpSocket* sock, const char* buf, int bufLen);
+   bncOutSockets* newOutSockets(const QString& portName);
    void reopenOutFile();
-   void setSlipCounters(t_satObs& obs);
+   int  slipCounter(const std::string& staID, const t_satObs& obs);
 
    QFile*                          _outFile;
-   QTextStream*                    _out;
-   QMap<bncTime, QList<t_satObs> > _epochs;
+   QByteArray                      _epoBuffer;  // one formatted sync epoch
+   QMap<bncTime, QList<t_epoObs> > _epochs;
    bncTime                         _lastDumpTime;
    QTcpServer*                     _server;
    QTcpServer*                     _uServer;
-   QList<QTcpSocket*>*             _sockets;
-   QList<QTcpSocket*>*             _uSockets;
+   bncOutSockets*                  _sockets;
+   bncOutSockets*                  _uSockets;
    QList<QByteArray>               _staIDs;
    QList<bncGetThread*>            _threads;
    bool                            _outLockTime;
@@ -83,12 +110,17 @@ class bncCaster : public QObject {
    double                          _outWait;
    QMutex                          _mutex;
    int                             _confInterval;
+   QTimer*                         _confTimer;
    QString                         _miscMount;
    int                             _miscPort;
    QTcpServer*                     _miscServer;
-   QList<QTcpSocket*>*             _miscSockets;
+   bncOutSockets*                  _miscSockets;
    QMap<std::string, QMap<t_prn, double> > _lockTimeMap;
    QMap<std::string, QMap<t_prn, int> >    _jumpCounterMap;
+   MqttPublisher*                  _mqttPublisher;
+   QReadWriteLock                  _routeLock;
+   QHash<QByteArray, bncObsRoute*> _obsRoutes;
+   bncIngestPool*                  _ingestPool;
 };
 
 #endif
@@ -53,6 +53,7 @@
 #include <QTime>
 
 #include "bncgetthread.h"
+#include "bncingestpool.h"
 #include "bnctabledlg.h"
 #include "bnccore.h"
 #include "bncutils.h"
@@ -68,6 +69,7 @@
 #include "bncsettings.h"
 #include "bncwindow.h"
 #include "latencychecker.h"
+#include "MQTT/jsonMessage.h"
 #include "upload/bncrtnetdecoder.h"
 #include "RTCM/RTCM2Decoder.h"
 #include "RTCM3/RTCM3Decoder.h"
@@ -131,9 +133,11 @@ void bncGetThread::initialize() {
 
   _isToBeDeleted = false;
   _query = 0;
+  _ingestStream = 0;
   _nextSleep = 0;
   _miscMount = settings.value("miscMount").toString();
   _decoder = 0;
+  _nTypesCounted = 0;
 
   // NMEA Port
   // -----------
@@ -415,6 +419,13 @@ void bncGetThread::terminate() {
     delete _nmeaSockets;
   }
 
+  // Streams served by the ingest pool are deleted in their worker thread
+  // --------------------------------------------------------------------
+  if (_ingestStream) {
+    QMetaObject::invokeMethod(_ingestStream, "stop", Qt::QueuedConnection);
+    return;
+  }
+
 #ifdef BNC_DEBUG
   if (BNC_CORE->mode() != t_bncCore::interactive) {
     while (!isFinished()) {
@@ -432,6 +443,19 @@ void bncGetThread::terminate() {
 
 }
 
+// Can the stream be served by the ingest pool instead of its own thread?
+// (plain TCP with NTRIP Version 1 or without NTRIP, no serial/NMEA ports)
+////////////////////////////////////////////////////////////////////////////
+bool bncGetThread::ingestCapable() const {
+  if (_rawFile || _serialPort || _nmeaServer || _nmea == "yes") {
+    return false;
+  }
+  return _ntripVersion == "N" ||
+        (_ntripVersion != "U"  && _ntripVersion != "R"  &&
+         _ntripVersion != "S"  && _ntripVersion != "UN" &&
+         _ntripVersion != "2"  && _ntripVersion != "2s");
+}
+
 // Run
 ////////////////////////////////////////////////////////////////////////////
 void bncGetThread::run() {
@@ -446,25 +470,9 @@ void bncGetThread::run() {
       }
 
       if (tryReconnect() != success) {
-        if (_latencyChecker) {
-          _latencyChecker->checkReconnect();
-        }
         continue;
       }
 
-      // Delete old observations
-      // -----------------------
-      if (_rawFile) {
-        QMapIterator<QString, GPSDecoder*> itDec(_decodersRaw);
-        while (itDec.hasNext()) {
-          itDec.next();
-          GPSDecoder* decoder = itDec.value();
-          decoder->_obsList.clear();
-        }
-      } else {
-        _decoder->_obsList.clear();
-      }
-
       // Read Data
       // ---------
       QByteArray data;
@@ -486,234 +494,315 @@ void bncGetThread::run() {
         }
       }
 
-      qint64 nBytes = data.size();
-
       // Timeout, reconnect
       // ------------------
-      if (nBytes == 0) {
-        if (_latencyChecker) {
-          _latencyChecker->checkReconnect();
-        }
-        emit(newMessage(_staID + ": Data timeout, reconnecting", true));
+      if (data.size() == 0) {
+        reportTimeout();
         msleep(10000); //sleep 10 sec, G. Weber
-        // MQTT消息新增
-        emit sigStaTimeout(_staID);
         continue;
-      } else {
-        emit newBytes(_staID, nBytes);
-        emit newRawData(_staID, data);
-        // MQTT消息新增
-        emit sigUpdateThroughput(_staID, int(nBytes));
       }
 
-      // Output Data
-      // -----------
-      if (_rawOutput) {
-        BNC_CORE->writeRawData(data, _staID, _format);
-      }
+      processData(data);
+    }
+    catch (...) {
+      handleException();
+    }
+  }
+}
 
-      if (_serialPort) {
-        slotSerialReadyRead();
-        _serialPort->write(data);
-      }
+// Process one chunk of received data (decode and emit the results)
+////////////////////////////////////////////////////////////////////////////
+void bncGetThread::processData(QByteArray& data) {
 
-      // Decode Data
-      // -----------
-      vector<string> errmsg;
-      if (!decoder()) {
-        _isToBeDeleted = true;
-        continue;
-      }
+  // Delete old observations
+  // -----------------------
+  if (_rawFile) {
+    QMapIterator<QString, GPSDecoder*> itDec(_decodersRaw);
+    while (itDec.hasNext()) {
+      itDec.next();
+      GPSDecoder* decoder = itDec.value();
+      decoder->_obsList.clear();
+    }
+  } else if (_decoder) {
+    _decoder->_obsList.clear();
+  }
 
-      t_irc irc = decoder()->Decode(data.data(), data.size(), errmsg);
+  qint64 nBytes = data.size();
+  emit newBytes(_staID, nBytes);
+  emit newRawData(_staID, data);
+  // MQTT消息新增
+  if (_statusSlot) {
+    _statusSlot->updateThroughput(int(nBytes));
+  }
+  emit sigUpdateThroughput(_staID, int(nBytes));
 
-      if (irc != success) {
-        continue;
-      }
-      // Perform various scans and checks
-      // --------------------------------
-      if (_latencyChecker) {
-        _latencyChecker->checkOutage(irc);
-        QListIterator<int> it(decoder()->_typeList);
-        _ssrEpoch = static_cast<int>(decoder()->corrGPSEpochTime());
-        if (_ssrEpoch != -1) {
-          if (_rtcmSsrOrb) {
-            _latencyChecker->checkCorrLatency(_ssrEpoch, 1057);
-            _rtcmSsrOrb = false;
-          }
-          if (_rtcmSsrClk) {
-            _latencyChecker->checkCorrLatency(_ssrEpoch, 1058);
-            _rtcmSsrClk = false;
-          }
-          if (_rtcmSsrOrbClk) {
-            _latencyChecker->checkCorrLatency(_ssrEpoch, 1060);
-            _rtcmSsrOrbClk = false;
-          }
-          if (_rtcmSsrCbi) {
-            _latencyChecker->checkCorrLatency(_ssrEpoch, 1059);
-            _rtcmSsrCbi = false;
-          }
-          if (_rtcmSsrPbi) {
-            _latencyChecker->checkCorrLatency(_ssrEpoch, 1265);
-            _rtcmSsrPbi = false;
-          }
-          if (_rtcmSsrVtec) {
-            _latencyChecker->checkCorrLatency(_ssrEpoch, 1264);
-            _rtcmSsrVtec = false;
-          }
-          if (_rtcmSsrUra) {
-            _latencyChecker->checkCorrLatency(_ssrEpoch, 1061);
-            _rtcmSsrUra = false;
-          }
-          if (_rtcmSsrHr) {
-            _latencyChecker->checkCorrLatency(_ssrEpoch, 1062);
-            _rtcmSsrHr = false;
-          }
-          if (_rtcmSsrIgs) {
-            _latencyChecker->checkCorrLatency(_ssrEpoch, 4076);
-            _rtcmSsrIgs = false;
-          }
-        }
-        while (it.hasNext()) {
-          int rtcmType = it.next();
-          if ((rtcmType >= 1001 && rtcmType <= 1004) || // legacy RTCM OBS
-              (rtcmType >= 1009 && rtcmType <= 1012) || // legacy RTCM OBS
-              (rtcmType >= 1070 && rtcmType <= 1137)) { // MSM RTCM OBS
-            _rtcmObs = true;
-          } else if ((rtcmType >= 1057 && rtcmType <= 1068) ||
-                     (rtcmType >= 1240 && rtcmType <= 1270) ||
-					           (rtcmType == 4076)) {
-            switch (rtcmType) {
-              case 1057: case 1063: case 1240: case 1246: case 1252: case 1258:
-                _rtcmSsrOrb = true;
-                break;
-              case 1058: case 1064: case 1241: case 1247: case 1253: case 1259:
-                _rtcmSsrClk = true;
-                break;
-              case 1060: case 1066: case 1243: case 1249: case 1255: case 1261:
-                _rtcmSsrOrbClk = true;
-                break;
-              case 1059: case 1065: case 1242: case 1248: case 1254: case 1260:
-                _rtcmSsrCbi = true;
-                break;
-              case 1265: case 1266: case 1267: case 1268: case 1269: case 1270:
-                _rtcmSsrPbi = true;
-                break;
-              case 1264:
-                _rtcmSsrVtec = true;
-                break;
-              case 1061: case 1067: case 1244: case 1250: case 1256: case 1262:
-                _rtcmSsrUra = true;
-                break;
-              case 1062: case 1068: case 1245: case 1251: case 1257: case 1263:
-                _rtcmSsrHr = true;
-                break;
-              case 4076:
-            	_rtcmSsrIgs = true;
-            	break;
-            }
-          }
-        }
-        if (_rtcmObs) {
-          _latencyChecker->checkObsLatency(decoder()->_obsList);
-        }
-        emit newLatency(_staID, _latencyChecker->currentLatency());
-        // MQTT消息新增
-        emit sigUpdateLatency(_staID, _latencyChecker->currentLatency());
-      }
-      miscScanRTCM();
-
-      // Loop over all observations (observations output)
-      // ------------------------------------------------
-      QListIterator<t_satObs> it(decoder()->_obsList);
-
-      QList<t_satObs> obsListHlp;
-
-      while (it.hasNext()) {
-        const t_satObs& obs = it.next();
-
-        // Check observation epoch
-        // -----------------------
-        if (!_rawFile) {
-          bool wrongObservationEpoch = checkForWrongObsEpoch(obs._time);
-          if (wrongObservationEpoch) {
-            QString prn(obs._prn.toString().c_str());
-            QString type = QString("%1").arg(obs._type);
-            emit(newMessage(_staID + " (" + prn.toLatin1() + ")" + ": Wrong observation epoch(s)" + "( MT: " + type.toLatin1() + ")", false));
-            continue;
-          }
-        }
+  // Output Data
+  // -----------
+  if (_rawOutput) {
+    BNC_CORE->writeRawData(data, _staID, _format);
+  }
 
-        // Check observations coming twice (e.g. KOUR0 Problem)
-        // ----------------------------------------------------
-        if (!_rawFile) {
-          QString prn(obs._prn.toString().c_str());
-          bncTime obsTime = obs._time;
-          QMap<QString, bncTime>::const_iterator it = _prnLastEpo.find(prn);
-          if (it != _prnLastEpo.end()) {
-            bncTime oldTime = it.value();
-            if (obsTime < oldTime) {
-              emit(newMessage(_staID + ": old observation " + prn.toLatin1(), false));
-              continue;
-            } else if (obsTime == oldTime) {
-              emit(newMessage(_staID + ": observation coming more than once " + prn.toLatin1(), false));
-              continue;
-            }
-          }
-          _prnLastEpo[prn] = obsTime;
-        }
+  if (_serialPort) {
+    slotSerialReadyRead();
+    _serialPort->write(data);
+  }
 
-        decoder()->dumpRinexEpoch(obs, _format);
+  // Decode Data
+  // -----------
+  vector<string> errmsg;
+  if (!decoder()) {
+    _isToBeDeleted = true;
+    return;
+  }
 
-        // Save observations
-        // -----------------
-        obsListHlp.append(obs);
-      }
+  t_irc irc = decoder()->Decode(data.data(), data.size(), errmsg);
 
-      // Emit signal
-      // -----------
-      if (!_isToBeDeleted && obsListHlp.size() > 0) {
-        emit newObs(_staID, obsListHlp);
-      }
+  // MQTT消息新增：按消息类型计数（_typeList 只在解码成功后清空，只统计新增部分）
+  if (_statusSlot) {
+    const QList<int>& typeList = decoder()->_typeList;
+    const QList<int>& sizeList = decoder()->_typeSizeList;
+    for (int ii = _nTypesCounted; ii < typeList.size(); ii++) {
+      _statusSlot->addMessageType(typeList[ii], ii < sizeList.size() ? sizeList[ii] : 0);
+    }
+    _statusSlot->addMessages(typeList.size() - _nTypesCounted);
+    _nTypesCounted = typeList.size();
+  }
 
+  if (irc != success) {
+    return;
+  }
+  // Perform various scans and checks
+  // --------------------------------
+  if (_latencyChecker) {
+    _latencyChecker->checkOutage(irc);
+    QListIterator<int> it(decoder()->_typeList);
+    _ssrEpoch = static_cast<int>(decoder()->corrGPSEpochTime());
+    if (_ssrEpoch != -1) {
+      if (_rtcmSsrOrb) {
+        _latencyChecker->checkCorrLatency(_ssrEpoch, 1057);
+        _rtcmSsrOrb = false;
+      }
+      if (_rtcmSsrClk) {
+        _latencyChecker->checkCorrLatency(_ssrEpoch, 1058);
+        _rtcmSsrClk = false;
+      }
+      if (_rtcmSsrOrbClk) {
+        _latencyChecker->checkCorrLatency(_ssrEpoch, 1060);
+        _rtcmSsrOrbClk = false;
+      }
+      if (_rtcmSsrCbi) {
+        _latencyChecker->checkCorrLatency(_ssrEpoch, 1059);
+        _rtcmSsrCbi = false;
+      }
+      if (_rtcmSsrPbi) {
+        _latencyChecker->checkCorrLatency(_ssrEpoch, 1265);
+        _rtcmSsrPbi = false;
+      }
+      if (_rtcmSsrVtec) {
+        _latencyChecker->checkCorrLatency(_ssrEpoch, 1264);
+        _rtcmSsrVtec = false;
+      }
+      if (_rtcmSsrUra) {
+        _latencyChecker->checkCorrLatency(_ssrEpoch, 1061);
+        _rtcmSsrUra = false;
+      }
+      if (_rtcmSsrHr) {
+        _latencyChecker->checkCorrLatency(_ssrEpoch, 1062);
+        _rtcmSsrHr = false;
+      }
+      if (_rtcmSsrIgs) {
+        _latencyChecker->checkCorrLatency(_ssrEpoch, 4076);
+        _rtcmSsrIgs = false;
+      }
     }
-    catch (Exception& exc) {
-      emit(newMessage(_staID + " " + exc.what(), true));
-      // MQTT消息新增
-      emit sigStaError(_staID, QString(exc.what()));
-      _isToBeDeleted = true;
+    while (it.hasNext()) {
+      int rtcmType = it.next();
+      if ((rtcmType >= 1001 && rtcmType <= 1004) || // legacy RTCM OBS
+          (rtcmType >= 1009 && rtcmType <= 1012) || // legacy RTCM OBS
+          (rtcmType >= 1070 && rtcmType <= 1137)) { // MSM RTCM OBS
+        _rtcmObs = true;
+      } else if ((rtcmType >= 1057 && rtcmType <= 1068) ||
+                 (rtcmType >= 1240 && rtcmType <= 1270) ||
+					           (rtcmType == 4076)) {
+        switch (rtcmType) {
+          case 1057: case 1063: case 1240: case 1246: case 1252: case 1258:
+            _rtcmSsrOrb = true;
+            break;
+          case 1058: case 1064: case 1241: case 1247: case 1253: case 1259:
+            _rtcmSsrClk = true;
+            break;
+          case 1060: case 1066: case 1243: case 1249: case 1255: case 1261:
+            _rtcmSsrOrbClk = true;
+            break;
+          case 1059: case 1065: case 1242: case 1248: case 1254: case 1260:
+            _rtcmSsrCbi = true;
+            break;
+          case 1265: case 1266: case 1267: case 1268: case 1269: case 1270:
+            _rtcmSsrPbi = true;
+            break;
+          case 1264:
+            _rtcmSsrVtec = true;
+            break;
+          case 1061: case 1067: case 1244: case 1250: case 1256: case 1262:
+            _rtcmSsrUra = true;
+            break;
+          case 1062: case 1068: case 1245: case 1251: case 1257: case 1263:
+            _rtcmSsrHr = true;
+            break;
+          case 4076:
+        	_rtcmSsrIgs = true;
+        	break;
+        }
+      }
     }
-    catch (std::exception& exc) {
-      emit(newMessage(_staID + " " + exc.what(), true));
-      // MQTT消息新增
-      emit sigStaError(_staID, QString(exc.what()));
-      _isToBeDeleted = true;
+    if (_rtcmObs) {
+      _latencyChecker->checkObsLatency(decoder()->_obsList);
     }
-    catch (const string& error) {
-      emit(newMessage(_staID + " ERROR: " + error.c_str(), true));
-      // MQTT消息新增
-      emit sigStaError(_staID, QString(error.c_str()));
-      _isToBeDeleted = true;
+    emit newLatency(_staID, _latencyChecker->currentLatency());
+    // MQTT消息新增
+    if (_statusSlot) {
+      _statusSlot->updateLatency(_latencyChecker->currentLatency());
     }
-    catch (const char* error) {
-      emit(newMessage(_staID + " ERROR: " + error, true));
-      // MQTT消息新增
-      emit sigStaError(_staID, QString(error));
-      _isToBeDeleted = true;
+    emit sigUpdateLatency(_staID, _latencyChecker->currentLatency());
+  }
+  miscScanRTCM();
+
+  // Loop over all observations (observations output)
+  // ------------------------------------------------
+  QListIterator<t_satObs> it(decoder()->_obsList);
+
+  QList<t_satObs> obsListHlp;
+
+  while (it.hasNext()) {
+    const t_satObs& obs = it.next();
+
+    // Check observation epoch
+    // -----------------------
+    if (!_rawFile) {
+      bool wrongObservationEpoch = checkForWrongObsEpoch(obs._time);
+      if (wrongObservationEpoch) {
+        QString prn(obs._prn.toString().c_str());
+        QString type = QString("%1").arg(obs._type);
+        emit(newMessage(_staID + " (" + prn.toLatin1() + ")" + ": Wrong observation epoch(s)" + "( MT: " + type.toLatin1() + ")", false));
+        continue;
+      }
     }
-    catch (QString error) {
-      emit(newMessage(_staID + " ERROR: " + error.toStdString().c_str(), true));
-      // MQTT消息新增
-      emit sigStaError(_staID, error);
-      _isToBeDeleted = true;
+
+    // Check observations coming twice (e.g. KOUR0 Problem)
+    // ----------------------------------------------------
+    if (!_rawFile) {
+      QString prn(obs._prn.toString().c_str());
+      bncTime obsTime = obs._time;
+      QMap<QString, bncTime>::const_iterator it = _prnLastEpo.find(prn);
+      if (it != _prnLastEpo.end()) {
+        bncTime oldTime = it.value();
+        if (obsTime < oldTime) {
+          emit(newMessage(_staID + ": old observation " + prn.toLatin1(), false));
+          continue;
+        } else if (obsTime == oldTime) {
+          emit(newMessage(_staID + ": observation coming more than once " + prn.toLatin1(), false));
+          continue;
+        }
+      }
+      _prnLastEpo[prn] = obsTime;
     }
-    catch (...) {
-      emit(newMessage(_staID + " bncGetThread: unknown exception", true));
-      // MQTT消息新增
-      emit sigStaError(_staID, QString("bncGetThread: unknown exception"));
-      _isToBeDeleted = true;
+
+    decoder()->dumpRinexEpoch(obs, _format);
+
+    // Save observations
+    // -----------------
+    obsListHlp.append(obs);
+  }
+
+  // MQTT消息新增：解码出的历元数
+  if (_statusSlot && !obsListHlp.isEmpty()) {
+    int nEpochs = 0;
+    bncTime lastEpoch;
+    for (int ii = 0; ii < obsListHlp.size(); ii++) {
+      if (ii == 0 || obsListHlp[ii]._time != lastEpoch) {
+        lastEpoch = obsListHlp[ii]._time;
+        nEpochs++;
+      }
     }
+    _statusSlot->addEpochs(nEpochs);
+  }
+
+  // Emit signal (one shared batch for all consumers)
+  // ------------------------------------------------
+  if (!_isToBeDeleted && obsListHlp.size() > 0) {
+    emit newObs(_staID, t_satObsBatch(new QList<t_satObs>(obsListHlp)));
+  }
+
+}
+
+// Data timeout (the caller reconnects after a pause)
+////////////////////////////////////////////////////////////////////////////
+void bncGetThread::reportTimeout() {
+  if (_latencyChecker) {
+    _latencyChecker->checkReconnect();
   }
+  emit(newMessage(_staID + ": Data timeout, reconnecting", true));
+  // MQTT消息新增
+  if (_statusSlot) {
+    _statusSlot->setTimeout();
+  }
+  emit sigStaTimeout(_staID);
+}
+
+// Connection to the caster failed
+////////////////////////////////////////////////////////////////////////////
+void bncGetThread::reportDisconnected() {
+  // MQTT消息新增
+  if (_statusSlot) {
+    _statusSlot->setDisconnected();
+  }
+  emit sigStaDisconnected(_staID);
+  if (_latencyChecker) {
+    _latencyChecker->checkReconnect();
+  }
+}
+
+// Report the exception being handled, the stream is to be deleted
+// (must be called from within a catch block)
+////////////////////////////////////////////////////////////////////////////
+void bncGetThread::handleException() {
+  QByteArray msg;
+  QString    reason;
+  try {
+    throw;
+  }
+  catch (Exception& exc) {
+    msg    = _staID + " " + exc.what();
+    reason = QString(exc.what());
+  }
+  catch (std::exception& exc) {
+    msg    = _staID + " " + exc.what();
+    reason = QString(exc.what());
+  }
+  catch (const string& error) {
+    msg    = _staID + " ERROR: " + error.c_str();
+    reason = QString(error.c_str());
+  }
+  catch (const char* error) {
+    msg    = _staID + " ERROR: " + error;
+    reason = QString(error);
+  }
+  catch (QString error) {
+    msg    = _staID + " ERROR: " + error.toStdString().c_str();
+    reason = error;
+  }
+  catch (...) {
+    msg    = _staID + " bncGetThread: unknown exception";
+    reason = QString("bncGetThread: unknown exception");
+  }
+
+  emit(newMessage(msg, true));
+  // MQTT消息新增
+  if (_statusSlot) {
+    _statusSlot->setError(reason);
+  }
+  emit sigStaError(_staID, reason);
+  _isToBeDeleted = true;
 }
 
 // Try Re-Connect
@@ -802,8 +891,7 @@ t_irc bncGetThread::tryReconnect() {
     }
 
     if (_query->status() != bncNetQuery::running) {
-      // MQTT消息新增
-      emit sigStaDisconnected(_staID);
+      reportDisconnected();
       return failure;
     }
   }
@@ -848,9 +936,9 @@ void bncGetThread::miscScanRTCM() {
         QVector<QString>& rnxTypes = _rnxTypes[obs._prn.system()];
         bool allFound = true;
         for (unsigned iFrq = 0; iFrq < obs._obs.size(); iFrq++) {
-          if (obs._obs[iFrq]->_codeValid) {
+          if (obs._obs[iFrq]._codeValid) {
             QString rnxStr('C');
-            rnxStr.append(obs._obs[iFrq]->_rnxType2ch.c_str());
+            rnxStr.append(obs._obs[iFrq]._rnxType2ch.c_str());
             if (_format.indexOf("RTCM_2") != -1
                 || _format.indexOf("RTCM2") != -1
                 || _format.indexOf("RTCM 2") != -1) {
@@ -861,9 +949,9 @@ void bncGetThread::miscScanRTCM() {
               allFound = false;
             }
           }
-          if (obs._obs[iFrq]->_phaseValid) {
+          if (obs._obs[iFrq]._phaseValid) {
             QString rnxStr('L');
-            rnxStr.append(obs._obs[iFrq]->_rnxType2ch.c_str());
+            rnxStr.append(obs._obs[iFrq]._rnxType2ch.c_str());
             if (_format.indexOf("RTCM_2") != -1
                 || _format.indexOf("RTCM2") != -1
                 || _format.indexOf("RTCM 2") != -1) {
@@ -874,9 +962,9 @@ void bncGetThread::miscScanRTCM() {
               allFound = false;
             }
           }
-          if (obs._obs[iFrq]->_dopplerValid) {
+          if (obs._obs[iFrq]._dopplerValid) {
             QString rnxStr('D');
-            rnxStr.append(obs._obs[iFrq]->_rnxType2ch.c_str());
+            rnxStr.append(obs._obs[iFrq]._rnxType2ch.c_str());
             if (_format.indexOf("RTCM_2") != -1
                 || _format.indexOf("RTCM2") != -1
                 || _format.indexOf("RTCM 2") != -1) {
@@ -887,9 +975,9 @@ void bncGetThread::miscScanRTCM() {
               allFound = false;
             }
           }
-          if (obs._obs[iFrq]->_snrValid) {
+          if (obs._obs[iFrq]._snrValid) {
             QString rnxStr('S');
-            rnxStr.append(obs._obs[iFrq]->_rnxType2ch.c_str());
+            rnxStr.append(obs._obs[iFrq]._rnxType2ch.c_str());
             if (_format.indexOf("RTCM_2") != -1
                 || _format.indexOf("RTCM2") != -1
                 || _format.indexOf("RTCM 2") != -1) {
@@ -1060,6 +1148,8 @@ void bncGetThread::miscScanRTCM() {
 
   decoder()->_gloFrq.clear();
   decoder()->_typeList.clear();
+  decoder()->_typeSizeList.clear();
+  _nTypesCounted = 0;
   decoder()->_antType.clear();
   decoder()->_recType.clear();
   decoder()->_antList.clear();
@@ -30,6 +30,7 @@
 #include <QFile>
 #include <QTcpServer>
 #include <QUrl>
+#include <QSharedPointer>
 
 #include "bncconst.h"
 #include "bncnetquery.h"
@@ -41,6 +42,8 @@
 class GPSDecoder;
 class QextSerialPort;
 class latencyChecker;
+class StationSlot;
+class bncIngestStream;
 
 class bncGetThread : public QThread
 {
@@ -75,17 +78,28 @@ public:
     QByteArray latitude() const { return _latitude; }
     QByteArray longitude() const { return _longitude; }
     QByteArray ntripVersion() const { return _ntripVersion; }
+    void setStatusSlot(const QSharedPointer<StationSlot>& statusSlot) { _statusSlot = statusSlot; }
+
+    // Event-driven operation in the ingest pool (see bncIngestPool)
+    bool ingestCapable() const;
+    void setIngestStream(bncIngestStream* stream) { _ingestStream = stream; }
+    bool isToBeDeleted() const { return _isToBeDeleted; }
+    void processData(QByteArray& data);
+    void reportTimeout();
+    void reportDisconnected();
+    void handleException();
 
 signals:
     void newBytes(QByteArray staID, double nbyte);
     void newRawData(QByteArray staID, QByteArray data);
     void newLatency(QByteArray staID, double clate);
-    void newObs(QByteArray staID, QList<t_satObs> obsList);
+    void newObs(QByteArray staID, t_satObsBatch obsBatch);
     void newAntCrd(QByteArray staID, double xx, double yy, double zz,
                    double hh, QByteArray antType);
     void newMessage(QByteArray msg, bool showOnScreen);
     void newRTCMMessage(QByteArray staID, int msgID);
     void getThreadFinished(QByteArray staID);
+    void ingestFinished(); // stream of the ingest pool is to be deleted
 
     // MQTT消息新增
     void sigUpdateLatency(const QByteArray& staID, double latency);
@@ -156,6 +170,9 @@ private:
     QList<QTcpSocket*>* _nmeaSockets;
     QMap<QByteArray, int> _nmeaPortsMap;
     QTcpServer* _nmeaServer;
+    QSharedPointer<StationSlot> _statusSlot;
+    int _nTypesCounted;
+    bncIngestStream* _ingestStream;
 };
 
 #endif
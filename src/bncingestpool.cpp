@@ -0,0 +1,404 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      bncIngestPool, bncIngestStream
+ *
+ * Purpose:    Event-driven stream input: a small fixed pool of worker
+ *             threads multiplexes the NTRIP Version 1 and plain TCP
+ *             streams instead of one bncGetThread per mountpoint. Each
+ *             stream keeps its bncGetThread object (decoder state and
+ *             signals), only the blocking read loop is replaced.
+ *
+ * Created:    16-Oct-2026
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include "bncingestpool.h"
+#include "bncgetthread.h"
+#include "bnccore.h"
+#include "bncsettings.h"
+#include "bncnetqueryv1.h"
+
+using namespace std;
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+bncIngestStream::bncIngestStream(bncGetThread* getThread, QAtomicInt* load) {
+  _getThread     = getThread;
+  _load          = load;
+  _socket        = 0;
+  _state         = idle;
+  _ntripV0       = (getThread->ntripVersion() == "N");
+  _timeOut       = _ntripV0 ? 120000 : 20000;
+  _nextSleep     = 0;
+  _proxyResponse = false;
+
+  _timer = new QTimer(this);
+  _timer->setSingleShot(true);
+  connect(_timer, SIGNAL(timeout()), this, SLOT(slotTimeout()));
+
+  connect(this,     SIGNAL(newMessage(QByteArray,bool)),
+          BNC_CORE, SLOT(slotMessage(const QByteArray,bool)));
+}
+
+// Destructor
+////////////////////////////////////////////////////////////////////////////
+bncIngestStream::~bncIngestStream() {
+  _load->deref();
+}
+
+// Start (in the worker thread)
+////////////////////////////////////////////////////////////////////////////
+void bncIngestStream::start() {
+  connectToCaster();
+}
+
+// Stop and delete the stream (requested by bncGetThread::terminate)
+////////////////////////////////////////////////////////////////////////////
+void bncIngestStream::stop() {
+  if (!_getThread) {
+    return;
+  }
+  emit newMessage(_getThread->staID() + ": is to be deleted", true);
+  finish();
+}
+
+// Connect the socket
+////////////////////////////////////////////////////////////////////////////
+void bncIngestStream::connectToCaster() {
+
+  closeSocket();
+
+  QUrl url = _getThread->mountPoint();
+  if (url.scheme().isEmpty()) {
+    url.setScheme("http");
+  }
+  if (url.path().isEmpty()) {
+    url.setPath("/");
+  }
+
+  _socket = new QTcpSocket(this);
+  connect(_socket, SIGNAL(connected()),    this, SLOT(slotConnected()));
+  connect(_socket, SIGNAL(readyRead()),    this, SLOT(slotReadyRead()));
+  connect(_socket, SIGNAL(disconnected()), this, SLOT(slotDisconnected()));
+  connect(_socket, SIGNAL(error(QAbstractSocket::SocketError)),
+          this,    SLOT(slotDisconnected()));
+
+  _state = connecting;
+  _timer->start(_timeOut);
+
+  bncSettings settings;
+  QString proxyHost = settings.value("proxyHost").toString();
+  int     proxyPort = settings.value("proxyPort").toInt();
+  if (_ntripV0 || proxyHost.isEmpty()) {
+    _socket->connectToHost(url.host(), url.port());
+  }
+  else {
+    _socket->connectToHost(proxyHost, proxyPort);
+  }
+}
+
+// Connected, send the request (NTRIP Version 1)
+////////////////////////////////////////////////////////////////////////////
+void bncIngestStream::slotConnected() {
+  if (!_ntripV0) {
+    bncSettings settings;
+    QUrl url = _getThread->mountPoint();
+    if (url.path().isEmpty()) {
+      url.setPath("/");
+    }
+    _socket->write(bncNetQueryV1::requestString(url,
+                            settings.value("proxyHost").toString(), ""));
+  }
+  _proxyResponse = false;
+  _response.clear();
+  _state = response;
+  _timer->start(_timeOut);
+}
+
+// New data
+////////////////////////////////////////////////////////////////////////////
+void bncIngestStream::slotReadyRead() {
+
+  if (_state == response && !readResponse()) {
+    return;
+  }
+  if (_state != streaming) {
+    return;
+  }
+
+  QByteArray data = _socket->readAll();
+  if (data.isEmpty()) {
+    return;
+  }
+  _timer->start(_timeOut);
+  _nextSleep = 0;
+
+  try {
+    _getThread->processData(data);
+  }
+  catch (...) {
+    _getThread->handleException();
+  }
+
+  // The caster removes the stream from its list and then stops it, the
+  // bncGetThread object must not be deleted before
+  // -------------------------------------------------------------------
+  if (_getThread->isToBeDeleted()) {
+    _timer->stop();
+    closeSocket();
+    emit _getThread->ingestFinished();
+  }
+}
+
+// Read the caster response, returns true as soon as the data start
+////////////////////////////////////////////////////////////////////////////
+bool bncIngestStream::readResponse() {
+
+  // Without NTRIP the first line is skipped
+  // ---------------------------------------
+  if (_ntripV0) {
+    if (!_socket->canReadLine()) {
+      return false;
+    }
+    _socket->readLine();
+    _state = streaming;
+    return true;
+  }
+
+  bool complete = false;
+  while (_socket->canReadLine()) {
+    QString line = _socket->readLine();
+
+    if (line.indexOf("ICY 200 OK") == -1 &&
+        line.indexOf("HTTP")       != -1 &&
+        line.indexOf("200 OK")     != -1 ) {
+      _proxyResponse = true;
+    }
+
+    if (!_proxyResponse && !line.trimmed().isEmpty()) {
+      _response.push_back(line);
+    }
+
+    if (line.trimmed().isEmpty()) {
+      if (_proxyResponse) {
+        _proxyResponse = false;
+        continue;
+      }
+      complete = true;
+      break;
+    }
+
+    if (line.indexOf("Unauthorized") != -1) {
+      complete = true;
+      break;
+    }
+
+    if (!_proxyResponse                   &&
+        line.indexOf("200 OK")      != -1 &&
+        line.indexOf("SOURCETABLE") == -1) {
+      _response.clear();
+      if (_socket->canReadLine()) {
+        _socket->readLine();
+      }
+      _state = streaming;
+      return true;
+    }
+  }
+
+  // Wait for further lines
+  // ----------------------
+  if (!complete) {
+    return false;
+  }
+
+  if (_response.size() > 0) {
+    connectionFailed(_getThread->staID() + ": Wrong caster response\n"
+                     + _response.join("").toLatin1());
+    return false;
+  }
+  _state = streaming;
+  return true;
+}
+
+// Socket closed or failed
+////////////////////////////////////////////////////////////////////////////
+void bncIngestStream::slotDisconnected() {
+  if (!_socket) {
+    return;
+  }
+  if (_state == streaming) {
+    streamLost();
+  }
+  else {
+    QString errStr = _socket->errorString();
+    connectionFailed(_getThread->staID() + ": " + errStr.toLatin1());
+  }
+}
+
+// Timer: reconnect or timeout
+////////////////////////////////////////////////////////////////////////////
+void bncIngestStream::slotTimeout() {
+  if      (_state == idle) {
+    connectToCaster();
+  }
+  else if (_state == streaming) {
+    streamLost();
+  }
+  else if (_state == connecting) {
+    connectionFailed(_getThread->staID() + ": Connect timeout, reconnecting");
+  }
+  else {
+    connectionFailed(_getThread->staID() + ": Response timeout");
+  }
+}
+
+// Connection attempt failed, reconnect with increasing delay
+////////////////////////////////////////////////////////////////////////////
+void bncIngestStream::connectionFailed(const QByteArray& msg) {
+  closeSocket();
+  emit newMessage(msg, true);
+  _getThread->reportDisconnected();
+  reconnectLater(0);
+}
+
+// Data timeout or connection lost while streaming
+////////////////////////////////////////////////////////////////////////////
+void bncIngestStream::streamLost() {
+  closeSocket();
+  _getThread->reportTimeout();
+  reconnectLater(10000);
+}
+
+// Same delays as bncGetThread::tryReconnect (1, 2, 4, ... 256 sec)
+////////////////////////////////////////////////////////////////////////////
+void bncIngestStream::reconnectLater(int ms) {
+  ms += 1000 * _nextSleep;
+  if (_nextSleep == 0) {
+    _nextSleep = 1;
+  }
+  else {
+    _nextSleep = 2 * _nextSleep;
+    if (_nextSleep > 256) {
+      _nextSleep = 256;
+    }
+  }
+  _state = idle;
+  _timer->start(ms);
+}
+
+//
+////////////////////////////////////////////////////////////////////////////
+void bncIngestStream::closeSocket() {
+  if (_socket) {
+    disconnect(_socket, 0, this, 0);
+    _socket->abort();
+    _socket->deleteLater();
+    _socket = 0;
+  }
+  _state = idle;
+}
+
+// Delete the stream together with its bncGetThread object
+////////////////////////////////////////////////////////////////////////////
+void bncIngestStream::finish() {
+  _timer->stop();
+  closeSocket();
+  _getThread->setIngestStream(0);
+  _getThread->deleteLater();
+  _getThread = 0;
+  deleteLater();
+}
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+bncIngestPool::bncIngestPool(int numThreads) {
+  _numThreads = numThreads > 0 ? numThreads : QThread::idealThreadCount();
+  if (_numThreads < 1) {
+    _numThreads = 1;
+  }
+  _loads = new QAtomicInt[_numThreads];
+}
+
+// Destructor
+////////////////////////////////////////////////////////////////////////////
+bncIngestPool::~bncIngestPool() {
+  for (int ii = 0; ii < _workers.size(); ii++) {
+    // pending stop requests are processed first, the deferred deletions
+    // of the streams when the thread finishes
+    QMetaObject::invokeMethod(_contexts[ii], [](){}, Qt::BlockingQueuedConnection);
+    _workers[ii]->quit();
+    _workers[ii]->wait();
+    delete _contexts[ii];
+    delete _workers[ii];
+  }
+  delete [] _loads;
+}
+
+// Start the worker threads (on demand)
+////////////////////////////////////////////////////////////////////////////
+void bncIngestPool::startWorkers() {
+  for (int ii = 0; ii < _numThreads; ii++) {
+    QThread* worker  = new QThread;
+    QObject* context = new QObject;
+    context->moveToThread(worker);
+    worker->start();
+    _workers.push_back(worker);
+    _contexts.push_back(context);
+  }
+}
+
+// Serve the stream by the least loaded worker thread
+////////////////////////////////////////////////////////////////////////////
+bool bncIngestPool::addStream(bncGetThread* getThread) {
+
+  if (!getThread->ingestCapable()) {
+    return false;
+  }
+  if (_workers.isEmpty()) {
+    startWorkers();
+  }
+
+  int iBest = 0;
+  for (int ii = 1; ii < _numThreads; ii++) {
+    if (_loads[ii].loadAcquire() < _loads[iBest].loadAcquire()) {
+      iBest = ii;
+    }
+  }
+  _loads[iBest].ref();
+
+  bncIngestStream* stream = new bncIngestStream(getThread, &_loads[iBest]);
+  getThread->setIngestStream(stream);
+  getThread->moveToThread(_workers[iBest]);
+  stream->moveToThread(_workers[iBest]);
+  QMetaObject::invokeMethod(stream, "start", Qt::QueuedConnection);
+
+  return true;
+}
@@ -0,0 +1,101 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+#ifndef BNCINGESTPOOL_H
+#define BNCINGESTPOOL_H
+
+#include <QAtomicInt>
+#include <QList>
+#include <QStringList>
+#include <QTcpSocket>
+#include <QThread>
+#include <QTimer>
+#include <QUrl>
+
+class bncGetThread;
+
+// One stream served event-driven by a worker thread of the ingest pool
+////////////////////////////////////////////////////////////////////////////
+class bncIngestStream : public QObject {
+ Q_OBJECT
+
+ public:
+  bncIngestStream(bncGetThread* getThread, QAtomicInt* load);
+  ~bncIngestStream();
+
+ public slots:
+  void start();
+  void stop();
+
+ signals:
+  void newMessage(QByteArray msg, bool showOnScreen);
+
+ private slots:
+  void slotConnected();
+  void slotReadyRead();
+  void slotDisconnected();
+  void slotTimeout();
+
+ private:
+  enum t_state {idle, connecting, response, streaming};
+
+  void connectToCaster();
+  bool readResponse();
+  void connectionFailed(const QByteArray& msg);
+  void streamLost();
+  void reconnectLater(int ms);
+  void closeSocket();
+  void finish();
+
+  bncGetThread* _getThread;
+  QAtomicInt*   _load;
+  QTcpSocket*   _socket;
+  QTimer*       _timer;        // connect/response/data timeout, reconnect delay
+  t_state       _state;
+  bool          _ntripV0;
+  int           _timeOut;
+  int           _nextSleep;
+  bool          _proxyResponse;
+  QStringList   _response;
+};
+
+// Fixed pool of worker threads multiplexing all capable streams
+////////////////////////////////////////////////////////////////////////////
+class bncIngestPool {
+ public:
+  bncIngestPool(int numThreads = 0);
+  ~bncIngestPool();
+  bool addStream(bncGetThread* getThread);
+  int  numThreads() const {return _numThreads;}
+
+ private:
+  void startWorkers();
+
+  int              _numThreads;
+  QList<QThread*>  _workers;
+  QList<QObject*>  _contexts;
+  QAtomicInt*      _loads;
+};
+
+#endif
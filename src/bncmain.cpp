@@ -155,6 +155,7 @@ int main(int argc, char* argv[]) {
       "   onTheFlyInterval {Configuration reload interval [character string: no|1 day|1 hour|5 min|1 min]}\n"
       "   autoStart        {Auto start [integer number: 0=no,2=yes]}\n"
       "   rawOutFile       {Raw output file, full path [character string]}\n"
+      "   ingestPool       {Serve NTRIP Version 1 and TCP streams by a pool of worker threads [integer number: 0=no,2=yes]}\n"
       "\n"
       "RINEX Observations Panel keys:\n"
       "   rnxPath        {Directory for RINEX files [character string]}\n"
@@ -228,6 +229,8 @@ int main(int argc, char* argv[]) {
       "   outSampl {Sampling rate [character string: 0.1 sec|1 sec|5 sec|10 sec|15 sec|30 sec|60 sec]}\n"
       "   outFile  {Output file, full path [character string]}\n"
       "   outUPort {Output port, unsynchronized [integer number]}\n"
+      "   outQueueSize   {Send queue per client in kB [integer number]}\n"
+      "   outQueuePolicy {Full send queue [character string: drop oldest|disconnect]}\n"
       "\n"
       "Serial Output Panel:\n"
       "   serialMountPoint         {Mountpoint [character string]}\n"
@@ -254,6 +257,27 @@ int main(int argc, char* argv[]) {
       "   miscScanRTCM {Scan for RTCM message numbers [integer number: 0=no,2=yes]}\n"
       "   miscPort     {Output port [integer number]}\n"
       "\n"
+      "MQTT Config Panel keys:\n"
+      "   mqttHost          {MQTT broker host, name or IP address [character string]}\n"
+      "   mqttPort          {MQTT broker port [integer number]}\n"
+      "   mqttTopic         {Topic for station status messages [character string]}\n"
+      "   mqttUser          {MQTT user name [character string]}\n"
+      "   mqttPwd           {MQTT password [character string]}\n"
+      "   mqttNodeId        {Unique node/client identifier [character string]}\n"
+      "   mqttSendInterval  {Station status publishing interval in seconds [integer number]}\n"
+      "   mqttDelta         {Publish snapshots plus delta messages [integer number: 0=no,2=yes]}\n"
+      "   mqttFullInterval  {Snapshot interval in delta mode in seconds [integer number]}\n"
+      "   mqttRtcmTypes     {Publish RTCM message type counters on <topic>/rtcm [integer number: 0=no,2=yes]}\n"
+      "   mqttQueueSize     {Maximum number of messages buffered while disconnected [integer number]}\n"
+      "   mqttQueueFile     {Memory-mapped file for buffering messages while disconnected, full path [character string]}\n"
+      "   mqttDrainRate     {Rate for publishing buffered messages after reconnect in messages per second [integer number]}\n"
+      "   mqttEvents        {Publish station status transitions immediately on <topic>/event [integer number: 0=no,2=yes]}\n"
+      "   mqttEventInterval {Minimum interval between two events of one station in seconds [integer number]}\n"
+      "   mqttFormat        {Payload encoding [character string: JSON|CBOR]}\n"
+      "   mqttCommands      {Accept commands on <topic>/cmd and reply on <topic>/response [integer number: 0=no,2=yes]}\n"
+      "   mqttData          {Publish observations on <topic>/obs/<staID> and PPP positions on <topic>/ppp/<staID> [integer number: 0=no,2=yes]}\n"
+      "   mqttDataBuffer    {Maximum backlog of unsent data output before epochs are dropped in kB [integer number]}\n"
+      "\n"
       "PPP Client Panel 1 keys:\n"
       "   PPP/dataSource  {Data source [character string: Blank|Real-Time Streams|RINEX Files]}\n"
       "   PPP/rinexObs    {RINEX observation file, full path [character string]}\n"
@@ -296,6 +320,8 @@ int main(int argc, char* argv[]) {
       "   PPP/constraints  {Specify, whether ionospheric constraints in form of pseudo-observations shall be added [character string: no|Ionosphere: pseudo-obs]}\n"
       "   PPP/sigmaGIM     {Sigma for GIM pseudo observations in meters [floating-point number]}\n"
       "   PPP/maxResGIM    {Maximal residuum for GIM pseudo observations in meters [floating-point number]}\n"
+      "   PPP/workerThreads {Number of threads processing the epochs of all real-time stations, 0 = one thread per station [integer number]}\n"
+      "   PPP/filterUpdate {Algorithm of the Kalman filter update [character string: Square root|Sequential]}\n"
 #endif
       "\n"
       "PPP Client Panel 3 keys:\n"
@@ -163,6 +163,44 @@ void bncNetQueryV1::keepAliveRequest(const QUrl& url, const QByteArray& gga) {
 
 }
 
+// NTRIP Version 1 Request (used by the ingest pool as well)
+////////////////////////////////////////////////////////////////////////////
+QByteArray bncNetQueryV1::requestString(const QUrl& url,
+                                        const QString& proxyHost,
+                                        const QByteArray& gga) {
+  QUrl hlpUrl = url;
+  QString uName = QUrl::fromPercentEncoding(hlpUrl.userName().toLatin1());
+  QString passW = QUrl::fromPercentEncoding(hlpUrl.password().toLatin1());
+  QByteArray userAndPwd;
+
+  if(!uName.isEmpty() || !passW.isEmpty()) {
+    userAndPwd = "Authorization: Basic " + (uName.toLatin1() + ":" +
+    passW.toLatin1()).toBase64() + "\r\n";
+  }
+
+  QByteArray reqStr;
+  if ( proxyHost.isEmpty() ) {
+    if (hlpUrl.path().indexOf("/") != 0) hlpUrl.setPath("/");
+    reqStr = "GET " + hlpUrl.path().toLatin1() + " HTTP/1.0\r\n"
+             + "User-Agent: NTRIP BNC/" BNCVERSION " (" BNC_OS ")\r\n"
+             + "Host: " + hlpUrl.host().toLatin1() + "\r\n"
+             + userAndPwd + "\r\n";
+  } else {
+    reqStr = "GET " + hlpUrl.toEncoded() + " HTTP/1.0\r\n"
+             + "User-Agent: NTRIP BNC/" BNCVERSION " (" BNC_OS ")\r\n"
+             + "Host: " + hlpUrl.host().toLatin1() + "\r\n"
+             + userAndPwd + "\r\n";
+  }
+
+  // NMEA string to handle VRS stream
+  // --------------------------------
+  if (!gga.isEmpty()) {
+    reqStr += gga + "\r\n";
+  }
+
+  return reqStr;
+}
+
 // Connect to Caster, send the Request
 ////////////////////////////////////////////////////////////////////////////
 void bncNetQueryV1::startRequestPrivate(const QUrl& url, 
@@ -207,34 +245,7 @@ void bncNetQueryV1::startRequestPrivate(const QUrl& url,
 
   // Send Request
   // ------------
-  QString uName = QUrl::fromPercentEncoding(_url.userName().toLatin1());
-  QString passW = QUrl::fromPercentEncoding(_url.password().toLatin1());
-  QByteArray userAndPwd;
-
-  if(!uName.isEmpty() || !passW.isEmpty()) {
-    userAndPwd = "Authorization: Basic " + (uName.toLatin1() + ":" +
-    passW.toLatin1()).toBase64() + "\r\n";
-  }
-
-  QByteArray reqStr;
-  if ( proxyHost.isEmpty() ) {
-    if (_url.path().indexOf("/") != 0) _url.setPath("/");
-    reqStr = "GET " + _url.path().toLatin1() + " HTTP/1.0\r\n"
-             + "User-Agent: NTRIP BNC/" BNCVERSION " (" BNC_OS ")\r\n"
-             + "Host: " + _url.host().toLatin1() + "\r\n"
-             + userAndPwd + "\r\n";
-  } else {
-    reqStr = "GET " + _url.toEncoded() + " HTTP/1.0\r\n"
-             + "User-Agent: NTRIP BNC/" BNCVERSION " (" BNC_OS ")\r\n"
-             + "Host: " + _url.host().toLatin1() + "\r\n"
-             + userAndPwd + "\r\n";
-  }
-
-  // NMEA string to handle VRS stream
-  // --------------------------------
-  if (!gga.isEmpty()) {
-    reqStr += gga + "\r\n";
-  }
+  QByteArray reqStr = requestString(_url, proxyHost, gga);
 
   _socket->write(reqStr, reqStr.length());
 
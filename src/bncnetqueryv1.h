@@ -14,6 +14,9 @@ class bncNetQueryV1 : public bncNetQuery {
   virtual void keepAliveRequest(const QUrl& url, const QByteArray& gga);
   virtual void waitForReadyRead(QByteArray& outData);
 
+  static QByteArray requestString(const QUrl& url, const QString& proxyHost,
+                                  const QByteArray& gga);
+
  private:
   void startRequestPrivate(const QUrl& url, const QByteArray& gga, 
                            bool sendRequestOnly);
@@ -0,0 +1,210 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      bncOutSockets
+ *
+ * Purpose:    Non-blocking output to the clients of a feed engine port.
+ *             Each chunk is formatted once and shared by all clients (the
+ *             QByteArray is implicitly shared). A client that cannot keep
+ *             up collects data in its own bounded queue, which is drained
+ *             by the event loop; when the queue is full the oldest data
+ *             are dropped or the client is disconnected.
+ *
+ * Created:    16-Oct-2026
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include "bncoutsockets.h"
+
+using namespace std;
+
+// Data handed to the socket itself before the client queue is used
+////////////////////////////////////////////////////////////////////////////
+static const qint64 SOCKET_BUFFER = 64 * 1024;
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+bncOutSockets::bncOutSockets(const QString& portName) {
+  _portName = portName;
+  _maxBytes = 1024 * 1024;
+  _policy   = dropOldest;
+}
+
+// Destructor (the sockets are children of this object)
+////////////////////////////////////////////////////////////////////////////
+bncOutSockets::~bncOutSockets() {
+  for (int ii = 0; ii < _clients.size(); ii++) {
+    disconnect(_clients[ii]->_sock, 0, this, 0);
+    delete _clients[ii];
+  }
+}
+
+// Queue size per client in bytes and policy for a full queue
+////////////////////////////////////////////////////////////////////////////
+void bncOutSockets::setQueueLimit(qint64 maxBytes, e_policy policy) {
+  _maxBytes = maxBytes > 0 ? maxBytes : 1024 * 1024;
+  _policy   = policy;
+}
+
+//
+////////////////////////////////////////////////////////////////////////////
+bncOutSockets::e_policy bncOutSockets::policyFromString(const QString& str) {
+  if (str.toLower() == "disconnect") {
+    return disconnectClient;
+  }
+  return dropOldest;
+}
+
+// New Client
+////////////////////////////////////////////////////////////////////////////
+void bncOutSockets::addSocket(QTcpSocket* sock) {
+  if (!sock) {
+    return;
+  }
+  sock->setParent(this);
+  connect(sock, SIGNAL(bytesWritten(qint64)), this, SLOT(slotBytesWritten()));
+  connect(sock, SIGNAL(disconnected()),       this, SLOT(slotDisconnected()));
+  _clients.append(new t_client(sock));
+}
+
+// Send data to all clients without blocking
+////////////////////////////////////////////////////////////////////////////
+void bncOutSockets::write(const QByteArray& data) {
+
+  if (data.isEmpty()) {
+    return;
+  }
+
+  QList<t_client*> clients = _clients;
+  for (int ii = 0; ii < clients.size(); ii++) {
+    t_client* client = clients[ii];
+    QTcpSocket* sock = client->_sock;
+
+    if (sock->state() != QAbstractSocket::ConnectedState) {
+      if (sock->state() != QAbstractSocket::ConnectingState) {
+        removeClient(client, QString());
+      }
+      continue;
+    }
+
+    // Fast path: nothing queued, socket buffer not filled up
+    // -------------------------------------------------------
+    if (client->_queue.isEmpty() && sock->bytesToWrite() < SOCKET_BUFFER) {
+      sock->write(data);
+      continue;
+    }
+
+    // Client falls behind
+    // -------------------
+    if (client->_queued + data.size() > _maxBytes) {
+      if (_policy == disconnectClient) {
+        removeClient(client, "send queue full, client disconnected");
+        continue;
+      }
+      if (client->_dropped == 0) {
+        emit newMessage(QString("%1 output: client %2 falls behind, dropping oldest data")
+                        .arg(_portName).arg(sock->peerAddress().toString())
+                        .toLatin1(), true);
+      }
+      while (!client->_queue.isEmpty() && client->_queued + data.size() > _maxBytes) {
+        client->_queued -= client->_queue.dequeue().size();
+        client->_dropped += 1;
+      }
+    }
+    client->_queue.enqueue(data);
+    client->_queued += data.size();
+    drain(client);
+  }
+}
+
+// Hand queued data to the socket as far as its buffer allows
+////////////////////////////////////////////////////////////////////////////
+void bncOutSockets::drain(t_client* client) {
+  QTcpSocket* sock = client->_sock;
+  while (!client->_queue.isEmpty() && sock->bytesToWrite() < SOCKET_BUFFER) {
+    QByteArray data = client->_queue.dequeue();
+    client->_queued -= data.size();
+    sock->write(data);
+    if (!_clients.contains(client)) { // write error, client removed
+      return;
+    }
+  }
+  if (client->_queue.isEmpty() && client->_dropped > 0) {
+    emit newMessage(QString("%1 output: client %2 caught up, %3 chunks dropped")
+                    .arg(_portName).arg(sock->peerAddress().toString())
+                    .arg(client->_dropped).toLatin1(), true);
+    client->_dropped = 0;
+  }
+}
+
+//
+////////////////////////////////////////////////////////////////////////////
+void bncOutSockets::slotBytesWritten() {
+  t_client* client = findClient(sender());
+  if (client) {
+    drain(client);
+  }
+}
+
+//
+////////////////////////////////////////////////////////////////////////////
+void bncOutSockets::slotDisconnected() {
+  t_client* client = findClient(sender());
+  if (client) {
+    removeClient(client, QString());
+  }
+}
+
+//
+////////////////////////////////////////////////////////////////////////////
+bncOutSockets::t_client* bncOutSockets::findClient(QObject* sock) const {
+  for (int ii = 0; ii < _clients.size(); ii++) {
+    if (_clients[ii]->_sock == sock) {
+      return _clients[ii];
+    }
+  }
+  return 0;
+}
+
+//
+////////////////////////////////////////////////////////////////////////////
+void bncOutSockets::removeClient(t_client* client, const QString& reason) {
+  QTcpSocket* sock = client->_sock;
+  if (!reason.isEmpty()) {
+    emit newMessage(QString("%1 output: client %2: %3")
+                    .arg(_portName).arg(sock->peerAddress().toString())
+                    .arg(reason).toLatin1(), true);
+  }
+  _clients.removeOne(client);
+  delete client;
+  disconnect(sock, 0, this, 0);
+  sock->abort();
+  sock->deleteLater();
+}
@@ -0,0 +1,82 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+#ifndef BNCOUTSOCKETS_H
+#define BNCOUTSOCKETS_H
+
+#include <QByteArray>
+#include <QList>
+#include <QQueue>
+#include <QString>
+#include <QTcpSocket>
+
+// Clients of one output port, each with a bounded send queue
+////////////////////////////////////////////////////////////////////////////
+class bncOutSockets : public QObject {
+ Q_OBJECT
+
+ public:
+  enum e_policy {dropOldest, disconnectClient};
+
+  bncOutSockets(const QString& portName);
+  ~bncOutSockets();
+  void setQueueLimit(qint64 maxBytes, e_policy policy);
+  void addSocket(QTcpSocket* sock);
+  int  numClients() const {return _clients.size();}
+  void write(const QByteArray& data);
+
+  static e_policy policyFromString(const QString& str);
+
+ signals:
+  void newMessage(QByteArray msg, bool showOnScreen);
+
+ private slots:
+  void slotBytesWritten();
+  void slotDisconnected();
+
+ private:
+  class t_client {
+   public:
+    t_client(QTcpSocket* sock) {
+      _sock    = sock;
+      _queued  = 0;
+      _dropped = 0;
+    }
+    QTcpSocket*        _sock;
+    QQueue<QByteArray> _queue;    // data not yet handed to the socket
+    qint64             _queued;   // bytes in _queue
+    int                _dropped;  // chunks dropped since the last report
+  };
+
+  t_client* findClient(QObject* sock) const;
+  void      drain(t_client* client);
+  void      removeClient(t_client* client, const QString& reason);
+
+  QString          _portName;
+  QList<t_client*> _clients;
+  qint64           _maxBytes;
+  e_policy         _policy;
+};
+
+#endif
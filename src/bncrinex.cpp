@@ -569,7 +569,7 @@ void bncRinex::dumpEpoch(const QByteArray& format, const bncTime& maxTime) {
     }
 
     for (unsigned ii = 0; ii < satObs._obs.size(); ii++) {
-      const t_frqObs* frqObs = satObs._obs[ii];
+      const t_frqObs* frqObs = &satObs._obs[ii];
       if (frqObs->_codeValid) {
         QString type = 'C' + QString(frqObs->_rnxType2ch.c_str());
         t_rnxObsFile::t_rnxObs rnxObs;
@@ -633,44 +633,50 @@ void bncRinex::closeFile() {
   }
 }
 
-// One Line in ASCII (Internal) Format
+// One Line in ASCII (Internal) Format appended to buf (slipCounter >= 0
+// replaces the slip counters of the observations)
 ////////////////////////////////////////////////////////////////////////////
-string bncRinex::asciiSatLine(const t_satObs& obs, bool outLockTime) {
+void bncRinex::asciiSatLine(QByteArray& buf, const t_satObs& obs,
+                            bool outLockTime, int slipCounter) {
 
-  ostringstream str;
-  str.setf(ios::showpoint | ios::fixed);
-
-  str << obs._prn.toString();
+  buf.append(obs._prn.toString().c_str());
 
   for (unsigned ii = 0; ii < obs._obs.size(); ii++) {
-    const t_frqObs* frqObs = obs._obs[ii];
+    const t_frqObs* frqObs = &obs._obs[ii];
     if (frqObs->_codeValid) {
-      str << ' '
-          << left  << setw(3)  << "C" + frqObs->_rnxType2ch << ' '
-          << right << setw(14) << setprecision(3) << frqObs->_code;
+      appendObsType(buf, 'C', frqObs->_rnxType2ch);
+      appendFixed(buf, frqObs->_code, 14, 3);
     }
     if (frqObs->_phaseValid) {
-      str << ' '
-          << left  << setw(3) << "L" + frqObs->_rnxType2ch << ' '
-          << right << setw(14) << setprecision(3) << frqObs->_phase << ' '
-          << right << setw(4)                     << frqObs->_slipCounter;
+      appendObsType(buf, 'L', frqObs->_rnxType2ch);
+      appendFixed(buf, frqObs->_phase, 14, 3);
+      buf.append(' ');
+      appendInt(buf, slipCounter >= 0 ? slipCounter : frqObs->_slipCounter, 4);
     }
     if (frqObs->_dopplerValid) {
-      str << ' '
-          << left  << setw(3) << "D" + frqObs->_rnxType2ch << ' '
-          << right << setw(14) << setprecision(3) << frqObs->_doppler;
+      appendObsType(buf, 'D', frqObs->_rnxType2ch);
+      appendFixed(buf, frqObs->_doppler, 14, 3);
     }
     if (frqObs->_snrValid) {
-      str << ' '
-          << left  << setw(3) << "S" + frqObs->_rnxType2ch << ' '
-          << right << setw(8) << setprecision(3) << frqObs->_snr;
+      appendObsType(buf, 'S', frqObs->_rnxType2ch);
+      appendFixed(buf, frqObs->_snr, 8, 3);
     }
     if (frqObs->_lockTimeValid && outLockTime) {
-      str << ' '
-          << left  << setw(3) << "T" + frqObs->_rnxType2ch << ' '
-          << right << setw(9) << setprecision(3) << frqObs->_lockTime;
+      appendObsType(buf, 'T', frqObs->_rnxType2ch);
+      appendFixed(buf, frqObs->_lockTime, 9, 3);
     }
   }
+}
 
-  return str.str();
+// " C1C " - observation type left-aligned in three characters
+////////////////////////////////////////////////////////////////////////////
+void bncRinex::appendObsType(QByteArray& buf, char obsType,
+                             const t_rnxType2ch& rnxType2ch) {
+  buf.append(' ');
+  buf.append(obsType);
+  buf.append(rnxType2ch.c_str());
+  for (size_t ii = 1 + rnxType2ch.size(); ii < 3; ii++) {
+    buf.append(' ');
+  }
+  buf.append(' ');
 }
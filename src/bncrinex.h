@@ -48,9 +48,12 @@ class bncRinex {
                                const QString& intStr,
                                int rnxVersion,
                                QDateTime* nextEpoch = 0);
-   static std::string asciiSatLine(const t_satObs& obs, bool outLockTime);
+   static void asciiSatLine(QByteArray& buf, const t_satObs& obs,
+                            bool outLockTime, int slipCounter = -1);
 
  private:
+   static void appendObsType(QByteArray& buf, char obsType,
+                             const t_rnxType2ch& rnxType2ch);
    void resolveFileName(const QDateTime& datTim);
    bool readSkeleton();
    void writeHeader(const QByteArray& format, const bncTime& firstObsTime);
@@ -79,6 +79,7 @@ void bncSettings::reRead() {
     setValue_p("onTheFlyInterval",  "no");
     setValue_p("autoStart",          "0");
     setValue_p("rawOutFile",          "");
+    setValue_p("ingestPool",         "0");
     // RINEX Observations
     setValue_p("rnxPath",             "");
     setValue_p("rnxIntr",        "1 day");
@@ -144,6 +145,8 @@ void bncSettings::reRead() {
     setValue_p("outFile",             "");
     setValue_p("outUPort",            "");
     setValue_p("outLockTime",        "0");
+    setValue_p("outQueueSize",    "1024");
+    setValue_p("outQueuePolicy", "drop oldest");
     // Serial Output
     setValue_p("serialMountPoint",    "");
     setValue_p("serialPortName",      "");
@@ -166,6 +169,26 @@ void bncSettings::reRead() {
     setValue_p("miscIntr",            "");
     setValue_p("miscScanRTCM",       "0");
     setValue_p("miscPort",            "");
+    // MQTT
+    setValue_p("mqttHost",            "");
+    setValue_p("mqttPort",            "");
+    setValue_p("mqttTopic",           "");
+    setValue_p("mqttUser",            "");
+    setValue_p("mqttPwd",             "");
+    setValue_p("mqttNodeId",          "");
+    setValue_p("mqttSendInterval",  "10");
+    setValue_p("mqttDelta",          "0");
+    setValue_p("mqttFullInterval", "300");
+    setValue_p("mqttRtcmTypes",      "0");
+    setValue_p("mqttQueueSize",   "1000");
+    setValue_p("mqttQueueFile",       "");
+    setValue_p("mqttDrainRate",     "50");
+    setValue_p("mqttEvents",         "0");
+    setValue_p("mqttEventInterval", "10");
+    setValue_p("mqttFormat",      "JSON");
+    setValue_p("mqttCommands",       "0");
+    setValue_p("mqttData",           "0");
+    setValue_p("mqttDataBuffer",  "1024");
     // Combination
     setValue_p("cmbStreams",          "");
     setValue_p("cmbMethod",           "");
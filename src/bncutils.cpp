@@ -806,6 +806,67 @@ QString fortranFormat(double value, int width, int prec) {
   }
 }
 
+// Append value as printf("%*.*f") would format it (without iostreams)
+////////////////////////////////////////////////////////////////////////////
+void appendFixed(QByteArray& buf, double value, int width, int prec) {
+  static const double pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+
+  double scaled = (prec >= 0 && prec <= 9) ? fabs(value) * pow10[prec] : -1.0;
+  double frac   = scaled - floor(scaled);
+
+  // Large or non-finite values and (nearly) exact halves: printf rounds
+  // -------------------------------------------------------------------
+  if (!(scaled >= 0.0 && scaled < 1.0e15) ||
+      fabs(frac - 0.5) < 1.0e-6 + scaled * 1.0e-15) {
+    buf.append(QString::asprintf("%*.*f", width, prec, value).toLatin1());
+    return;
+  }
+
+  char  hlp[32];
+  char* end = hlp + sizeof(hlp);
+  char* pp  = end;
+  unsigned long long ii = static_cast<unsigned long long>(scaled + 0.5);
+  for (int kk = 0; kk < prec; kk++) {
+    *--pp = char('0' + ii % 10);
+    ii /= 10;
+  }
+  if (prec > 0) {
+    *--pp = '.';
+  }
+  do {
+    *--pp = char('0' + ii % 10);
+    ii /= 10;
+  } while (ii);
+  if (signbit(value)) {
+    *--pp = '-';
+  }
+  for (int kk = int(end - pp); kk < width; kk++) {
+    buf.append(' ');
+  }
+  buf.append(pp, int(end - pp));
+}
+
+// Append value as printf("%*ld") would format it
+////////////////////////////////////////////////////////////////////////////
+void appendInt(QByteArray& buf, long value, int width) {
+  char  hlp[32];
+  char* end = hlp + sizeof(hlp);
+  char* pp  = end;
+  unsigned long ii = value < 0 ? 0UL - static_cast<unsigned long>(value)
+                               : static_cast<unsigned long>(value);
+  do {
+    *--pp = char('0' + ii % 10);
+    ii /= 10;
+  } while (ii);
+  if (value < 0) {
+    *--pp = '-';
+  }
+  for (int kk = int(end - pp); kk < width; kk++) {
+    buf.append(' ');
+  }
+  buf.append(pp, int(end - pp));
+}
+
 //
 //////////////////////////////////////////////////////////////////////////////
 void kalman(const Matrix& AA, const ColumnVector& ll, const DiagonalMatrix& PP,
@@ -833,15 +894,176 @@ void kalman(const Matrix& AA, const ColumnVector& ll, const DiagonalMatrix& PP,
   UpperTriangularMatrix SH_rt = UU.SymSubMatrix(1, nObs);
   Matrix YY  = UU.SubMatrix(1, nObs, nObs+1, nObs+nPar);
 
-  UpperTriangularMatrix SHi = SH_rt.i();
-
-  Matrix KT  = SHi * YY;
-  SymmetricMatrix Hi; Hi << SHi * SHi.t();
+  Matrix KT  = SH_rt.i() * YY;
 
   xx += KT.t() * (ll - AA * xx);
   QQ << (SS.t() * SS);
 }
 
+// Kalman update processing uncorrelated observations one by one; QQ is
+// factorized into U*D*U' (U unit upper triangular, D diagonal) and each
+// observation updates the factors (Bierman), which keeps QQ positive
+// semi-definite like the square root update. Only the non-zero elements of
+// a row of AA enter the product with U, neither a QR decomposition nor an
+// inversion is needed
+//////////////////////////////////////////////////////////////////////////////
+void kalmanSequential(const Matrix& AA, const ColumnVector& ll, const DiagonalMatrix& PP,
+                      SymmetricMatrix& QQ, ColumnVector& xx) {
+
+  Tracer tracer("kalmanSequential");
+
+  int nPar = AA.Ncols();
+  int nObs = AA.Nrows();
+
+  vector<int>    ind(nPar);
+  vector<double> aa(nPar);
+  vector<double> ff(nPar);
+  vector<double> gg(nPar);
+  double* QS = QQ.data();   // lower triangle, row by row
+  double* XS = xx.data();
+
+  // QQ = U*D*U' in place: row ir of the lower triangle holds column ir of U
+  // above the diagonal and D(ir) on the diagonal; non-positive variances are
+  // clamped to zero
+  // ------------------------------------------------------------------------
+  for (int ir = nPar-1; ir >= 0; --ir) {
+    double* Ur = QS + ir*(ir+1)/2;
+    double  dd = Ur[ir];
+    if (dd <= 0.0) {
+      for (int ic = 0; ic <= ir; ++ic) {
+        Ur[ic] = 0.0;
+      }
+      continue;
+    }
+    for (int ic = 0; ic < ir; ++ic) {
+      double  qc = Ur[ic];
+      double* Qc = QS + ic*(ic+1)/2;
+      Ur[ic] = qc / dd;
+      for (int jj = 0; jj <= ic; ++jj) {
+        Qc[jj] -= qc * Ur[jj];
+      }
+    }
+  }
+
+  for (int iObs = 1; iObs <= nObs; ++iObs) {
+
+    // Non-zero partials
+    // -----------------
+    int nInd = 0;
+    for (int iPar = 0; iPar < nPar; ++iPar) {
+      double hlp = AA(iObs, iPar+1);
+      if (hlp != 0.0) {
+        ind[nInd] = iPar;
+        aa[nInd]  = hlp;
+        ++nInd;
+      }
+    }
+    if (nInd == 0) {
+      continue;
+    }
+
+    // Innovation and ff = U' * a (zero above the first non-zero partial)
+    // ------------------------------------------------------------------
+    double vv = ll(iObs);
+    for (int kk = 0; kk < nInd; ++kk) {
+      vv -= aa[kk] * XS[ind[kk]];
+    }
+    int i0 = ind[0];
+    for (int ir = i0; ir < nPar; ++ir) {
+      const double* Ur = QS + ir*(ir+1)/2;
+      double sum = 0.0;
+      for (int kk = 0; kk < nInd && ind[kk] <= ir; ++kk) {
+        sum += aa[kk] * (ind[kk] == ir ? 1.0 : Ur[ind[kk]]);
+      }
+      ff[ir] = sum;
+    }
+
+    // Update of the factors, gg accumulates the unscaled gain
+    // -------------------------------------------------------
+    for (int ir = 0; ir < nPar; ++ir) {
+      gg[ir] = 0.0;
+    }
+    double alpha = 1.0 / PP(iObs,iObs);
+    for (int ir = i0; ir < nPar; ++ir) {
+      double* Ur       = QS + ir*(ir+1)/2;
+      double  vr       = Ur[ir] * ff[ir];
+      double  alphaOld = alpha;
+      alpha  += ff[ir] * vr;
+      Ur[ir] *= alphaOld / alpha;
+      double lambda = -ff[ir] / alphaOld;
+      for (int ic = 0; ic < ir; ++ic) {
+        double uc = Ur[ic];
+        Ur[ic] += lambda * gg[ic];
+        gg[ic] += uc * vr;
+      }
+      gg[ir] = vr;
+    }
+
+    // Update state
+    // ------------
+    double fac = vv / alpha;
+    for (int ir = 0; ir < nPar; ++ir) {
+      XS[ir] += fac * gg[ir];
+    }
+  }
+
+  // QQ = U*D*U'
+  // -----------
+  for (int ir = 0; ir < nPar; ++ir) {
+    double* Ur = QS + ir*(ir+1)/2;
+    double  dd = Ur[ir];
+    for (int ic = ir-1; ic >= 0; --ic) {
+      double  qc = Ur[ic] * dd;
+      double* Qc = QS + ic*(ic+1)/2;
+      for (int jj = 0; jj <= ic; ++jj) {
+        Qc[jj] += qc * Ur[jj];
+      }
+      Ur[ic] = qc;
+    }
+  }
+}
+
+// Remove observations from the result of kalman() (rank-k downdate); on
+// failure (ill-conditioned) the update has to be repeated without them
+//////////////////////////////////////////////////////////////////////////////
+t_irc kalmanRemoveObs(const Matrix& AA, const ColumnVector& ll, const DiagonalMatrix& PP,
+                      SymmetricMatrix& QQ, ColumnVector& xx) {
+
+  Tracer tracer("kalmanRemoveObs");
+
+  const double minRatio = 1.e-4;
+
+  int nObs = AA.Nrows();
+
+  // Variance of the observations minus variance of the adjusted observations
+  // ------------------------------------------------------------------------
+  Matrix QAt = QQ * AA.t();
+  SymmetricMatrix SS; SS << AA * QAt;
+  SS = -SS;
+  for (int ii = 1; ii <= nObs; ++ii) {
+    double sig2 = 1.0 / PP(ii,ii);
+    SS(ii,ii) += sig2;
+    if (SS(ii,ii) < minRatio * sig2) {
+      return failure;
+    }
+  }
+
+  SymmetricMatrix SSi;
+  try {
+    LowerTriangularMatrix LLi = Cholesky(SS).i();
+    SSi << LLi.t() * LLi;
+  }
+  catch (...) {
+    return failure;
+  }
+
+  ColumnVector vv = ll - AA * xx;
+  QQ << QQ + QAt * SSi * QAt.t();
+  xx -= QQ * AA.t() * PP * vv;
+
+  return success;
+}
+
 //
 ////////////////////////////////////////////////////////////////////////////
 double accuracyFromIndex(int index, t_eph::e_system system) {
@@ -1005,21 +1227,63 @@ double fitIntervalFromFlag(int flag, double iodc, t_eph::e_system system) {
   return fitInterval;
 }
 
-// Returns CRC24
+// CRC24Q lookup tables (slicing-by-4), built on first use; checked against
+// the bit by bit computation in test/test_crc24.cpp
 ////////////////////////////////////////////////////////////////////////////
-unsigned long CRC24(long size, const unsigned char *buf) {
-  unsigned long crc = 0;
-  int ii;
-  while (size--) {
-    crc ^= (*buf++) << (16);
-    for(ii = 0; ii < 8; ii++) {
+namespace {
+  unsigned crc24Byte(unsigned char byte) {
+    unsigned crc = unsigned(byte) << 16;
+    for (int ii = 0; ii < 8; ii++) {
       crc <<= 1;
       if (crc & 0x1000000) {
         crc ^= 0x01864cfb;
       }
     }
+    return crc;
+  }
+
+  unsigned long crc24Table(const unsigned (*tab)[256], long size, const unsigned char *buf) {
+    unsigned crc = 0;
+    while (size >= 4) {
+      crc = tab[3][((crc >> 16) ^ buf[0]) & 0xff] ^
+            tab[2][((crc >>  8) ^ buf[1]) & 0xff] ^
+            tab[1][( crc        ^ buf[2]) & 0xff] ^
+            tab[0][buf[3]];
+      buf  += 4;
+      size -= 4;
+    }
+    while (size--) {
+      crc = ((crc << 8) & 0xffffff) ^ tab[0][((crc >> 16) ^ *buf++) & 0xff];
+    }
+    return crc;
+  }
+
+  class t_crc24Tables {
+   public:
+    t_crc24Tables() {
+      for (unsigned ii = 0; ii < 256; ii++) {
+        _tab[0][ii] = crc24Byte(static_cast<unsigned char>(ii));
+      }
+      for (int kk = 1; kk < 4; kk++) {
+        for (unsigned ii = 0; ii < 256; ii++) {
+          unsigned crc = _tab[kk-1][ii];
+          _tab[kk][ii] = ((crc << 8) & 0xffffff) ^ _tab[0][(crc >> 16) & 0xff];
+        }
+      }
+    }
+    unsigned _tab[4][256];
+  };
+
+  const t_crc24Tables& crc24Tables() {
+    static const t_crc24Tables tables;
+    return tables;
   }
-  return crc;
+}
+
+// Returns CRC24 (table-driven)
+////////////////////////////////////////////////////////////////////////////
+unsigned long CRC24(long size, const unsigned char *buf) {
+  return crc24Table(crc24Tables()._tab, size, buf);
 }
 
 // Extracts k bits from position pos and returns the extracted value as unsigned int
@@ -133,9 +133,19 @@ void         deg2DMS(double decDeg, int& deg, int& min, double& sec);
 
 QString      fortranFormat(double value, int width, int prec);
 
+void         appendFixed(QByteArray& buf, double value, int width, int prec);
+
+void         appendInt(QByteArray& buf, long value, int width);
+
 void         kalman(const Matrix& AA, const ColumnVector& ll, const DiagonalMatrix& PP,
                     SymmetricMatrix& QQ, ColumnVector& xx);
 
+void         kalmanSequential(const Matrix& AA, const ColumnVector& ll, const DiagonalMatrix& PP,
+                              SymmetricMatrix& QQ, ColumnVector& xx);
+
+t_irc        kalmanRemoveObs(const Matrix& AA, const ColumnVector& ll, const DiagonalMatrix& PP,
+                             SymmetricMatrix& QQ, ColumnVector& xx);
+
 double       djul(long j1, long m1, double tt);
 
 double       gpjd(double second, int nweek) ;
@@ -163,6 +173,7 @@ double       factorial(int n);
 double       lti2sec(int type, int lti);
 
 // CRC24Q checksum calculation function (only full bytes supported).
+// Table-driven, used for all RTCM3 decoding and encoding.
 ///////////////////////////////////////////////////////////////////
 unsigned long CRC24(long size, const unsigned char *buf);
 
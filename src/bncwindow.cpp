@@ -107,8 +107,6 @@
 #include "rinex/reqcedit.h"
 #include "rinex/reqcanalyze.h"
 #include "orbComp/sp3Comp.h"
-#include "mqtt/MqttClient.h"
-#include "mqtt/jsonMessage.h"
 #ifdef QT_WEBENGINE
 #  include "map/bncmapwin.h"
 #endif
@@ -128,13 +126,6 @@ bncWindow::bncWindow() {
   _bncFigure     = new bncFigure(this);
   _bncFigureLate = new bncFigureLate(this);
   _bncFigurePPP  = new bncFigurePPP(this);
-  // MQTT消息新增
-  _mqttClient    = new MqttClient(this);
-  _jsonMessage   = new JsonMessage(this);
-
-  // MQTT日志消息连接
-  connect(_mqttClient, &MqttClient::mqttLogMessage, this, &bncWindow::slotMQTTLogMessage);
-
   connect(BNC_CORE, SIGNAL(newPosition(QByteArray, bncTime, QVector<double>)),
           _bncFigurePPP, SLOT(slotNewPosition(QByteArray, bncTime, QVector<double>)));
 
@@ -242,6 +233,9 @@ bncWindow::bncWindow() {
   _autoStartCheckBox  = new QCheckBox();
   _autoStartCheckBox->setCheckState(Qt::CheckState(
                                     settings.value("autoStart").toInt()));
+  _ingestPoolCheckBox = new QCheckBox();
+  _ingestPoolCheckBox->setCheckState(Qt::CheckState(
+                                    settings.value("ingestPool").toInt()));
 
   // RINEX Observations Options
   // --------------------------
@@ -299,6 +293,29 @@ bncWindow::bncWindow() {
   _mqttPwdLineEdit = new QLineEdit(settings.value("mqttPwd").toString());
   _mqttNodeIdLineEdit = new QLineEdit(settings.value("mqttNodeId").toString());
   _mqttSendIntervalLineEdit = new QLineEdit(settings.value("mqttSendInterval").toString());
+  _mqttDeltaCheckBox = new QCheckBox();
+  _mqttDeltaCheckBox->setCheckState(Qt::CheckState(settings.value("mqttDelta").toInt()));
+  _mqttFullIntervalLineEdit = new QLineEdit(settings.value("mqttFullInterval").toString());
+  _mqttRtcmTypesCheckBox = new QCheckBox();
+  _mqttRtcmTypesCheckBox->setCheckState(Qt::CheckState(settings.value("mqttRtcmTypes").toInt()));
+  _mqttQueueSizeLineEdit = new QLineEdit(settings.value("mqttQueueSize").toString());
+  _mqttQueueFileLineEdit = new QLineEdit(settings.value("mqttQueueFile").toString());
+  _mqttDrainRateLineEdit = new QLineEdit(settings.value("mqttDrainRate").toString());
+  _mqttEventsCheckBox = new QCheckBox();
+  _mqttEventsCheckBox->setCheckState(Qt::CheckState(settings.value("mqttEvents").toInt()));
+  _mqttEventIntervalLineEdit = new QLineEdit(settings.value("mqttEventInterval").toString());
+  _mqttFormatComboBox = new QComboBox();
+  _mqttFormatComboBox->setEditable(false);
+  _mqttFormatComboBox->addItems(QString("JSON,CBOR").split(","));
+  int mf = _mqttFormatComboBox->findText(settings.value("mqttFormat").toString());
+  if (mf != -1) {
+    _mqttFormatComboBox->setCurrentIndex(mf);
+  }
+  _mqttCommandsCheckBox = new QCheckBox();
+  _mqttCommandsCheckBox->setCheckState(Qt::CheckState(settings.value("mqttCommands").toInt()));
+  _mqttDataCheckBox = new QCheckBox();
+  _mqttDataCheckBox->setCheckState(Qt::CheckState(settings.value("mqttData").toInt()));
+  _mqttDataBufferLineEdit = new QLineEdit(settings.value("mqttDataBuffer").toString());
 
 
   // RINEX Ephemeris Options
@@ -366,6 +383,13 @@ bncWindow::bncWindow() {
   _outUPortLineEdit = new QLineEdit(settings.value("outUPort").toString());
   _outLockTimeCheckBox = new QCheckBox();
   _outLockTimeCheckBox->setCheckState(Qt::CheckState(settings.value("outLockTime").toInt()));
+  _outQueueSizeLineEdit = new QLineEdit(settings.value("outQueueSize").toString());
+  _outQueuePolicyComboBox = new QComboBox();
+  _outQueuePolicyComboBox->addItems(QString("drop oldest,disconnect").split(","));
+  int qp = _outQueuePolicyComboBox->findText(settings.value("outQueuePolicy").toString());
+  if (qp != -1) {
+    _outQueuePolicyComboBox->setCurrentIndex(qp);
+  }
 
   connect(_outPortLineEdit, SIGNAL(textChanged(const QString &)),
           this, SLOT(slotBncTextChanged()));
@@ -847,8 +871,10 @@ bncWindow::bncWindow() {
   gLayout->addWidget(_autoStartCheckBox,                         4, 1);
   gLayout->addWidget(new QLabel("Raw output file (full path)"),  5, 0);
   gLayout->addWidget(_rawOutFileLineEdit,                        5, 1, 1,20);
-  gLayout->addWidget(new QLabel(""),                             6, 1);
-  gLayout->setRowStretch(7, 999);
+  gLayout->addWidget(new QLabel("Ingest pool"),                  6, 0);
+  gLayout->addWidget(_ingestPoolCheckBox,                        6, 1);
+  gLayout->addWidget(new QLabel(""),                             7, 1);
+  gLayout->setRowStretch(8, 999);
 
   ggroup->setLayout(gLayout);
 
@@ -906,7 +932,31 @@ bncWindow::bncWindow() {
   mqttLayout->addWidget(_mqttNodeIdLineEdit,                     6, 1, 1, 10);
   mqttLayout->addWidget(new QLabel("MQTT Message Send Interval"),7, 0);
   mqttLayout->addWidget(_mqttSendIntervalLineEdit,               7, 1, 1, 10);
-  mqttLayout->setRowStretch(8, 999);
+  mqttLayout->addWidget(new QLabel("Delta messages"),            8, 0);
+  mqttLayout->addWidget(_mqttDeltaCheckBox,                      8, 1);
+  mqttLayout->addWidget(new QLabel("Snapshot interval"),         9, 0);
+  mqttLayout->addWidget(_mqttFullIntervalLineEdit,               9, 1, 1, 10);
+  mqttLayout->addWidget(new QLabel("RTCM message types"),        10, 0);
+  mqttLayout->addWidget(_mqttRtcmTypesCheckBox,                  10, 1);
+  mqttLayout->addWidget(new QLabel("Offline queue size"),        11, 0);
+  mqttLayout->addWidget(_mqttQueueSizeLineEdit,                  11, 1, 1, 10);
+  mqttLayout->addWidget(new QLabel("Offline queue file"),        12, 0);
+  mqttLayout->addWidget(_mqttQueueFileLineEdit,                  12, 1, 1, 10);
+  mqttLayout->addWidget(new QLabel("Drain rate"),                13, 0);
+  mqttLayout->addWidget(_mqttDrainRateLineEdit,                  13, 1, 1, 10);
+  mqttLayout->addWidget(new QLabel("Status events"),             14, 0);
+  mqttLayout->addWidget(_mqttEventsCheckBox,                     14, 1);
+  mqttLayout->addWidget(new QLabel("Event interval"),            15, 0);
+  mqttLayout->addWidget(_mqttEventIntervalLineEdit,              15, 1, 1, 10);
+  mqttLayout->addWidget(new QLabel("Payload format"),            16, 0);
+  mqttLayout->addWidget(_mqttFormatComboBox,                     16, 1, 1, 10);
+  mqttLayout->addWidget(new QLabel("Commands"),                  17, 0);
+  mqttLayout->addWidget(_mqttCommandsCheckBox,                   17, 1);
+  mqttLayout->addWidget(new QLabel("Data output"),               18, 0);
+  mqttLayout->addWidget(_mqttDataCheckBox,                       18, 1);
+  mqttLayout->addWidget(new QLabel("Data buffer (kB)"),          19, 0);
+  mqttLayout->addWidget(_mqttDataBufferLineEdit,                 19, 1, 1, 10);
+  mqttLayout->setRowStretch(20, 999);
   // 设置密码框为密码模式
   _mqttPwdLineEdit->setEchoMode(QLineEdit::Password);
 
@@ -966,6 +1016,8 @@ bncWindow::bncWindow() {
   _outWaitSpinBox->setMaximumWidth(9*ww);
   _outSamplComboBox->setMaximumWidth(9*ww);
   _outUPortLineEdit->setMaximumWidth(9*ww);
+  _outQueueSizeLineEdit->setMaximumWidth(9*ww);
+  _outQueuePolicyComboBox->setMaximumWidth(12*ww);
 
   sLayout->addWidget(new QLabel("Output decoded observations in ASCII format to feed a real-time GNSS network engine.<br>"),0,0,1,50);
   sLayout->addWidget(new QLabel("Port"),                            1, 0);
@@ -980,8 +1032,12 @@ bncWindow::bncWindow() {
   sLayout->addWidget(_outUPortLineEdit,                             4, 1);
   sLayout->addWidget(new QLabel("Print lock time"),                 5, 0);
   sLayout->addWidget(_outLockTimeCheckBox,                        5, 1);
-  sLayout->addWidget(new QLabel(""),                                6, 1);
-  sLayout->setRowStretch(7, 999);
+  sLayout->addWidget(new QLabel("Client queue (kB)"),               6, 0);
+  sLayout->addWidget(_outQueueSizeLineEdit,                         6, 1);
+  sLayout->addWidget(new QLabel("       If queue is full"),         6, 2, Qt::AlignRight);
+  sLayout->addWidget(_outQueuePolicyComboBox,                       6, 3, Qt::AlignLeft);
+  sLayout->addWidget(new QLabel(""),                                7, 1);
+  sLayout->setRowStretch(8, 999);
 
   sgroup->setLayout(sLayout);
 
@@ -1182,6 +1238,10 @@ bncWindow::bncWindow() {
   pppLayout2->addWidget(new QLabel("Wait for clock corr."), ir, 6, Qt::AlignLeft);
   pppLayout2->addWidget(_pppWidgets._corrWaitTime,          ir, 7);
   ++ir;
+#ifdef USE_PPP
+  pppLayout2->addWidget(new QLabel("Worker threads"),       ir, 0, Qt::AlignLeft);
+  pppLayout2->addWidget(_pppWidgets._workerThreads,         ir, 1);
+#endif
   pppLayout2->addItem(new QSpacerItem(8*ww, 0),             ir, 2);
 #ifdef USE_PPP
   pppLayout2->addWidget(new QLabel("Max Res GIM"),          ir, 3, Qt::AlignLeft);
@@ -1190,6 +1250,11 @@ bncWindow::bncWindow() {
   pppLayout2->addWidget(new QLabel("Seeding (sec)"),        ir, 6, Qt::AlignLeft);
   pppLayout2->addWidget(_pppWidgets._seedingTime,           ir, 7);_pppWidgets._seedingTime->setMaximumWidth(8*ww);
   ++ir;
+#ifdef USE_PPP
+  pppLayout2->addWidget(new QLabel("Filter update"),        ir, 0, Qt::AlignLeft);
+  pppLayout2->addWidget(_pppWidgets._filterUpdate,          ir, 1);
+  ++ir;
+#endif
   pppLayout2->addWidget(new QLabel(""),                     ir, 8);
   pppLayout2->setColumnStretch(8, 999);
   ++ir;
@@ -1502,6 +1567,7 @@ bncWindow::bncWindow() {
   _rnxAppendCheckBox->setWhatsThis(tr("<p>When BNC is started, new files are created by default and file content already available under the same name will be overwritten. However, users might want to append already existing files following a regular restart or a crash of BNC or its platform.</p><p>Tick 'Append files' to continue with existing files and keep what has been recorded so far. <i>[key: rnxAppend]</i></p>"));
   _onTheFlyComboBox->setWhatsThis(tr("<p>When operating BNC online in 'no window' mode, some configuration parameters can be changed on-the-fly without interrupting the running process. For that BNC rereads parts of its configuration in pre-defined intervals. The default entry is 'no' that means the reread function is switched of. <p></p>Select '1 min', '5 min', '1 hour', or '1 day' to force BNC to reread its configuration every full minute, five minutes, hour, or day and let in between edited configuration options become effective on-the-fly without terminating uninvolved threads.</p><p>Note that when operating BNC in window mode, on-the-fly changeable configuration options become effective immediately via button 'Save & Reread Configuration'. <i>[key: onTheFlyInterval]</i></p>"));
   _autoStartCheckBox->setWhatsThis(tr("<p>Tick 'Auto start' for auto-start of BNC at startup time in window mode with preassigned processing options. <i>[key: autoStart]</i></p>"));
+  _ingestPoolCheckBox->setWhatsThis(tr("<p>By default BNC reads each stream in a thread of its own. With hundreds of streams the operating system then spends a considerable part of the processing time on switching between these threads.</p><p>Tick 'Ingest pool' to let a small pool of worker threads, one per processor core, serve all streams pulled via NTRIP Version 1 or plain TCP/IP ('N'). Each worker waits for incoming data on all of its connections at once. Streams pulled via NTRIP Version 2, UDP, RTSP or from a serial port as well as streams with NMEA input are still read in threads of their own.</p><p>Default is an empty check box, meaning one thread per stream. <i>[key: ingestPool]</i></p>"));
   _rawOutFileLineEdit->setWhatsThis(tr("<p>Save all data coming in through various streams in the received order and format in one file.</p><p>This option is primarily meant for debugging purposes. <i>[key: rawOutFile]</i></p>"));
 
   // WhatsThis, RINEX Observations
@@ -1526,6 +1592,18 @@ bncWindow::bncWindow() {
   _mqttPwdLineEdit->setWhatsThis(tr("<p>Specify the password for MQTT broker authentication.</p>""<p>Leave empty if no authentication is required.</p>""<i>[key: mqttPwd]</i></p>"));
   _mqttNodeIdLineEdit->setWhatsThis(tr("<p>Specify a unique node identifier for MQTT client.</p>""<p>This ID must be unique across all MQTT clients in the network.</p>""<i>[key: mqttNodeId]</i></p>"));
   _mqttSendIntervalLineEdit->setWhatsThis("");
+  _mqttDeltaCheckBox->setWhatsThis(tr("<p>Tick 'Delta messages' to publish a complete retained station snapshot only at start-up and every 'Snapshot interval' seconds.</p><p>In between, BNC publishes only those stations whose status, latency class or class of the 1 minute average throughput changed since the last message. Every message carries a sequence number 'seq', delta messages refer to the last snapshot through 'base', so that subscribers can detect lost messages.</p><p>Default is publishing the complete station list in every interval. <i>[key: mqttDelta]</i></p>"));
+  _mqttFullIntervalLineEdit->setWhatsThis(tr("<p>Specify the interval in seconds for publishing a complete station snapshot in 'Delta messages' mode.</p><p>Default is 300 seconds. <i>[key: mqttFullInterval]</i></p>"));
+  _mqttRtcmTypesCheckBox->setWhatsThis(tr("<p>Tick 'RTCM message types' to publish per station and per RTCM message type the number of received messages, their size in bytes and the time of the last reception.</p><p>These counters are published in every interval on the subtopic '&lt;topic&gt;/rtcm'. They are accumulated since the start of BNC, rates follow from two consecutive messages.</p><p>Default is not publishing RTCM message type counters. <i>[key: mqttRtcmTypes]</i></p>"));
+  _mqttQueueSizeLineEdit->setWhatsThis(tr("<p>BNC buffers status messages while the connection to the MQTT broker is down and publishes them with QoS 1 once the connection is re-established. Specify the maximum number of buffered messages. When the queue is full the oldest messages are discarded.</p><p>Default is 1000 messages. <i>[key: mqttQueueSize]</i></p>"));
+  _mqttQueueFileLineEdit->setWhatsThis(tr("<p>Specify the full path to a file for buffering messages while the connection to the MQTT broker is down. The file is memory-mapped with a fixed size of 16 MB, messages not yet published are kept over a restart of BNC.</p><p>Default is an empty option field, meaning that messages are only buffered in memory. <i>[key: mqttQueueFile]</i></p>"));
+  _mqttDrainRateLineEdit->setWhatsThis(tr("<p>Specify the rate in messages per second for publishing buffered messages after a reconnect.</p><p>Default is 50 messages per second. <i>[key: mqttDrainRate]</i></p>"));
+  _mqttEventsCheckBox->setWhatsThis(tr("<p>Tick 'Status events' to publish a small event message on the subtopic '&lt;topic&gt;/event' as soon as the status of a station changes, e.g. from 'connected' to 'timeout', 'disconnect' or 'error' and back. Events are published with QoS 1.</p><p>To protect the broker from flapping streams, BNC publishes at most one event per station within the 'Event interval'. Changes in between are merged into the next event and counted in 'suppressed'.</p><p>Default is not publishing status events. <i>[key: mqttEvents]</i></p>"));
+  _mqttEventIntervalLineEdit->setWhatsThis(tr("<p>Specify the minimum interval in seconds between two status events of the same station.</p><p>Default is 10 seconds. <i>[key: mqttEventInterval]</i></p>"));
+  _mqttFormatComboBox->setWhatsThis(tr("<p>Select the encoding of published MQTT messages.</p><p>'JSON' publishes compact JSON text. 'CBOR' publishes the same message structure in the binary Concise Binary Object Representation (RFC 7049), which is considerably smaller and cheaper to produce.</p><p>Default is 'JSON'. <i>[key: mqttFormat]</i></p>"));
+  _mqttCommandsCheckBox->setWhatsThis(tr("<p>Tick 'Commands' to let BNC accept control commands on MQTT topic '&lt;topic&gt;/cmd'. A command is a JSON object like {'id':1, 'cmd':'add', 'mountpoint':'...'} (with double quotes as required by JSON). Supported commands are 'add' (mountpoint given in the same format as a 'mountPoints' entry of the configuration file), 'remove' (mountpoint given as URL or stream name), 'reread' (reread the configuration file) and 'snapshot' (publish the complete station status list immediately). Added or removed mountpoints are written to the configuration file. Each command is answered on topic '&lt;topic&gt;/response' with QoS 1.</p><p>Default is an empty check box, meaning that no commands are accepted. <i>[key: mqttCommands]</i></p>"));
+  _mqttDataCheckBox->setWhatsThis(tr("<p>Tick 'Data output' to publish the decoded observations of each stream on MQTT topic '&lt;topic&gt;/obs/&lt;mountpoint&gt;' and the results of PPP processing on topic '&lt;topic&gt;/ppp/&lt;mountpoint&gt;'. Consumers can thus subscribe to selected stations instead of parsing the complete output of the synchronized or unsynchronized observations port.</p><p>Observations are published once per epoch and station in a compact little-endian binary format with QoS 0. Messages are not buffered while BNC is disconnected from the broker.</p><p>Default is an empty check box, meaning that no data output is published. <i>[key: mqttData]</i></p>"));
+  _mqttDataBufferLineEdit->setWhatsThis(tr("<p>Specify the maximum amount of data output in kilobytes that may wait for transmission to the broker. If the broker or the network cannot keep up, complete epochs are dropped instead of accumulating in memory. The number of dropped messages is reported in the MQTT log.</p><p>Default is 1024 kB. <i>[key: mqttDataBuffer]</i></p>"));
 
   // WhatsThis, RINEX Ephemeris
   // --------------------------
@@ -1569,6 +1647,8 @@ bncWindow::bncWindow() {
   _outFileLineEdit->setWhatsThis(tr("<p>Specify the full path to a file where synchronized observations are saved in plain ASCII format.</p><p>Beware that the size of this file can rapidly increase depending on the number of incoming streams. <i>[key: outFile]</i></p>"));
   _outUPortLineEdit->setWhatsThis(tr("<p>BNC can produce unsynchronized observations in a plain ASCII format on your local host via IP port.</p><p>Specify a port number to activate this function. <i>[key: outUPort]</i></p>"));
   _outLockTimeCheckBox->setWhatsThis(tr("<p>Print the lock time in seconds in the feed engine output.<i>[key: outLockTime]</i></p>"));
+  _outQueueSizeLineEdit->setWhatsThis(tr("<p>Output to the clients of the synchronized, unsynchronized and miscellaneous ports never waits for a slow client. Data a client cannot take at once are kept in a send queue of its own.</p><p>Specify the maximum size of this queue in kilobytes. Default is 1024 kB. <i>[key: outQueueSize]</i></p>"));
+  _outQueuePolicyComboBox->setWhatsThis(tr("<p>Select what happens when a client falls so far behind that its send queue is full: 'drop oldest' discards the oldest queued data, 'disconnect' closes the connection to the client. Default is 'drop oldest'. <i>[key: outQueuePolicy]</i></p>"));
 
   // WhatsThis, Serial Output
   // ------------------------
@@ -1819,6 +1899,7 @@ bncWindow::~bncWindow() {
   delete _rnxAppendCheckBox;
   delete _onTheFlyComboBox;
   delete _autoStartCheckBox;
+  delete _ingestPoolCheckBox;
   delete _rnxPathLineEdit;
   delete _rnxIntrComboBox;
   delete _rnxSamplComboBox;
@@ -1829,8 +1910,6 @@ bncWindow::~bncWindow() {
   delete _rnxVersComboBox;
   delete _rnxV2Priority;
   // MQTT消息新增
-  delete _mqttClient;
-  delete _jsonMessage;
   delete _mqttHostLineEdit;
   delete _mqttPortLineEdit;
   delete _mqttTopicLineEdit;
@@ -1838,6 +1917,18 @@ bncWindow::~bncWindow() {
   delete _mqttPwdLineEdit;
   delete _mqttNodeIdLineEdit;
   delete _mqttSendIntervalLineEdit;
+  delete _mqttDeltaCheckBox;
+  delete _mqttFullIntervalLineEdit;
+  delete _mqttRtcmTypesCheckBox;
+  delete _mqttQueueSizeLineEdit;
+  delete _mqttQueueFileLineEdit;
+  delete _mqttDrainRateLineEdit;
+  delete _mqttEventsCheckBox;
+  delete _mqttEventIntervalLineEdit;
+  delete _mqttFormatComboBox;
+  delete _mqttCommandsCheckBox;
+  delete _mqttDataCheckBox;
+  delete _mqttDataBufferLineEdit;
   delete _mqttLog;
   delete _ephPathLineEdit;
   //delete _ephFilePerStation;
@@ -1853,6 +1944,8 @@ bncWindow::~bncWindow() {
   delete _outFileLineEdit;
   delete _outUPortLineEdit;
   delete _outLockTimeCheckBox;
+  delete _outQueueSizeLineEdit;
+  delete _outQueuePolicyComboBox;
   delete _serialMountPointLineEdit;
   delete _serialPortNameLineEdit;
   delete _serialBaudRateComboBox;
@@ -2298,6 +2391,7 @@ void bncWindow::saveOptions() {
   settings.setValue("rnxAppend",   _rnxAppendCheckBox->checkState());
   settings.setValue("onTheFlyInterval", _onTheFlyComboBox->currentText());
   settings.setValue("autoStart",   _autoStartCheckBox->checkState());
+  settings.setValue("ingestPool",  _ingestPoolCheckBox->checkState());
   settings.setValue("rawOutFile",  _rawOutFileLineEdit->text());
 // RINEX Observations
   settings.setValue("rnxPath",      _rnxPathLineEdit->text());
@@ -2319,6 +2413,18 @@ void bncWindow::saveOptions() {
   settings.setValue("mqttPwd",    _mqttPwdLineEdit->text());
   settings.setValue("mqttNodeId",_mqttNodeIdLineEdit->text());
   settings.setValue("mqttSendInterval",_mqttSendIntervalLineEdit->text());
+  settings.setValue("mqttDelta",_mqttDeltaCheckBox->checkState());
+  settings.setValue("mqttFullInterval",_mqttFullIntervalLineEdit->text());
+  settings.setValue("mqttRtcmTypes",_mqttRtcmTypesCheckBox->checkState());
+  settings.setValue("mqttQueueSize",_mqttQueueSizeLineEdit->text());
+  settings.setValue("mqttQueueFile",_mqttQueueFileLineEdit->text());
+  settings.setValue("mqttDrainRate",_mqttDrainRateLineEdit->text());
+  settings.setValue("mqttEvents",_mqttEventsCheckBox->checkState());
+  settings.setValue("mqttEventInterval",_mqttEventIntervalLineEdit->text());
+  settings.setValue("mqttFormat",_mqttFormatComboBox->currentText());
+  settings.setValue("mqttCommands",_mqttCommandsCheckBox->checkState());
+  settings.setValue("mqttData",_mqttDataCheckBox->checkState());
+  settings.setValue("mqttDataBuffer",_mqttDataBufferLineEdit->text());
 
 // RINEX Ephemeris
   settings.setValue("ephPath",       _ephPathLineEdit->text());
@@ -2336,6 +2442,8 @@ void bncWindow::saveOptions() {
   settings.setValue("outSampl",    _outSamplComboBox->currentText());
   settings.setValue("outFile",     _outFileLineEdit->text());
   settings.setValue("outLockTime",_outLockTimeCheckBox->checkState());    settings.setValue("outUPort",    _outUPortLineEdit->text());
+  settings.setValue("outQueueSize",   _outQueueSizeLineEdit->text());
+  settings.setValue("outQueuePolicy", _outQueuePolicyComboBox->currentText());
 // Serial Output
   settings.setValue("serialMountPoint",_serialMountPointLineEdit->text());
   settings.setValue("serialPortName",  _serialPortNameLineEdit->text());
@@ -2469,9 +2577,6 @@ void bncWindow::slotStart() {
   else {
     startRealTime();
     BNC_CORE->startPPP();
-
-    // MQTT消息新增
-    startMQTTConnect();
   }
 }
 
@@ -2556,56 +2661,6 @@ void bncWindow::startRealTime() {
   _casterEph = new bncEphUploadCaster();
 }
 
-// MQTT消息新增
-// Start MQTT Client
-///////////////////////////////////////////////////////////////////////////
-void bncWindow::startMQTTConnect() {
-  BNC_CORE->slotMQTTMessage("Start MQTT Message", true);
-
-  QString host = _mqttHostLineEdit->text().trimmed();
-  quint16 port = static_cast<quint16>(_mqttPortLineEdit->text().toUInt());
-  QString username = _mqttUserLineEdit->text().trimmed();
-  QString password = _mqttPwdLineEdit->text().trimmed();
-  QString clientId = _mqttNodeIdLineEdit->text().trimmed();
-  QString topic = _mqttTopicLineEdit->text().trimmed();
-  int messageInterval = _mqttSendIntervalLineEdit->text().toInt();
-
-  // MQTT自动发送消息
-  disconnect(_mqttClient, &MqttClient::autoSendMsg, this, &bncWindow::slotPublishMQTTMsg);
-  connect(_mqttClient, &MqttClient::autoSendMsg, this, &bncWindow::slotPublishMQTTMsg);
-
-  // 设置连接参数
-  _mqttClient->setConnectionParameters(host, port, topic, clientId);
-  // 用户认证，如果有
-  if (!username.isEmpty()) {
-    _mqttClient->setCredentials(username, password);
-  }
-  // 连接到MQTT服务器
-  _mqttClient->connectToHost();
-  // 设置自动发送消息间隔
-  _mqttClient->setSendMessageInterval(messageInterval * 1000);
-  // 启动自动发送消息
-  _mqttClient->enableAutoSendMessage();
-  // 启动MQTT连接检查
-  _mqttClient->enableConnectionCheck();
-
-  // 消息存储对象初始化
-  //-----------------------------------
-  _jsonMessage->setNodeName(clientId);
-  // 设置站点列表
-  _jsonMessage->updateStationList();
-}
-
-void bncWindow::slotPublishMQTTMsg(const QString& topic) {
-  QString msg = _jsonMessage->getJsonMessage(true);
-  _mqttClient->publishMessage(topic, msg);
-}
-
-void bncWindow::stopMQTTConnect() {
-  // 停止MQTT连接
-  _mqttClient->stopMqttClient();
-}
-
 // Retrieve Data
 ////////////////////////////////////////////////////////////////////////////
 void bncWindow::slotStop() {
@@ -2620,8 +2675,6 @@ void bncWindow::slotStop() {
     _runningRealTime = false;
     _runningPPP      = false;
     enableStartStop();
-    // MQTT消息新增
-    stopMQTTConnect();
   }
 }
 
@@ -2739,19 +2792,6 @@ void bncWindow::slotMountPointsRead(QList<bncGetThread*> threads) {
         disconnect(thread, SIGNAL(newLatency(QByteArray, double)), _bncFigureLate, SLOT(slotNewLatency(QByteArray, double)));
         connect(thread, SIGNAL(newLatency(QByteArray, double)), _bncFigureLate, SLOT(slotNewLatency(QByteArray, double)));
 
-        // MQTT消息新增
-        disconnect(thread, &bncGetThread::sigUpdateLatency, _jsonMessage, &JsonMessage::slotUpdateLatency);
-        disconnect(thread, &bncGetThread::sigUpdateThroughput, _jsonMessage, &JsonMessage::slotUpdateThroughput);
-        disconnect(thread, &bncGetThread::sigStaTimeout, _jsonMessage, &JsonMessage::slotOnStaTimeout);
-        disconnect(thread, &bncGetThread::sigStaDisconnected, _jsonMessage, &JsonMessage::slotOnStaDisconnected);
-        disconnect(thread, &bncGetThread::sigStaError, _jsonMessage, &JsonMessage::slotOnStaError);
-
-        connect(thread, &bncGetThread::sigUpdateLatency, _jsonMessage, &JsonMessage::slotUpdateLatency);
-        connect(thread, &bncGetThread::sigUpdateThroughput, _jsonMessage, &JsonMessage::slotUpdateThroughput);
-        connect(thread, &bncGetThread::sigStaTimeout, _jsonMessage, &JsonMessage::slotOnStaTimeout);
-        connect(thread, &bncGetThread::sigStaDisconnected, _jsonMessage, &JsonMessage::slotOnStaDisconnected);
-        connect(thread, &bncGetThread::sigStaError, _jsonMessage, &JsonMessage::slotOnStaError);
-
         break;
       }
     }
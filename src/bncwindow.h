@@ -34,8 +34,6 @@
 #include "bncgetthread.h"
 #include "bnccaster.h"
 #include "pppWidgets.h"
-#include "mqtt/MqttClient.h"
-#include "mqtt/jsonMessage.h"
 
 class bncAboutDlg : public QDialog {
   Q_OBJECT
@@ -76,7 +74,6 @@ class bncWindow : public QMainWindow {
   private slots:
     void slotWindowMessage(const QByteArray msg, bool showOnScreen);
     void slotMQTTLogMessage(const QByteArray msg, bool showOnScreen);
-    void slotPublishMQTTMsg(const QString &topic);
     void slotHelp();
     void slotAbout();
     void slotFlowchart();
@@ -116,8 +113,6 @@ class bncWindow : public QMainWindow {
     void enableWidget(bool enable, QWidget* widget);
     void startRealTime();
     void enableStartStop();
-    void startMQTTConnect();
-    void stopMQTTConnect();
 
     QMenu*     _menuHlp;
     QMenu*     _menuFile;
@@ -145,6 +140,8 @@ class bncWindow : public QMainWindow {
     QLineEdit* _outPortLineEdit;
     QLineEdit* _outUPortLineEdit;
     QCheckBox* _outLockTimeCheckBox;
+    QLineEdit* _outQueueSizeLineEdit;
+    QComboBox* _outQueuePolicyComboBox;
     QLineEdit* _ephOutPortLineEdit;
     QLineEdit* _corrPortLineEdit;
     QLineEdit* _rnxPathLineEdit;
@@ -156,6 +153,18 @@ class bncWindow : public QMainWindow {
     QLineEdit* _mqttPwdLineEdit;
     QLineEdit* _mqttNodeIdLineEdit;
     QLineEdit* _mqttSendIntervalLineEdit;
+    QCheckBox* _mqttDeltaCheckBox;
+    QLineEdit* _mqttFullIntervalLineEdit;
+    QCheckBox* _mqttRtcmTypesCheckBox;
+    QLineEdit* _mqttQueueSizeLineEdit;
+    QLineEdit* _mqttQueueFileLineEdit;
+    QLineEdit* _mqttDrainRateLineEdit;
+    QCheckBox* _mqttEventsCheckBox;
+    QLineEdit* _mqttEventIntervalLineEdit;
+    QComboBox* _mqttFormatComboBox;
+    QCheckBox* _mqttCommandsCheckBox;
+    QCheckBox* _mqttDataCheckBox;
+    QLineEdit* _mqttDataBufferLineEdit;
 
     QLineEdit* _rnxSkelPathLineEdit;
     QLineEdit* _ephPathLineEdit;
@@ -195,6 +204,7 @@ class bncWindow : public QMainWindow {
     QComboBox* _outSamplComboBox;
     QCheckBox* _rnxAppendCheckBox;
     QCheckBox* _autoStartCheckBox;
+    QCheckBox* _ingestPoolCheckBox;
     QCheckBox* _miscScanRTCMCheckBox;
     QSpinBox*  _outWaitSpinBox;
     QComboBox* _adviseObsRateComboBox;
@@ -275,10 +285,6 @@ class bncWindow : public QMainWindow {
     QList<bncGetThread*> _threads;
 
     t_pppWidgets         _pppWidgets;
-
-    // MQTT消息新增
-    MqttClient           *_mqttClient;
-    JsonMessage          *_jsonMessage;
 };
 
 #ifdef GNSSCENTER_PLUGIN
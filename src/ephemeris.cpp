@@ -34,6 +34,32 @@ t_eph::~t_eph() {
     delete _clkCorr;
 }
 
+// Copy Constructor (corrections are copied, not shared)
+////////////////////////////////////////////////////////////////////////////
+t_eph::t_eph(const t_eph& other) {
+  _orbCorr = 0;
+  _clkCorr = 0;
+  *this = other;
+}
+
+// Assignment
+////////////////////////////////////////////////////////////////////////////
+t_eph& t_eph::operator=(const t_eph& other) {
+  if (this != &other) {
+    _prn            = other._prn;
+    _TOC            = other._TOC;
+    _receptDateTime = other._receptDateTime;
+    _receptStaID    = other._receptStaID;
+    _checkState     = other._checkState;
+    _type           = other._type;
+    delete _orbCorr;
+    delete _clkCorr;
+    _orbCorr = other._orbCorr ? new t_orbCorr(*other._orbCorr) : 0;
+    _clkCorr = other._clkCorr ? new t_clkCorr(*other._clkCorr) : 0;
+  }
+  return *this;
+}
+
 //
 ////////////////////////////////////////////////////////////////////////////
 void t_eph::setOrbCorr(const t_orbCorr *orbCorr) {
@@ -1422,7 +1448,13 @@ t_irc t_ephGlo::position(int GPSweek, double GPSweeks, double *xc,
   memset(xc, 0, 6 * sizeof(double));
   memset(vv, 0, 3 * sizeof(double));
 
-  double dtPos = bncTime(GPSweek, GPSweeks) - _tt;
+  // Integrate from the status vector at _TOC on every call, the ephemeris
+  // may be shared between threads
+  // -----------------------------------------------------------------------
+  bncTime      tt = _tt;
+  ColumnVector xv = _xv;
+
+  double dtPos = bncTime(GPSweek, GPSweeks) - tt;
 
   if (fabs(dtPos) > 24 * 3600.0) {
     return failure;
@@ -1437,19 +1469,19 @@ t_irc t_ephGlo::position(int GPSweek, double GPSweeks, double *xc,
   acc[2] = _z_acc * 1.e3;
 
   for (int ii = 1; ii <= nSteps; ii++) {
-    _xv = rungeKutta4(_tt.gpssec(), _xv, step, acc, glo_deriv);
-    _tt = _tt + step;
+    xv = rungeKutta4(tt.gpssec(), xv, step, acc, glo_deriv);
+    tt = tt + step;
   }
 
   // Position and Velocity
   // ---------------------
-  xc[0] = _xv(1);
-  xc[1] = _xv(2);
-  xc[2] = _xv(3);
+  xc[0] = xv(1);
+  xc[1] = xv(2);
+  xc[2] = xv(3);
 
-  vv[0] = _xv(4);
-  vv[1] = _xv(5);
-  vv[2] = _xv(6);
+  vv[0] = xv(4);
+  vv[1] = xv(5);
+  vv[2] = xv(6);
 
   // Clock Correction
   // ----------------
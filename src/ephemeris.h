@@ -20,7 +20,9 @@ class t_eph {
   enum e_type {undefined, LNAV, FDMA, FDMA_M, FNAV, INAV, D1, D2, SBASL1, CNAV, CNV1, CNV2, CNV3, L1NV, L1OC, L3OC};
 
   t_eph();
+  t_eph(const t_eph& other);
   virtual ~t_eph();
+  t_eph& operator=(const t_eph& other);
 
   virtual e_system  system() const = 0;
   virtual QString toString(double version) const = 0;
@@ -296,8 +298,8 @@ class t_ephGlo : public t_eph {
   virtual t_irc position(int GPSweek, double GPSweeks, double* xc, double* vv) const;
   static ColumnVector glo_deriv(double /* tt */, const ColumnVector& xv, double* acc);
 
-  mutable bncTime      _tt;    // time
-  mutable ColumnVector _xv;    // status vector (position, velocity) at time _tt
+  bncTime              _tt;    // time
+  ColumnVector         _xv;    // status vector (position, velocity) at time _tt
 
   double  _gps_utc;            // [s]
   double  _tau;                // [s]
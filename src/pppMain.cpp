@@ -51,7 +51,9 @@ using namespace std;
 // Constructor
 //////////////////////////////////////////////////////////////////////////////
 t_pppMain::t_pppMain() {
-  _running = false;
+  _running       = false;
+  _pool          = 0;
+  _workerThreads = 0;
 }
 
 // Destructor
@@ -62,6 +64,7 @@ t_pppMain::~t_pppMain() {
   while (iOpt.hasNext()) {
     delete iOpt.next();
   }
+  delete _pool;
 }
 
 //
@@ -74,14 +77,31 @@ void t_pppMain::start() {
   try {
     readOptions();
 
-    QListIterator<t_pppOptions*> iOpt(_options);
-    while (iOpt.hasNext()) {
-      const t_pppOptions* opt = iOpt.next();
-      t_pppThread* pppThread = new t_pppThread(opt);
+    // All real-time rovers in one thread, epochs processed by the worker pool
+    // ------------------------------------------------------------------------
+    if (_realTime && _workerThreads > 0 && !_options.isEmpty()) {
+      if (!_pool) {
+        _pool = new QThreadPool();
+      }
+      _pool->setMaxThreadCount(_workerThreads);
+      t_pppThread* pppThread = new t_pppThread(_options, _pool);
       pppThread->start();
       _pppThreads << pppThread;
       _running = true;
     }
+
+    // One thread per rover
+    // --------------------
+    else {
+      QListIterator<t_pppOptions*> iOpt(_options);
+      while (iOpt.hasNext()) {
+        const t_pppOptions* opt = iOpt.next();
+        t_pppThread* pppThread = new t_pppThread(opt);
+        pppThread->start();
+        _pppThreads << pppThread;
+        _running = true;
+      }
+    }
   }
   catch (t_except exc) {
     _running = true;
@@ -102,6 +122,9 @@ void t_pppMain::stop() {
     while (it.hasNext()) {
       t_pppThread* pppThread = it.next();
       pppThread->exit();
+      if (_pool) {
+        pppThread->wait();
+      }
       if (BNC_CORE->mode() != t_bncCore::interactive) {
         while(!pppThread->isFinished()) {
           pppThread->wait();
@@ -110,6 +133,9 @@ void t_pppMain::stop() {
       }
     }
     _pppThreads.clear();
+    if (_pool) {
+      _pool->waitForDone();
+    }
  }
 
   _running = false;
@@ -127,7 +153,8 @@ void t_pppMain::readOptions() {
 
   bncSettings settings;
 
-  _realTime = false;
+  _realTime      = false;
+  _workerThreads = 0;
   if      (settings.value("PPP/dataSource").toString() == "Real-Time Streams") {
     _realTime = true;
   }
@@ -137,6 +164,11 @@ void t_pppMain::readOptions() {
   else {
     return;
   }
+#ifdef USE_PPP
+  if (_realTime) {
+    _workerThreads = settings.value("PPP/workerThreads").toInt();
+  }
+#endif
 
   QListIterator<QString> iSta(settings.value("PPP/staTable").toStringList());
   while (iSta.hasNext()) {
@@ -470,6 +502,7 @@ void t_pppMain::readOptions() {
     opt->_eleWgtCode  = (settings.value("PPP/eleWgtCode").toInt() != 0);
     opt->_eleWgtPhase = (settings.value("PPP/eleWgtPhase").toInt() != 0);
     opt->_seedingTime = settings.value("PPP/seedingTime").toDouble();
+    opt->_seqFilterUpdate = (settings.value("PPP/filterUpdate").toString() == "Sequential");
 
     // Some default values
     // -------------------
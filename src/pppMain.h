@@ -20,8 +20,10 @@ class t_pppMain {
 
   QList<t_pppOptions*> _options;
   QList<t_pppThread*>  _pppThreads;
+  QThreadPool*         _pool;
   bool     _running;
   bool     _realTime;
+  int      _workerThreads;
 };
 
 }; // namespace BNC_PPP
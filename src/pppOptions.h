@@ -81,6 +81,7 @@ class t_pppOptions {
   std::vector<char>       _frqBandsBDS;
   bool                    _pseudoObsIono;
   bool                    _refSatRequired;
+  bool                    _seqFilterUpdate;
 };
 
 }
@@ -63,9 +63,12 @@ using namespace std;
 
 // Constructor
 ////////////////////////////////////////////////////////////////////////////
-t_pppRun::t_pppRun(const t_pppOptions* opt) {
+t_pppRun::t_pppRun(const t_pppOptions* opt, QThreadPool* pool) {
 
-  _opt = opt;
+  _opt          = opt;
+  _pool         = pool;
+  _epoInProcess = 0;
+  _taskState    = QSharedPointer<t_taskState>(new t_taskState);
 
   connect(this, SIGNAL(newMessage(QByteArray,bool)),
           BNC_CORE, SLOT(slotMessage(const QByteArray,bool)));
@@ -86,9 +89,15 @@ t_pppRun::t_pppRun(const t_pppOptions* opt) {
       conType = Qt::BlockingQueuedConnection;
     }
 
-    connect(BNC_CORE->caster(), SIGNAL(newObs(QByteArray, QList<t_satObs>)),
-            this, SLOT(slotNewObs(QByteArray, QList<t_satObs>)),conType);
+    // Observations of the rover only (routed by station ID)
+    // ----------------------------------------------------
+    bncObsRoute* obsRoute = BNC_CORE->caster()->obsRoute(QByteArray(_opt->_roverName.c_str()));
+    connect(obsRoute, SIGNAL(newObs(QByteArray, t_satObsBatch)),
+            this, SLOT(slotNewObs(QByteArray, t_satObsBatch)),conType);
 
+#ifdef USE_PPP_SSR_I
+    // Ephemerides and corrections (the PPP client uses a shared store otherwise)
+    // --------------------------------------------------------------------------
     connect(BNC_CORE, SIGNAL(newGPSEph(t_ephGPS)),
             this, SLOT(slotNewGPSEph(t_ephGPS)),conType);
 
@@ -124,6 +133,7 @@ t_pppRun::t_pppRun(const t_pppOptions* opt) {
 
     connect(BNC_CMB, SIGNAL(newCodeBiases(QList<t_satCodeBias>)),
             this, SLOT(slotNewCodeBiases(QList<t_satCodeBias>)),conType);
+#endif
 
     connect(BNC_CORE, SIGNAL(providerIDChanged(QString)),
             this, SLOT(slotProviderIDChanged(QString)));
@@ -231,6 +241,9 @@ t_pppRun::t_pppRun(const t_pppOptions* opt) {
 // Destructor
 ////////////////////////////////////////////////////////////////////////////
 t_pppRun::~t_pppRun() {
+  waitForEpochTask();
+  delete _epoInProcess;
+  delete _pppClient;
   delete _logFile;
   delete _nmeaFile;
   delete _snxtroFile;
@@ -270,7 +283,7 @@ void t_pppRun::slotNewBDSEph(t_ephBDS eph) {
 
 //
 ////////////////////////////////////////////////////////////////////////////
-void t_pppRun::slotNewObs(QByteArray staID, QList<t_satObs> obsList) {
+void t_pppRun::slotNewObs(QByteArray staID, t_satObsBatch obsBatch) {
   QMutexLocker locker(&_mutex);
 
   if (string(staID.data()) != _opt->_roverName) {
@@ -284,17 +297,14 @@ void t_pppRun::slotNewObs(QByteArray staID, QList<t_satObs> obsList) {
 */
   // Loop over all observations (possible different epochs)
   // -----------------------------------------------------
-  QListIterator<t_satObs> it(obsList);
-  while (it.hasNext()) {
-    const t_satObs& oldObs = it.next();
-    t_satObs*       newObs = new t_satObs(oldObs);
+  for (int iObs = 0; iObs < obsBatch->size(); iObs++) {
+    const t_satObs* newObs = &obsBatch->at(iObs);
 
     /* Check regarding current time
     // ----------------------------
     if (OPT->_realTime && BNC_CORE->mode() != t_bncCore::batchPostProcessing ) {
       if ((newObs->_time >= currentTime) ||        // future time stamp
           (currentTime - newObs->_time) > 60.0) {  // very old data sets
-        delete newObs;
         continue;
       }
     }
@@ -317,13 +327,13 @@ void t_pppRun::slotNewObs(QByteArray staID, QList<t_satObs> obsList) {
       }
     }
 
-    // Put data into the epoch
-    // -----------------------
+    // Put data into the epoch (the batch is shared, not copied)
+    // ---------------------------------------------------------
     if (epoch != 0) {
       epoch->_satObs.push_back(newObs);
-    }
-    else {
-      delete newObs;
+      if (epoch->_batches.isEmpty() || epoch->_batches.last() != obsBatch) {
+        epoch->_batches.append(obsBatch);
+      }
     }
   }
 
@@ -337,9 +347,19 @@ void t_pppRun::slotNewObs(QByteArray staID, QList<t_satObs> obsList) {
 
   // Process the oldest epochs
   // ------------------------
-  while (_epoData.size()) {
+  processEpochs();
+}
 
-    const vector<t_satObs*>& satObs = _epoData.front()->_satObs;
+// Process the oldest epochs, in the worker pool one epoch at a time so that
+// the epochs of a rover are processed in order
+////////////////////////////////////////////////////////////////////////////
+void t_pppRun::processEpochs() {
+
+  while (_epoData.size() && _epoInProcess == 0) {
+
+#ifdef USE_PPP
+    _lastClkCorrTime = _pppClient->corrStore()->snapshot()->lastClkCorrTime();
+#endif
 
     // No corrections yet, skip the epoch
     // ----------------------------------
@@ -359,60 +379,21 @@ void t_pppRun::slotNewObs(QByteArray staID, QList<t_satObs> obsList) {
         continue;
       }
 
-      t_output output;
-      _pppClient->processEpoch(satObs, &output);
-
-      if (!output._error) {
-        QVector<double> xx(6);
-        xx.data()[0] = output._xyzRover[0];
-        xx.data()[1] = output._xyzRover[1];
-        xx.data()[2] = output._xyzRover[2];
-        xx.data()[3] = output._neu[0];
-        xx.data()[4] = output._neu[1];
-        xx.data()[5] = output._neu[2];
-        emit newPosition(staID, output._epoTime, xx);
-      }
-
-      delete _epoData.front();
+      _epoInProcess = _epoData.front();
       _epoData.pop_front();
 
-      ostringstream log;
-      if (output._error) {
-        log << output._log;
-      }
-      else {
-        log.setf(ios::fixed);
-        log << string(output._epoTime) << ' ' << staID.data()
-            << " X = "  << setprecision(4) << output._xyzRover[0]
-            << " Y = "  << setprecision(4) << output._xyzRover[1]
-            << " Z = "  << setprecision(4) << output._xyzRover[2]
-            << " NEU: " << showpos << setw(8) << setprecision(4) << output._neu[0]
-            << " "      << showpos << setw(8) << setprecision(4) << output._neu[1]
-            << " "      << showpos << setw(8) << setprecision(4) << output._neu[2]
-            << " TRP: " << showpos << setw(8) << setprecision(4) << output._trp0
-            << " "      << showpos << setw(8) << setprecision(4) << output._trp;
-      }
-
-      if (_logFile && output._epoTime.valid()) {
-          _logFile->write(output._epoTime.gpsw(), output._epoTime.gpssec(),
-                        QString(output._log.c_str()));
+      if (_pool) {
+        _poolOutput = t_output();
+        _taskState->_mutex.lock();
+        _taskState->_running = true;
+        _taskState->_mutex.unlock();
+        _pool->start(new t_epochTask(this));
+        return;
       }
 
-      if (!output._error) {
-        QString rmcStr = nmeaString('R', output);
-        QString ggaStr = nmeaString('G', output);
-        if (_nmeaFile) {
-          _nmeaFile->write(output._epoTime.gpsw(), output._epoTime.gpssec(), rmcStr);
-          _nmeaFile->write(output._epoTime.gpsw(), output._epoTime.gpssec(), ggaStr);
-        }
-        emit newNMEAstr(staID, rmcStr.toLatin1());
-        emit newNMEAstr(staID, ggaStr.toLatin1());
-        if (_snxtroFile && output._epoTime.valid()) {
-          _snxtroFile->write(staID, int(output._epoTime.gpsw()), output._epoTime.gpssec(),
-                      output._trp0 + output._trp, output._trpStdev);
-        }
-      }
-      emit newMessage(QByteArray(log.str().c_str()), true);
+      t_output output;
+      _pppClient->processEpoch(_epoInProcess->_satObs, &output);
+      finishEpoch(output);
     }
     else {
       return;
@@ -420,6 +401,96 @@ void t_pppRun::slotNewObs(QByteArray staID, QList<t_satObs> obsList) {
   }
 }
 
+// Runs in a thread of the worker pool
+////////////////////////////////////////////////////////////////////////////
+void t_pppRun::processEpochInPool() {
+  _pppClient->processEpoch(_epoInProcess->_satObs, &_poolOutput);
+
+  // Last access to the object, t_epochTask clears the running flag afterwards
+  // -------------------------------------------------------------------------
+  QMetaObject::invokeMethod(this, "slotEpochProcessed", Qt::QueuedConnection);
+}
+
+//
+////////////////////////////////////////////////////////////////////////////
+void t_pppRun::waitForEpochTask() {
+  QMutexLocker locker(&_taskState->_mutex);
+  while (_taskState->_running) {
+    _taskState->_done.wait(&_taskState->_mutex);
+  }
+}
+
+//
+////////////////////////////////////////////////////////////////////////////
+void t_pppRun::slotEpochProcessed() {
+  waitForEpochTask(); // the worker may not have cleared the flag yet
+  QMutexLocker locker(&_mutex);
+  if (_epoInProcess == 0) {
+    return;
+  }
+  finishEpoch(_poolOutput);
+  processEpochs();
+}
+
+// Output of the processed epoch
+////////////////////////////////////////////////////////////////////////////
+void t_pppRun::finishEpoch(const t_output& output) {
+
+  QByteArray staID(_opt->_roverName.c_str());
+
+  if (!output._error) {
+    QVector<double> xx(6);
+    xx.data()[0] = output._xyzRover[0];
+    xx.data()[1] = output._xyzRover[1];
+    xx.data()[2] = output._xyzRover[2];
+    xx.data()[3] = output._neu[0];
+    xx.data()[4] = output._neu[1];
+    xx.data()[5] = output._neu[2];
+    emit newPosition(staID, output._epoTime, xx);
+  }
+
+  delete _epoInProcess;
+  _epoInProcess = 0;
+
+  ostringstream log;
+  if (output._error) {
+    log << output._log;
+  }
+  else {
+    log.setf(ios::fixed);
+    log << string(output._epoTime) << ' ' << staID.data()
+        << " X = "  << setprecision(4) << output._xyzRover[0]
+        << " Y = "  << setprecision(4) << output._xyzRover[1]
+        << " Z = "  << setprecision(4) << output._xyzRover[2]
+        << " NEU: " << showpos << setw(8) << setprecision(4) << output._neu[0]
+        << " "      << showpos << setw(8) << setprecision(4) << output._neu[1]
+        << " "      << showpos << setw(8) << setprecision(4) << output._neu[2]
+        << " TRP: " << showpos << setw(8) << setprecision(4) << output._trp0
+        << " "      << showpos << setw(8) << setprecision(4) << output._trp;
+  }
+
+  if (_logFile && output._epoTime.valid()) {
+      _logFile->write(output._epoTime.gpsw(), output._epoTime.gpssec(),
+                    QString(output._log.c_str()));
+  }
+
+  if (!output._error) {
+    QString rmcStr = nmeaString('R', output);
+    QString ggaStr = nmeaString('G', output);
+    if (_nmeaFile) {
+      _nmeaFile->write(output._epoTime.gpsw(), output._epoTime.gpssec(), rmcStr);
+      _nmeaFile->write(output._epoTime.gpsw(), output._epoTime.gpssec(), ggaStr);
+    }
+    emit newNMEAstr(staID, rmcStr.toLatin1());
+    emit newNMEAstr(staID, ggaStr.toLatin1());
+    if (_snxtroFile && output._epoTime.valid()) {
+      _snxtroFile->write(staID, int(output._epoTime.gpsw()), output._epoTime.gpssec(),
+                  output._trp0 + output._trp, output._trpStdev);
+    }
+  }
+  emit newMessage(QByteArray(log.str().c_str()), true);
+}
+
 //
 ////////////////////////////////////////////////////////////////////////////
 void t_pppRun::slotNewTec(t_vTec vTec) {
@@ -639,15 +710,15 @@ void t_pppRun::processFiles() {
 
     // Create list of observations and start epoch processing
     // ------------------------------------------------------
-    QList<t_satObs> obsList;
+    QList<t_satObs>* obsList = new QList<t_satObs>;
     for (unsigned iObs = 0; iObs < epo->rnxSat.size(); iObs++) {
       const t_rnxObsFile::t_rnxSat& rnxSat = epo->rnxSat[iObs];
 
       t_satObs obs;
       t_rnxObsFile::setObsFromRnx(_rnxObsFile, epo, rnxSat, obs);
-      obsList << obs;
+      *obsList << obs;
     }
-    slotNewObs(QByteArray(_opt->_roverName.c_str()), obsList);
+    slotNewObs(QByteArray(_opt->_roverName.c_str()), t_satObsBatch(obsList));
 
 
     if (nEpo % 10 == 0) {
@@ -756,6 +827,7 @@ void t_pppRun::slotProviderIDChanged(QString mountPoint) {
   QString msg = "pppRun " + QString(_opt->_roverName.c_str()) + ": Provider Changed: " + mountPoint;
   emit newMessage(msg.toLatin1(), true);
 
+  waitForEpochTask();
   _pppClient->reset();
 
   while (!_epoData.empty()) {
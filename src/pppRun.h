@@ -20,7 +20,7 @@ namespace BNC_PPP {
 class t_pppRun : public QObject {
  Q_OBJECT
  public:
-  t_pppRun(const t_pppOptions* opt);
+  t_pppRun(const t_pppOptions* opt, QThreadPool* pool = 0);
   ~t_pppRun();
 
   void processFiles();
@@ -44,28 +44,65 @@ class t_pppRun : public QObject {
   void slotNewClkCorrections(QList<t_clkCorr> clkCorr);
   void slotNewCodeBiases(QList<t_satCodeBias> codeBiases);
   void slotNewPhaseBiases(QList<t_satPhaseBias> phaseBiases);
-  void slotNewObs(QByteArray staID, QList<t_satObs> obsList);
+  void slotNewObs(QByteArray staID, t_satObsBatch obsBatch);
   void slotSetSpeed(int speed);
   void slotSetStopFlag();
   void slotProviderIDChanged(QString mountPoint);
 
+ private slots:
+  void slotEpochProcessed();
+
  private:
   class t_epoData {
    public:
     t_epoData() {}
-    ~t_epoData() {
-      for (unsigned ii = 0; ii < _satObs.size(); ii++) {
-        delete _satObs[ii];
-      }
+    ~t_epoData() {}
+    bncTime                      _time;
+    std::vector<const t_satObs*> _satObs;  // point into _batches
+    QList<t_satObsBatch>         _batches;
+  };
+
+  // Completion state of the pool task, owned jointly with the task so that
+  // the worker does not touch the t_pppRun once the waiter can wake up
+  class t_taskState {
+   public:
+    t_taskState() {_running = false;}
+    QMutex         _mutex;
+    QWaitCondition _done;
+    bool           _running;
+  };
+
+  // Processing of one epoch in the worker pool
+  class t_epochTask : public QRunnable {
+   public:
+    t_epochTask(t_pppRun* pppRun) {
+      _pppRun = pppRun;
+      _state  = pppRun->_taskState;
     }
-    bncTime                _time;
-    std::vector<t_satObs*> _satObs;
+    void run() {
+      _pppRun->processEpochInPool();
+      QMutexLocker locker(&_state->_mutex);
+      _state->_running = false;
+      _state->_done.wakeAll();
+    }
+   private:
+    t_pppRun*                   _pppRun;
+    QSharedPointer<t_taskState> _state;
   };
 
+  void processEpochs();
+  void processEpochInPool();
+  void finishEpoch(const t_output& output);
+  void waitForEpochTask();
+
   QMutex                 _mutex;
   const t_pppOptions*    _opt;
   t_pppClient*           _pppClient;
   std::deque<t_epoData*> _epoData;
+  t_epoData*             _epoInProcess;
+  QThreadPool*           _pool;
+  t_output               _poolOutput;
+  QSharedPointer<t_taskState> _taskState;
   bncTime                _lastClkCorrTime;
   t_rnxObsFile*          _rnxObsFile;
   t_rnxNavFile*          _rnxNavFile;
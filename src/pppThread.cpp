@@ -29,7 +29,8 @@
  *
  * Class:      t_pppThread, t_pppRun
  *
- * Purpose:    Single PPP Client (running in its own thread)
+ * Purpose:    Single PPP Client (running in its own thread) or all
+ *             real-time PPP Clients processed by a worker pool
  *
  * Author:     L. Mervart
  *
@@ -56,8 +57,23 @@ using namespace std;
 ////////////////////////////////////////////////////////////////////////////
 t_pppThread::t_pppThread(const t_pppOptions* opt) : QThread(0) {
 
-  _opt       = opt;
-  _pppRun    = 0;
+  _opts << opt;
+  _pool      = 0;
+
+  connect(this, SIGNAL(finished()), this, SLOT(deleteLater()));
+
+  connect(this, SIGNAL(newMessage(QByteArray,bool)),
+          BNC_CORE, SLOT(slotMessage(const QByteArray,bool)));
+}
+
+// Constructor (real-time rovers sharing the threads of the worker pool)
+////////////////////////////////////////////////////////////////////////////
+t_pppThread::t_pppThread(const QList<t_pppOptions*>& opts, QThreadPool* pool) : QThread(0) {
+
+  for (int ii = 0; ii < opts.size(); ii++) {
+    _opts << opts[ii];
+  }
+  _pool      = pool;
 
   connect(this, SIGNAL(finished()), this, SLOT(deleteLater()));
 
@@ -68,7 +84,7 @@ t_pppThread::t_pppThread(const t_pppOptions* opt) : QThread(0) {
 // Destructor
 ////////////////////////////////////////////////////////////////////////////
 t_pppThread::~t_pppThread() {
-  delete _pppRun;
+  qDeleteAll(_pppRuns);
 }
 
 // Run (virtual)
@@ -76,17 +92,17 @@ t_pppThread::~t_pppThread() {
 void t_pppThread::run() {
 
   try {
-    _pppRun = new t_pppRun(_opt);
-    if (_opt->_realTime) {
+    for (int ii = 0; ii < _opts.size(); ii++) {
+      _pppRuns << new t_pppRun(_opts[ii], _pool);
+    }
+    if (_opts[0]->_realTime) {
       QThread::exec();
     }
     else {
-      _pppRun->processFiles();
+      _pppRuns[0]->processFiles();
     }
   }
   catch (t_except exc) {
-    _pppRun = 0;
     emit newMessage(QByteArray(exc.what().c_str()), true);
   }
 }
-
@@ -15,6 +15,7 @@ class t_pppThread : public QThread {
  Q_OBJECT
  public:
   t_pppThread(const t_pppOptions* opt);
+  t_pppThread(const QList<t_pppOptions*>& opts, QThreadPool* pool);
   ~t_pppThread();
   virtual void run();
   static void msleep(unsigned long msecs){QThread::msleep(msecs);}
@@ -23,8 +24,9 @@ class t_pppThread : public QThread {
   void newMessage(QByteArray msg, bool showOnScreen);
 
  private:
-  const t_pppOptions* _opt;
-  t_pppRun*           _pppRun;
+  QList<const t_pppOptions*> _opts;
+  QThreadPool*               _pool;
+  QList<t_pppRun*>           _pppRuns;
 };
 
 }
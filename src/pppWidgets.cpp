@@ -97,6 +97,8 @@ t_pppWidgets::t_pppWidgets() {
   _eleWgtPhase  = new QCheckBox();     _eleWgtPhase ->setObjectName("PPP/eleWgtPhase");  _widgets << _eleWgtPhase;
   _seedingTime  = new QLineEdit();     _seedingTime ->setObjectName("PPP/seedingTime");  _widgets << _seedingTime;
   _corrWaitTime = new QSpinBox();      _corrWaitTime->setObjectName("PPP/corrWaitTime"); _widgets << _corrWaitTime;
+  _workerThreads= new QSpinBox();      _workerThreads->setObjectName("PPP/workerThreads"); _widgets << _workerThreads;
+  _filterUpdate = new QComboBox();     _filterUpdate->setObjectName("PPP/filterUpdate"); _widgets << _filterUpdate;
 
   _addStaButton = new QPushButton("Add Station");    _widgets << _addStaButton;
   _delStaButton = new QPushButton("Delete Station"); _widgets << _delStaButton;
@@ -154,6 +156,8 @@ t_pppWidgets::t_pppWidgets() {
 #ifdef USE_PPP
   _constraints->setEditable(false);
   _constraints->addItems(QString("no,Ionosphere: pseudo-obs").split(","));
+  _filterUpdate->setEditable(false);
+  _filterUpdate->addItems(QString("Square root,Sequential").split(","));
 #endif
   _snxtroSampl->setEditable(false);
   _snxtroSampl->addItems(QString("1 sec,5 sec,10 sec,30 sec,60 sec,300 sec").split(","));
@@ -176,6 +180,11 @@ t_pppWidgets::t_pppWidgets() {
   _corrWaitTime->setSingleStep(1);
   _corrWaitTime->setSuffix(" sec");
 
+  _workerThreads->setMinimum(0);
+  _workerThreads->setMaximum(256);
+  _workerThreads->setSingleStep(1);
+  _workerThreads->setSpecialValueText("no");
+
   _staTable->setColumnCount(11);
   _staTable->setRowCount(0);
   _staTable->setHorizontalHeaderLabels(
@@ -205,6 +214,8 @@ t_pppWidgets::t_pppWidgets() {
   // WhatsThis, PPP (2)
   // ------------------
   _corrWaitTime->setWhatsThis(tr("<p>Zero value means that BNC processes each epoch of data immediately after its arrival using satellite clock corrections available at that time.</p><p> Specifying a non-zero value (i.e. 5 sec) means that the epochs of data are buffered and the processing of each epoch is postponed till the satellite clock corrections not older than '5 sec' (example) become available. <i>[key: PPP/corrWaitTime]</i><p>"));
+  _workerThreads->setWhatsThis(tr("<p>By default BNC processes each real-time PPP station in its own thread. Specify a number of worker threads to process the epochs of all stations in a pool of threads instead. The epochs of each station are still processed one after the other.</p><p>This option allows to process many stations on a computer with a few CPU cores. Specifying the number of CPU cores is likely to be an appropriate choice.</p><p>Default is 'no', meaning one thread per station. <i>[key: PPP/workerThreads]</i></p>"));
+  _filterUpdate->setWhatsThis(tr("<p>Select the algorithm of the Kalman filter update.</p><p>'Square root' updates the square root of the covariance matrix of all parameters with all observations of an epoch at once.</p><p>'Sequential' processes the observations one after the other and only uses the non-zero partial derivatives of each observation; it updates a U-D factorization of the covariance matrix, which like the square root keeps the matrix positive definite. It is considerably faster for many satellites. The results agree with 'Square root' up to rounding errors, which may grow for badly conditioned problems, hence it is recommended to compare both options on a representative data set first.</p><p>Default is 'Square root'. <i>[key: PPP/filterUpdate]</i></p>"));
   _seedingTime->setWhatsThis(tr("<p>Enter the length of a startup period in seconds for which you want to fix the PPP solutions to known a priori coordinates as introduced through option 'Coordinates file'. Adjust 'Sigma N/E/H' in the PPP Stations table according to the coordinate's precision. Fixing a priori coordinates is done in BNC through setting 'Noise N/E/H' temporarily to zero.</p><p>This option allows the PPP solution to rapidly converge. It requires that the antenna remains unmoved on the a priori known position throughout the startup period.</p><p>A value of 60 is likely to be an appropriate choice.</p><p>Default is an empty option field, meaning that you don't want BNC to fix PPP solutions during startup to an a priori coordinate. <i>[key: PPP/seedingTime]</i></p>"));
 
   // WhatsThis, PPP (3)
@@ -279,6 +290,8 @@ t_pppWidgets::~t_pppWidgets() {
   delete _eleWgtPhase;
   delete _seedingTime;
   delete _corrWaitTime;
+  delete _workerThreads;
+  delete _filterUpdate;
   delete _addStaButton;
   delete _delStaButton;
   delete _plotCoordinates;
@@ -321,6 +334,10 @@ void t_pppWidgets::readOptions() {
   if (ii != -1) {
     _constraints->setCurrentIndex(ii);
   }
+  ii = _filterUpdate->findText(settings.value(_filterUpdate->objectName()).toString());
+  if (ii != -1) {
+    _filterUpdate->setCurrentIndex(ii);
+  }
   ii = _snxtroIntr->findText(settings.value(_snxtroIntr->objectName()).toString());
   if (ii != -1) {
     _snxtroIntr->setCurrentIndex(ii);
@@ -408,6 +425,7 @@ void t_pppWidgets::readOptions() {
   _minObs->setValue(settings.value(_minObs->objectName()).toInt());
   _minEle->setValue(settings.value(_minEle->objectName()).toInt());
   _corrWaitTime->setValue(settings.value(_corrWaitTime->objectName()).toInt());
+  _workerThreads->setValue(settings.value(_workerThreads->objectName()).toInt());
 
 
   ii = _snxtroSampl->findText(settings.value(_snxtroSampl->objectName()).toString());
@@ -477,10 +495,12 @@ void t_pppWidgets::saveOptions() {
   settings.setValue(_lcGalileo   ->objectName(), _lcGalileo   ->currentText());
   settings.setValue(_lcBDS       ->objectName(), _lcBDS       ->currentText());
   settings.setValue(_constraints ->objectName(), _constraints ->currentText());
+  settings.setValue(_filterUpdate->objectName(), _filterUpdate->currentText());
   settings.setValue(_sigmaC1     ->objectName(), _sigmaC1     ->text());
   settings.setValue(_sigmaL1     ->objectName(), _sigmaL1     ->text());
   settings.setValue(_sigmaGIM    ->objectName(), _sigmaGIM    ->text());
   settings.setValue(_corrWaitTime->objectName(), _corrWaitTime->value());
+  settings.setValue(_workerThreads->objectName(), _workerThreads->value());
   settings.setValue(_maxResC1    ->objectName(), _maxResC1    ->text());
   settings.setValue(_maxResL1    ->objectName(), _maxResL1    ->text());
   settings.setValue(_maxResGIM   ->objectName(), _maxResGIM   ->text());
@@ -539,6 +559,7 @@ void t_pppWidgets::slotEnableWidgets() {
     _corrMount    ->setEnabled(false);
     _ionoMount    ->setEnabled(false);
     _audioResponse->setEnabled(false);
+    _workerThreads->setEnabled(false);
   }
 
   if ( _snxtroPath->text() != "" && !allDisabled) {
@@ -82,6 +82,8 @@ class t_pppWidgets : public QObject {
   QLineEdit*     _seedingTime;
 
   QSpinBox*      _corrWaitTime;
+  QSpinBox*      _workerThreads;
+  QComboBox*     _filterUpdate;
   QPushButton*   _addStaButton;
   QPushButton*   _delStaButton;
 
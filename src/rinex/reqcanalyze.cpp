@@ -350,7 +350,7 @@ void t_reqcAnalyze::setQcObs(const bncTime& epoTime, const ColumnVector& xyzSta,
   // Availability and Slip Flags
   // ---------------------------
   for (unsigned ii = 0; ii < satObs._obs.size(); ii++) {
-    const t_frqObs* frqObs = satObs._obs[ii];
+    const t_frqObs* frqObs = &satObs._obs[ii];
 
     qcSat._qcFrq.push_back(t_qcFrq());
     t_qcFrq& qcFrq = qcSat._qcFrq.back();
@@ -406,7 +406,7 @@ void t_reqcAnalyze::setQcObs(const bncTime& epoTime, const ColumnVector& xyzSta,
           bool   foundB = false;
           double L_b    = 0.0;
           for (unsigned jj = 0; jj < satObs._obs.size(); jj++) {
-            const t_frqObs* frqObsHlp = satObs._obs[jj];
+            const t_frqObs* frqObsHlp = &satObs._obs[jj];
             if      (frqObsHlp->_rnxType2ch[0] == t_frequency::toString(fA)[1] && frqObsHlp->_phaseValid) {
               foundA = true;
               L_a    = frqObsHlp->_phase * t_CST::c / f_a;
@@ -1631,15 +1631,16 @@ void t_rnxObsFile::setObsFromRnx(const t_rnxObsFile* rnxObsFile, const t_rnxObsF
 
         t_frqObs* frqObs = 0;
         for (unsigned iFrq = 0; iFrq < obs._obs.size(); iFrq++) {
-          if (obs._obs[iFrq]->_rnxType2ch == type2ch) {
-            frqObs = obs._obs[iFrq];
+          if (obs._obs[iFrq]._rnxType2ch == type2ch) {
+            frqObs = &obs._obs[iFrq];
             break;
           }
         }
         if (frqObs == 0) {
-          frqObs = new t_frqObs;
-          frqObs->_rnxType2ch = type2ch;
-          obs._obs.push_back(frqObs);
+          t_frqObs newFrqObs;
+          newFrqObs._rnxType2ch = type2ch;
+          obs._obs.push_back(newFrqObs);
+          frqObs = &obs._obs[obs._obs.size() - 1];
         }
 
         switch( typeV3.toLatin1().data()[0] ) {
@@ -1,7 +1,13 @@
 #ifndef SATOBS_H
 #define SATOBS_H
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <ostream>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include <newmat.h>
 
@@ -12,6 +18,45 @@
 #include "t_prn.h"
 #include "ephemeris.h"
 
+// RINEX band and attribute of a signal (e.g. "1C"), stored inline
+class t_rnxType2ch {
+ public:
+  t_rnxType2ch() {
+    _str[0] = _str[1] = _str[2] = '\0';
+  }
+  t_rnxType2ch(const char* str) {
+    assign(str);
+  }
+  t_rnxType2ch(const std::string& str) {
+    assign(str.c_str());
+  }
+  void assign(const char* str) {
+    _str[0] = str[0];
+    _str[1] = str[0] ? str[1] : '\0';
+    _str[2] = '\0';
+  }
+  const char* c_str() const {return _str;}
+  size_t      size() const  {return _str[0] ? (_str[1] ? 2 : 1) : 0;}
+  bool        empty() const {return _str[0] == '\0';}
+  char operator[](size_t ii) const {return _str[ii];}
+  bool operator==(const t_rnxType2ch& other) const {
+    return _str[0] == other._str[0] && _str[1] == other._str[1];
+  }
+  bool operator!=(const t_rnxType2ch& other) const {return !(*this == other);}
+  bool operator==(const std::string& str) const {return str == _str;}
+  bool operator!=(const std::string& str) const {return str != _str;}
+  bool operator==(const char* str) const {return strcmp(str, _str) == 0;}
+  bool operator!=(const char* str) const {return strcmp(str, _str) != 0;}
+  friend std::string operator+(const char* prefix, const t_rnxType2ch& type) {
+    return std::string(prefix) + type._str;
+  }
+  friend std::ostream& operator<<(std::ostream& out, const t_rnxType2ch& type) {
+    return out << type._str;
+  }
+ private:
+  char _str[3];
+};
+
 class t_frqObs  {
  public:
   t_frqObs() {
@@ -30,52 +75,104 @@ class t_frqObs  {
     _biasJumpCounter   =  0;
     _lockTimeIndicator = -1;
   }
-  std::string       _rnxType2ch;
   double            _code;
-  bool              _codeValid;
   double            _phase;
-  bool              _phaseValid;
   double            _doppler;
-  bool              _dopplerValid;
   double            _snr;
-  bool              _snrValid;
   double            _lockTime;
-  bool              _lockTimeValid;
-  bool              _slip;              // RINEX
   int               _slipCounter;       // RTCM2 or converted from RTCM3
   int               _lockTimeIndicator; // RTCM3
   int               _biasJumpCounter;   // ??
+  bool              _codeValid;
+  bool              _phaseValid;
+  bool              _dopplerValid;
+  bool              _snrValid;
+  bool              _lockTimeValid;
+  bool              _slip;              // RINEX
+  t_rnxType2ch      _rnxType2ch;
 };
 
-class t_satObs {
+// Signals of one satellite. Up to numInline signals are kept inside the
+// object, so copying a t_satObs normally needs no heap memory; more
+// signals (e.g. from RINEX files with many observation types) spill over
+// into a heap block. t_frqObs must stay trivially copyable for that.
+static_assert(std::is_trivially_copyable<t_frqObs>::value,
+              "t_frqObsList never runs t_frqObs destructors");
+
+class t_frqObsList {
  public:
-  t_satObs() {
-    _type = 0;
+  enum {numInline = 8};
+  t_frqObsList() {
+    _data     = inlineData();
+    _size     = 0;
+    _capacity = numInline;
+  }
+  t_frqObsList(const t_frqObsList& other) {
+    _data     = inlineData();
+    _size     = 0;
+    _capacity = numInline;
+    *this = other;
   }
-  t_satObs(const t_satObs& old) { // copy constructor (deep copy)
-    _staID = old._staID;
-    _prn   = old._prn;
-    _time  = old._time;
-    _type  = old._type;
-    for (unsigned ii = 0; ii < old._obs.size(); ii++) {
-      _obs.push_back(new t_frqObs(*old._obs[ii]));
+  ~t_frqObsList() {
+    if (_data != inlineData()) {
+      delete [] _data;
     }
   }
-  /**
-   * Destructor of satellite measurement storage class
-   */
-  ~t_satObs() {
-    clear();
+  t_frqObsList& operator=(const t_frqObsList& other) {
+    if (this != &other) {
+      reserve(other._size);
+      std::uninitialized_copy(other._data, other._data + other._size, _data);
+      _size = other._size;
+    }
+    return *this;
+  }
+  unsigned size() const  {return _size;}
+  bool     empty() const {return _size == 0;}
+  t_frqObs&       operator[](unsigned ii)       {return _data[ii];}
+  const t_frqObs& operator[](unsigned ii) const {return _data[ii];}
+  t_frqObs*       begin()       {return _data;}
+  t_frqObs*       end()         {return _data + _size;}
+  const t_frqObs* begin() const {return _data;}
+  const t_frqObs* end() const   {return _data + _size;}
+  void push_back(const t_frqObs& frqObs) {
+    if (_size == _capacity) {
+      reserve(2 * _capacity);
+    }
+    new (_data + _size) t_frqObs(frqObs);
+    ++_size;
+  }
+  void clear() {_size = 0;}
+ private:
+  t_frqObs* inlineData() {return reinterpret_cast<t_frqObs*>(_inline);}
+  const t_frqObs* inlineData() const {return reinterpret_cast<const t_frqObs*>(_inline);}
+  void reserve(unsigned capacity) {
+    if (capacity > _capacity) {
+      t_frqObs* data = new t_frqObs[capacity];
+      std::copy(_data, _data + _size, data);
+      if (_data != inlineData()) {
+        delete [] _data;
+      }
+      _data     = data;
+      _capacity = capacity;
+    }
+  }
+  t_frqObs* _data;
+  unsigned  _size;
+  unsigned  _capacity;
+  std::aligned_storage<sizeof(t_frqObs), alignof(t_frqObs)>::type _inline[numInline];
+};
+
+class t_satObs {
+ public:
+  t_satObs() {
+    _type = 0;
   }
 
   /**
    * Cleanup function resets all elements to initial state.
    */
   inline void clear(void) {
-    for (unsigned ii = 0; ii < _obs.size(); ii++)
-      delete _obs[ii];
     _obs.clear();
-    _obs.resize(0);
     _time.reset();
     _prn.clear();
     _staID.clear();
@@ -86,9 +183,17 @@ class t_satObs {
   t_prn                  _prn;
   bncTime                _time;
   int                    _type; // MT
-  std::vector<t_frqObs*> _obs;
+  t_frqObsList           _obs;
 };
 
+/**
+ * Observations decoded from one chunk of a stream, published once and shared
+ * read-only by all consumers (caster, PPP, MQTT). Consumers that need to
+ * annotate the observations keep their own overlay instead of copying.
+ */
+typedef QSharedPointer<const QList<t_satObs> > t_satObsBatch;
+Q_DECLARE_METATYPE(t_satObsBatch)
+
 class t_orbCorr {
  public:
   t_orbCorr();
@@ -49,9 +49,10 @@ HEADERS = bnchelp.html bncgetthread.h    bncwindow.h   bnctabledlg.h  \
           bncnetqueryudp0.h bncudpport.h bnctime.h                    \
           bncserialport.h bncnetquerys.h bncfigure.h                  \
           bncfigurelate.h bncversion.h                                \
-          bncfigureppp.h bncrawfile.h                                 \
+          bncfigureppp.h bncrawfile.h bncingestpool.h                 \
           bncmap.h bncantex.h bncephuser.h                            \
           bncoutf.h bncclockrinex.h bncsp3.h bncsinextro.h            \
+          bncoutsockets.h                                             \
           bncbiassinex.h                                              \
           bncbytescounter.h bncsslconfig.h reqcdlg.h                  \
           upload/bncrtnetdecoder.h upload/bncuploadcaster.h           \
@@ -63,8 +64,9 @@ HEADERS = bnchelp.html bncgetthread.h    bncwindow.h   bnctabledlg.h  \
           RTCM/RTCM2.h RTCM/RTCM2Decoder.h                            \
           RTCM/RTCM2_2021.h RTCM/rtcm_utils.h                         \
           RTCM3/RTCM3Decoder.h RTCM3/bits.h RTCM3/gnss.h              \
+          RTCM3/bitReader.h                                           \
           RTCM3/RTCM3coDecoder.h RTCM3/ephEncoder.h                   \
-          RTCM3/crs.h RTCM3/crsEncoder.h                              \
+          RTCM3/crs.h RTCM3/crsEncoder.h RTCM3/RTCM3Framer.h          \
           RTCM3/clock_and_orbit/clock_orbit.h                         \
           RTCM3/clock_and_orbit/clock_orbit_igs.h                     \
           RTCM3/clock_and_orbit/clock_orbit_rtcm.h                    \
@@ -75,7 +77,10 @@ HEADERS = bnchelp.html bncgetthread.h    bncwindow.h   bnctabledlg.h  \
           rinex/availplot.h        rinex/eleplot.h                    \
           rinex/dopplot.h          orbComp/sp3Comp.h                  \
           combination/bnccomb.h combination/bncbiassnx.h              \
-          MQTT/jsonMessage.h      MQTT/mqttClient.h
+          MQTT/jsonMessage.h      MQTT/mqttClient.h                   \
+          MQTT/mqttPublisher.h    MQTT/stationStats.h                 \
+          MQTT/mqttOfflineQueue.h MQTT/messageEncoder.h               \
+          MQTT/mqttDataOutput.h
 
 HEADERS       += serial/qextserialbase.h serial/qextserialport.h
 unix:HEADERS  += serial/posix_qextserialport.h
@@ -90,9 +95,10 @@ SOURCES = bncgetthread.cpp  bncwindow.cpp bnctabledlg.cpp             \
           bncnetqueryudp0.cpp bncudpport.cpp                          \
           bncserialport.cpp bncnetquerys.cpp bncfigure.cpp            \
           bncfigurelate.cpp bnctime.cpp                               \
-          bncfigureppp.cpp bncrawfile.cpp                             \
+          bncfigureppp.cpp bncrawfile.cpp bncingestpool.cpp           \
           bncmap_svg.cpp bncantex.cpp bncephuser.cpp                  \
           bncoutf.cpp bncclockrinex.cpp bncsp3.cpp bncsinextro.cpp    \
+          bncoutsockets.cpp                                           \
           bncbiassinex.cpp                                            \
           bncbytescounter.cpp bncsslconfig.cpp reqcdlg.cpp            \
           ephemeris.cpp t_prn.cpp satObs.cpp                          \
@@ -106,7 +112,7 @@ SOURCES = bncgetthread.cpp  bncwindow.cpp bnctabledlg.cpp             \
           RTCM/RTCM2_2021.cpp RTCM/rtcm_utils.cpp                     \
           RTCM3/RTCM3Decoder.cpp                                      \
           RTCM3/RTCM3coDecoder.cpp RTCM3/ephEncoder.cpp               \
-          RTCM3/crsEncoder.cpp                                        \
+          RTCM3/crsEncoder.cpp RTCM3/RTCM3Framer.cpp                  \
           RTCM3/clock_and_orbit/clock_orbit_igs.cpp                   \
           RTCM3/clock_and_orbit/clock_orbit_rtcm.cpp                  \
           rinex/rnxobsfile.cpp                                        \
@@ -116,7 +122,10 @@ SOURCES = bncgetthread.cpp  bncwindow.cpp bnctabledlg.cpp             \
           rinex/availplot.cpp      rinex/eleplot.cpp                  \
           rinex/dopplot.cpp        orbComp/sp3Comp.cpp                \
           combination/bnccomb.cpp combination/bncbiassnx.cpp          \
-          MQTT/jsonMessage.cpp      MQTT/mqttClient.cpp
+          MQTT/jsonMessage.cpp      MQTT/mqttClient.cpp               \
+          MQTT/mqttPublisher.cpp    MQTT/stationStats.cpp             \
+          MQTT/mqttOfflineQueue.cpp MQTT/messageEncoder.cpp           \
+          MQTT/mqttDataOutput.cpp
 
 SOURCES       += serial/qextserialbase.cpp serial/qextserialport.cpp
 unix:SOURCES  += serial/posix_qextserialport.cpp
@@ -129,10 +138,10 @@ QT += network
 exists(PPP) {
   INCLUDEPATH += PPP
   DEFINES += USE_PPP
-  HEADERS += PPP/pppClient.h    PPP/pppObsPool.h   PPP/pppEphPool.h   \
+  HEADERS += PPP/pppClient.h    PPP/pppObsPool.h   PPP/pppCorrStore.h \
              PPP/pppStation.h   PPP/pppFilter.h    PPP/pppParlist.h   \
              PPP/pppSatObs.h    PPP/pppRefSat.h
-  SOURCES += PPP/pppClient.cpp  PPP/pppObsPool.cpp PPP/pppEphPool.cpp \
+  SOURCES += PPP/pppClient.cpp  PPP/pppObsPool.cpp PPP/pppCorrStore.cpp \
              PPP/pppStation.cpp PPP/pppFilter.cpp  PPP/pppParlist.cpp \
              PPP/pppSatObs.cpp
 }
@@ -0,0 +1,159 @@
+//
+// Kalman update benchmark: square-root kalman() against kalmanSequential()
+// on PPP-shaped epochs (coordinates, receiver clock, troposphere and one
+// ambiguity per satellite; code and phase ionosphere-free observations).
+// The receiver clock is reset every epoch as in t_pppParam::clkR and both
+// filters run side by side over the whole sequence, the maximum differences
+// of the states and (normalized) covariance matrices are reported.
+//
+// Usage: bench_kalman [numEpochs] [repeats]
+//        (default: 2880 epochs, 3 repeats)
+//
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <newmat.h>
+
+#include "bncutils.h"
+
+namespace {
+
+struct t_epoch {
+    Matrix         AA;
+    ColumnVector   ll;
+    DiagonalMatrix PP;
+};
+
+double rnd() {
+    return rand() / double(RAND_MAX);
+}
+
+// Epochs of a static station observing numSat satellites
+// ----------------------------------------------------------------------------
+std::vector<t_epoch> makeEpochs(int numSat, int numEpochs) {
+    const int nPar = 5 + numSat;
+    const double crd[3] = {0.8, -1.3, 2.1};
+    std::vector<double> ele(numSat), azi(numSat), amb(numSat);
+    for (int iSat = 0; iSat < numSat; iSat++) {
+        ele[iSat] = 0.2 + 1.2 * rnd();
+        azi[iSat] = 2.0 * M_PI * rnd();
+        amb[iSat] = 100.0 * rnd();
+    }
+
+    std::vector<t_epoch> epochs(numEpochs);
+    for (int iEpo = 0; iEpo < numEpochs; iEpo++) {
+        t_epoch& epo = epochs[iEpo];
+        int nObs = 2 * numSat;
+        epo.AA.ReSize(nObs, nPar); epo.AA = 0.0;
+        epo.ll.ReSize(nObs);
+        epo.PP.ReSize(nObs);
+        double clk = 1.0e3 * rnd();
+        double trp = 0.05;
+        for (int iSat = 0; iSat < numSat; iSat++) {
+            double ee  = ele[iSat] + 0.3 * sin(2.0 * M_PI * iEpo / numEpochs + iSat);
+            ee = ee < 0.1 ? 0.1 : ee;
+            double mf  = 1.0 / sin(ee);
+            double rho[3] = {cos(ee) * sin(azi[iSat]), cos(ee) * cos(azi[iSat]), sin(ee)};
+            for (int ii = 0; ii < 2; ii++) {
+                int    iObs = 2 * iSat + ii + 1;
+                double sig  = (ii == 0 ? 1.0 : 0.01) * mf;
+                double obs  = clk + trp * mf + (ii == 1 ? amb[iSat] : 0.0);
+                for (int jj = 0; jj < 3; jj++) {
+                    epo.AA(iObs, jj + 1) = -rho[jj];
+                    obs -= rho[jj] * crd[jj];
+                }
+                epo.AA(iObs, 4) = 1.0;
+                epo.AA(iObs, 5) = mf;
+                if (ii == 1) {
+                    epo.AA(iObs, 6 + iSat) = 1.0;
+                }
+                epo.ll(iObs)       = obs + sig * (2.0 * rnd() - 1.0);
+                epo.PP(iObs, iObs) = 1.0 / (sig * sig);
+            }
+        }
+    }
+    return epochs;
+}
+
+// A priori covariance matrix and process noise of the receiver clock
+// ----------------------------------------------------------------------------
+void initFilter(int nPar, SymmetricMatrix& QQ, ColumnVector& xx) {
+    QQ.ReSize(nPar); QQ = 0.0;
+    xx.ReSize(nPar); xx = 0.0;
+    for (int ii = 1; ii <= 3; ii++) {
+        QQ(ii, ii) = 100.0 * 100.0;
+    }
+    QQ(5, 5) = 0.1 * 0.1;
+    for (int ii = 6; ii <= nPar; ii++) {
+        QQ(ii, ii) = 1.0e4 * 1.0e4;
+    }
+}
+
+void resetClock(SymmetricMatrix& QQ, ColumnVector& xx) {
+    for (int ii = 1; ii <= QQ.Nrows(); ii++) {
+        QQ(4, ii) = 0.0;
+    }
+    QQ(4, 4) = 3.0e5 * 3.0e5;
+    xx(4)    = 0.0;
+}
+
+typedef void (*t_update)(const Matrix&, const ColumnVector&, const DiagonalMatrix&,
+                         SymmetricMatrix&, ColumnVector&);
+
+double run(const std::vector<t_epoch>& epochs, t_update update, int repeats,
+           SymmetricMatrix& QQ, ColumnVector& xx) {
+    QElapsedTimer timer;
+    timer.start();
+    for (int rr = 0; rr < repeats; rr++) {
+        initFilter(epochs[0].AA.Ncols(), QQ, xx);
+        for (size_t iEpo = 0; iEpo < epochs.size(); iEpo++) {
+            resetClock(QQ, xx);
+            update(epochs[iEpo].AA, epochs[iEpo].ll, epochs[iEpo].PP, QQ, xx);
+        }
+    }
+    return timer.nsecsElapsed() / 1.0e3 / (repeats * double(epochs.size()));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QStringList args = app.arguments();
+    int numEpochs = args.size() > 1 ? args[1].toInt() : 2880;
+    int repeats   = args.size() > 2 ? args[2].toInt() : 3;
+    const int numSats[] = {8, 16, 32, 48, 64};
+
+    printf("%d epochs, %d passes\n", numEpochs, repeats);
+    printf("%5s %5s %5s %14s %14s %8s %10s %10s\n", "sats", "obs", "pars",
+           "kalman us/epo", "seq us/epo", "speedup", "max dx", "max dQ");
+
+    for (int numSat : numSats) {
+        srand(1);
+        std::vector<t_epoch> epochs = makeEpochs(numSat, numEpochs);
+
+        SymmetricMatrix QQ1, QQ2;
+        ColumnVector    xx1, xx2;
+        double usKalman = run(epochs, kalman,           repeats, QQ1, xx1);
+        double usSeq    = run(epochs, kalmanSequential, repeats, QQ2, xx2);
+
+        double maxDx = (xx1 - xx2).MaximumAbsoluteValue();
+        double maxDQ = 0.0;
+        for (int ii = 1; ii <= QQ1.Nrows(); ii++) {
+            for (int jj = 1; jj <= ii; jj++) {
+                double dQ = fabs(QQ1(ii, jj) - QQ2(ii, jj)) / sqrt(QQ1(ii, ii) * QQ1(jj, jj));
+                maxDQ = dQ > maxDQ ? dQ : maxDQ;
+            }
+        }
+        printf("%5d %5d %5d %14.1f %14.1f %8.1f %10.2e %10.2e\n",
+               numSat, epochs[0].AA.Nrows(), epochs[0].AA.Ncols(),
+               usKalman, usSeq, usKalman / usSeq, maxDx, maxDQ);
+    }
+    return 0;
+}
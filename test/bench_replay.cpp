@@ -0,0 +1,362 @@
+//
+// Replay benchmark: decodes a BNC raw file (as written with "rawOutFile")
+// stage by stage without GUI, caster or network and reports throughput
+// and heap allocations per epoch.
+//
+//   RTCM3Decoder    all RTCM_3 chunks, as bncGetThread feeds them
+//   RTCM3coDecoder  SSR frames of the RTCM_3 streams only
+//   RTCM2Decoder    all RTCM_2 chunks
+//   RINEX           decoded observations through bncRinex
+//
+// The file is read and decoded once before the timed passes, so neither
+// file I/O nor first-time initialisation is measured.
+//
+// Usage: bench_replay [rawFile] [repeats]
+//        (default: test/data/replay_sample.raw, 10 repeats)
+//
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "bnccore.h"
+#include "bncrawfile.h"
+#include "bncrinex.h"
+#include "bncsettings.h"
+#include "bncutils.h"
+#include "RTCM/RTCM2Decoder.h"
+#include "RTCM3/RTCM3Decoder.h"
+#include "RTCM3/RTCM3coDecoder.h"
+#include "RTCM3/RTCM3Framer.h"
+
+#ifndef BNC_TEST_DATA_DIR
+#define BNC_TEST_DATA_DIR "test/data"
+#endif
+
+// Heap allocation counter
+// ----------------------------------------------------------------------------
+static std::atomic<unsigned long> g_allocs(0);
+
+void* operator new(size_t size) {
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    free(p);
+}
+
+namespace {
+
+struct t_chunk {
+    QDateTime  time;
+    QByteArray staID;
+    QByteArray format;
+    QByteArray data;
+};
+
+struct t_ssrFrames {
+    QByteArray        staID;
+    bool              igs;
+    QList<QDateTime>  times;
+    QList<QByteArray> frames;
+};
+
+struct t_rnxInput {
+    QByteArray      format;
+    QList<t_satObs> obs;
+};
+
+struct t_result {
+    t_result() : bytes(0), frames(0), epochs(0), allocs(0), sec(0.0) {}
+    double        bytes;
+    unsigned long frames;
+    unsigned long epochs;
+    unsigned long allocs;
+    double        sec;
+};
+
+bool isSsrType(int type) {
+    return (type >= 1057 && type <= 1068) ||
+           (type >= 1240 && type <= 1270) ||
+           type == 4076;
+}
+
+// Number of new epochs in obsList, lastTime is kept across calls
+unsigned long countEpochs(const QList<t_satObs>& obsList, bncTime& lastTime) {
+    unsigned long nEpochs = 0;
+    for (int ii = 0; ii < obsList.size(); ii++) {
+        if (obsList[ii]._time != lastTime) {
+            lastTime = obsList[ii]._time;
+            nEpochs++;
+        }
+    }
+    return nEpochs;
+}
+
+// Decoder stage: one decoder per station, chunks in recording order
+// ----------------------------------------------------------------------------
+t_result runDecoders(const QList<t_chunk>& chunks, const QByteArray& format,
+                     QMap<QByteArray, t_rnxInput>* rnxInput) {
+    t_result res;
+    QMap<QByteArray, GPSDecoder*> decoders;
+    QMap<QByteArray, bncTime>     lastTime;
+    std::vector<std::string>      errmsg;
+
+    unsigned long allocs0 = g_allocs.load();
+    QElapsedTimer timer;
+    timer.start();
+    for (int ii = 0; ii < chunks.size(); ii++) {
+        const t_chunk& chunk = chunks[ii];
+        if (chunk.format != format) {
+            continue;
+        }
+        GPSDecoder* decoder = decoders.value(chunk.staID, 0);
+        if (!decoder) {
+            if (format == "RTCM_3") {
+                decoder = new RTCM3Decoder(chunk.staID, 0);
+            }
+            else {
+                decoder = new RTCM2Decoder(chunk.staID.data());
+            }
+            decoders[chunk.staID] = decoder;
+        }
+        BNC_CORE->setDateAndTimeGPS(chunk.time);
+        QByteArray data = chunk.data;
+        decoder->Decode(data.data(), data.size(), errmsg);
+
+        res.bytes  += data.size();
+        res.frames += decoder->_typeList.size();
+        res.epochs += countEpochs(decoder->_obsList, lastTime[chunk.staID]);
+        if (rnxInput && !decoder->_obsList.isEmpty()) {
+            t_rnxInput& inp = (*rnxInput)[chunk.staID];
+            inp.format = format;
+            inp.obs.append(decoder->_obsList);
+        }
+        decoder->_typeList.clear();
+        decoder->_obsList.clear();
+    }
+    res.sec    = timer.nsecsElapsed() / 1.0e9;
+    res.allocs = g_allocs.load() - allocs0;
+
+    qDeleteAll(decoders);
+    return res;
+}
+
+// SSR stage: standalone RTCM3coDecoder per station, one frame per call
+// ----------------------------------------------------------------------------
+t_result runCoDecoders(const QList<t_ssrFrames>& ssrFrames) {
+    t_result res;
+    std::vector<std::string> errmsg;
+
+    unsigned long allocs0 = g_allocs.load();
+    QElapsedTimer timer;
+    timer.start();
+    for (int ii = 0; ii < ssrFrames.size(); ii++) {
+        const t_ssrFrames& sta = ssrFrames[ii];
+        RTCM3coDecoder coDecoder(sta.staID);
+        coDecoder.initSsrFormatType(sta.igs ? RTCM3coDecoder::IGSssr : RTCM3coDecoder::RTCMssr);
+        int lastEpoch = -1;
+        for (int jj = 0; jj < sta.frames.size(); jj++) {
+            BNC_CORE->setDateAndTimeGPS(sta.times[jj]);
+            QByteArray frame = sta.frames[jj];
+            if (coDecoder.Decode(frame.data(), frame.size(), errmsg) == success &&
+                coDecoder.corrGPSEpochTime() != lastEpoch) {
+                lastEpoch = coDecoder.corrGPSEpochTime();
+                res.epochs++;
+            }
+            res.bytes += frame.size();
+            res.frames++;
+        }
+    }
+    res.sec    = timer.nsecsElapsed() / 1.0e9;
+    res.allocs = g_allocs.load() - allocs0;
+    return res;
+}
+
+// RINEX stage: as GPSDecoder::dumpRinexEpoch, one bncRinex per station
+// ----------------------------------------------------------------------------
+t_result runRinex(const QMap<QByteArray, t_rnxInput>& rnxInput, const QString& rnxPath) {
+    t_result res;
+
+    // Files of earlier passes would be counted as output of this one
+    QDir dir(rnxPath);
+    foreach (const QString& name, dir.entryList(QDir::Files)) {
+        dir.remove(name);
+    }
+
+    unsigned long allocs0 = g_allocs.load();
+    QElapsedTimer timer;
+    timer.start();
+    QMapIterator<QByteArray, t_rnxInput> it(rnxInput);
+    while (it.hasNext()) {
+        it.next();
+        const t_rnxInput& inp = it.value();
+        bncRinex rnx(it.key(), QUrl("http://replay/" + QString(it.key())), "", "", "", "2");
+        bncTime lastTime;
+        for (int ii = 0; ii < inp.obs.size(); ii++) {
+            const t_satObs& obs = inp.obs[ii];
+            int sec = int(nint(obs._time.gpssec()*10));
+            if (sec % rnx.samplingRate() == 0) {
+                rnx.deepCopy(obs);
+            }
+            rnx.dumpEpoch(inp.format, obs._time);
+            if (obs._time != lastTime) {
+                lastTime = obs._time;
+                res.epochs++;
+            }
+        }
+    }
+    res.sec    = timer.nsecsElapsed() / 1.0e9;
+    res.allocs = g_allocs.load() - allocs0;
+
+    // Output volume of the pass (bncRinex closes its file on destruction)
+    dir.refresh();
+    foreach (const QFileInfo& info, dir.entryInfoList(QDir::Files)) {
+        res.bytes += info.size();
+    }
+    return res;
+}
+
+void report(const char* stage, const QList<t_result>& passes) {
+    t_result sum;
+    for (int ii = 0; ii < passes.size(); ii++) {
+        sum.bytes  += passes[ii].bytes;
+        sum.frames += passes[ii].frames;
+        sum.epochs += passes[ii].epochs;
+        sum.allocs += passes[ii].allocs;
+        sum.sec    += passes[ii].sec;
+    }
+    if (sum.sec <= 0.0) {
+        printf("%-16s %10s\n", stage, "no data");
+        return;
+    }
+    printf("%-16s %10.2f %12.0f %12.0f %14.1f\n", stage,
+           sum.bytes / 1.0e6 / sum.sec,
+           sum.frames / sum.sec,
+           sum.epochs / sum.sec,
+           sum.epochs ? double(sum.allocs) / sum.epochs : 0.0);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QStringList args     = app.arguments();
+    QString     fileName = args.size() > 1 ? args[1]
+                                           : QString(BNC_TEST_DATA_DIR "/replay_sample.raw");
+    int         repeats  = args.size() > 2 ? args[2].toInt() : 10;
+
+    // Default options from an empty configuration, RINEX into a scratch dir
+    // ----------------------------------------------------------------------
+    QTemporaryDir tmpDir;
+    BNC_CORE->setConfFileName(tmpDir.path() + "/bench_replay.bnc");
+    BNC_CORE->setMode(t_bncCore::batchPostProcessing);
+    QString rnxPath = tmpDir.path() + "/rinex";
+    QDir().mkpath(rnxPath);
+    {
+        bncSettings settings;
+        settings.setValue("rnxPath", rnxPath);
+    }
+
+    // Read all chunks
+    // ---------------
+    if (!QFile::exists(fileName)) {
+        fprintf(stderr, "cannot open %s\n", fileName.toLatin1().data());
+        return 1;
+    }
+    QList<t_chunk> chunks;
+    double         totalBytes = 0.0;
+    bncRawFile     rawFile(fileName.toLatin1(), "", bncRawFile::input);
+    for (;;) {
+        QByteArray data = rawFile.readChunk();
+        if (data.isEmpty()) {
+            break;
+        }
+        t_chunk chunk;
+        chunk.time   = currentDateAndTimeGPS();
+        chunk.staID  = rawFile.staID();
+        chunk.format = rawFile.format();
+        chunk.data   = data;
+        chunks.append(chunk);
+        totalBytes += data.size();
+    }
+
+    // SSR frames per RTCM_3 station
+    // -----------------------------
+    QList<t_ssrFrames>             ssrFrames;
+    QMap<QByteArray, int>          ssrIndex;
+    QMap<QByteArray, RTCM3Framer*> framers;
+    for (int ii = 0; ii < chunks.size(); ii++) {
+        t_chunk& chunk = chunks[ii];
+        if (chunk.format != "RTCM_3") {
+            continue;
+        }
+        RTCM3Framer*& framer = framers[chunk.staID];
+        if (!framer) {
+            framer = new RTCM3Framer;
+        }
+        QByteArray data = chunk.data;
+        framer->feed(data.data(), data.size());
+        RTCM3Framer::t_frame frame;
+        while (framer->next(frame)) {
+            if (!isSsrType(frame.type)) {
+                continue;
+            }
+            if (!ssrIndex.contains(chunk.staID)) {
+                ssrIndex[chunk.staID] = ssrFrames.size();
+                t_ssrFrames sta;
+                sta.staID = chunk.staID;
+                sta.igs   = (frame.type == 4076);
+                ssrFrames.append(sta);
+            }
+            t_ssrFrames& sta = ssrFrames[ssrIndex[chunk.staID]];
+            sta.times.append(chunk.time);
+            sta.frames.append(QByteArray(reinterpret_cast<const char*>(frame.data),
+                                         int(frame.size)));
+        }
+    }
+    qDeleteAll(framers);
+
+    // Warm-up pass, collects the observations for the RINEX stage
+    // ------------------------------------------------------------
+    QMap<QByteArray, t_rnxInput> rnxInput;
+    runDecoders(chunks, "RTCM_3", &rnxInput);
+    runDecoders(chunks, "RTCM_2", &rnxInput);
+
+    printf("%s: %d chunks, %.2f MB, %d passes\n", fileName.toLatin1().data(),
+           int(chunks.size()), totalBytes / 1.0e6, repeats);
+    printf("%-16s %10s %12s %12s %14s\n",
+           "stage", "MB/s", "frames/s", "epochs/s", "allocs/epoch");
+
+    QList<t_result> rtcm3, coDec, rtcm2, rinex;
+    for (int rr = 0; rr < repeats; rr++) {
+        rtcm3.append(runDecoders(chunks, "RTCM_3", 0));
+        coDec.append(runCoDecoders(ssrFrames));
+        rtcm2.append(runDecoders(chunks, "RTCM_2", 0));
+        rinex.append(runRinex(rnxInput, rnxPath));
+    }
+    report("RTCM3Decoder",   rtcm3);
+    report("RTCM3coDecoder", coDec);
+    report("RTCM2Decoder",   rtcm2);
+    report("RINEX",          rinex);
+    return 0;
+}
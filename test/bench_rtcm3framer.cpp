@@ -0,0 +1,169 @@
+//
+// RTCM3 framing micro benchmark: RTCM3Framer against the former
+// copy-into-buffer / memmove extraction of RTCM3Decoder::GetMessage.
+//
+// Usage: bench_rtcm3framer [numFrames] [repeats]
+//
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "bncutils.h"
+#include "RTCM3/RTCM3Framer.h"
+
+namespace {
+
+// Former RTCM3Decoder buffer handling, kept here as reference
+// ----------------------------------------------------------------------------
+class LegacyFramer {
+public:
+    LegacyFramer() : _messageSize(0), _needBytes(0), _skipBytes(0), _blockSize(0) {}
+
+    size_t decode(char* buffer, int bufLen, size_t& bytes) {
+        size_t frames = 0;
+        while (bufLen && _messageSize < sizeof(_message)) {
+            int l = sizeof(_message) - _messageSize;
+            if (l > bufLen)
+                l = bufLen;
+            memcpy(_message + _messageSize, buffer, l);
+            _messageSize += l;
+            bufLen -= l;
+            buffer += l;
+            while (getMessage()) {
+                frames++;
+                bytes += _blockSize;
+            }
+        }
+        return frames;
+    }
+
+private:
+    int getMessage() {
+        unsigned char* m = _message + _skipBytes;
+        unsigned char* e = _message + _messageSize;
+        _needBytes = _skipBytes = 0;
+        while (e - m >= 3) {
+            if (m[0] == 0xD3) {
+                _blockSize = ((m[1] & 3) << 8) | m[2];
+                if (e - m >= static_cast<int>(_blockSize + 6)) {
+                    if (static_cast<unsigned long>((m[3 + _blockSize] << 16)
+                        | (m[3 + _blockSize + 1] << 8)
+                        | (m[3 + _blockSize + 2])) == CRC24(_blockSize + 3, m)) {
+                        _blockSize += 6;
+                        _skipBytes = _blockSize;
+                        break;
+                    }
+                    else
+                        ++m;
+                }
+                else {
+                    _needBytes = _blockSize + 6;
+                    break;
+                }
+            }
+            else
+                ++m;
+        }
+        if (e - m < 3)
+            _needBytes = 3;
+        int i = m - _message;
+        if (i && m < e)
+            memmove(_message, m, static_cast<size_t>(_messageSize - i));
+        _messageSize -= i;
+        return !_needBytes ? ((_message[3] << 4) | (_message[4] >> 4)) : 0;
+    }
+
+    unsigned char _message[2048];
+    size_t _messageSize;
+    size_t _needBytes;
+    size_t _skipBytes;
+    size_t _blockSize;
+};
+
+// Synthetic stream: MSM7 sized frames with a few bytes of noise in between
+// ----------------------------------------------------------------------------
+std::vector<char> makeStream(int numFrames) {
+    std::vector<char> stream;
+    srand(42);
+    for (int ii = 0; ii < numFrames; ii++) {
+        if (ii % 50 == 0) {
+            for (int jj = 0; jj < 7; jj++) {
+                stream.push_back(static_cast<char>(rand() % 256));
+            }
+        }
+        int len = 100 + rand() % 600;
+        std::vector<unsigned char> frame(len + 6);
+        frame[0] = 0xD3;
+        frame[1] = static_cast<unsigned char>(len >> 8);
+        frame[2] = static_cast<unsigned char>(len & 0xff);
+        frame[3] = 0x43;  // 1077
+        frame[4] = 0x50;
+        for (int jj = 5; jj < len + 3; jj++) {
+            frame[jj] = static_cast<unsigned char>(rand() % 256);
+        }
+        unsigned long crc = CRC24(len + 3, &frame[0]);
+        frame[len + 3] = static_cast<unsigned char>(crc >> 16);
+        frame[len + 4] = static_cast<unsigned char>(crc >> 8);
+        frame[len + 5] = static_cast<unsigned char>(crc);
+        stream.insert(stream.end(), frame.begin(), frame.end());
+    }
+    return stream;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QStringList args = app.arguments();
+    int numFrames = args.size() > 1 ? args[1].toInt() : 20000;
+    int repeats   = args.size() > 2 ? args[2].toInt() : 20;
+
+    std::vector<char> stream = makeStream(numFrames);
+    const int chunkSizes[] = {64, 1460, 16384, 65536};
+
+    printf("%d frames, %.1f MB per pass, %d passes\n",
+           numFrames, stream.size() / 1.0e6, repeats);
+    printf("%8s %14s %14s %10s\n", "chunk", "legacy MB/s", "framer MB/s", "frames");
+
+    for (int chunkSize : chunkSizes) {
+        size_t legacyFrames = 0, legacyBytes = 0;
+        QElapsedTimer timer;
+        timer.start();
+        for (int rr = 0; rr < repeats; rr++) {
+            LegacyFramer legacy;
+            for (size_t pos = 0; pos < stream.size(); pos += chunkSize) {
+                int len = static_cast<int>(qMin(stream.size() - pos, size_t(chunkSize)));
+                legacyFrames += legacy.decode(&stream[pos], len, legacyBytes);
+            }
+        }
+        double legacySec = timer.nsecsElapsed() / 1.0e9;
+
+        size_t framerFrames = 0, framerBytes = 0;
+        timer.restart();
+        for (int rr = 0; rr < repeats; rr++) {
+            RTCM3Framer framer;
+            RTCM3Framer::t_frame frame;
+            for (size_t pos = 0; pos < stream.size(); pos += chunkSize) {
+                size_t len = qMin(stream.size() - pos, size_t(chunkSize));
+                framer.feed(&stream[pos], len);
+                while (framer.next(frame)) {
+                    framerFrames++;
+                    framerBytes += frame.size;
+                }
+            }
+        }
+        double framerSec = timer.nsecsElapsed() / 1.0e9;
+
+        double mbytes = stream.size() * double(repeats) / 1.0e6;
+        printf("%8d %14.1f %14.1f %10zu%s\n", chunkSize,
+               mbytes / legacySec, mbytes / framerSec, framerFrames / repeats,
+               (legacyFrames != framerFrames || legacyBytes != framerBytes) ? "  MISMATCH" : "");
+    }
+    return 0;
+}
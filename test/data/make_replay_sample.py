@@ -0,0 +1,285 @@
+#!/usr/bin/env python3
+#
+# Writes replay_sample.raw, the synthetic BNC raw file used by bench_replay.
+#
+# Three streams recorded as if by "rawOutFile" over 120 seconds:
+#   SMPL0 RTCM_3  MSM7 GPS/Galileo observations at 1 Hz, 1019 ephemerides
+#   SSRC0 RTCM_3  1060 GPS orbit/clock corrections every 5 seconds
+#   SMPL1 RTCM_2  type 18/19 GPS observations at 1 Hz
+#
+# The observations follow a simple range model and are not meant to be
+# processed; they only exercise every decoding path with realistic sizes.
+#
+# Usage: make_replay_sample.py [outFile]
+#
+
+import datetime
+import math
+import random
+import sys
+
+START   = datetime.datetime(2026, 10, 14, 12, 0, 0)
+EPOCHS  = 120
+GPS0    = datetime.datetime(1980, 1, 6)
+C       = 299792458.0
+GPS_SATS = [2, 5, 7, 9, 13, 15, 18, 20, 24, 29]
+GAL_SATS = [1, 3, 7, 8, 13, 15, 26, 33]
+
+
+class BitWriter:
+    def __init__(self):
+        self.bits = []
+
+    def add(self, n, value):
+        value &= (1 << n) - 1
+        for ii in range(n - 1, -1, -1):
+            self.bits.append((value >> ii) & 1)
+
+    def bytes(self):
+        bits = self.bits + [0] * (-len(self.bits) % 8)
+        return bytes(int("".join(map(str, bits[ii:ii + 8])), 2)
+                     for ii in range(0, len(bits), 8))
+
+
+def crc24q(data):
+    crc = 0
+    for b in data:
+        crc ^= b << 16
+        for _ in range(8):
+            crc <<= 1
+            if crc & 0x1000000:
+                crc ^= 0x1864CFB
+    return crc & 0xFFFFFF
+
+
+def rtcm3Frame(body):
+    msg = bytes([0xD3, len(body) >> 8, len(body) & 0xFF]) + body
+    crc = crc24q(msg)
+    return msg + bytes([crc >> 16, (crc >> 8) & 0xFF, crc & 0xFF])
+
+
+def gpsSeconds(t):
+    dt = t - GPS0
+    return dt.days * 86400 + dt.seconds
+
+
+def satRange(prn, sec):
+    return 2.0e7 + 1.5e6 * math.sin(prn + sec / 3000.0)
+
+
+# RTCM3 MSM7 (1077/1097)
+# ----------------------------------------------------------------------------
+def msm7(msgType, sats, sigIds, tow, last):
+    w = BitWriter()
+    w.add(12, msgType)
+    w.add(12, 0)
+    w.add(30, (tow % 604800) * 1000)
+    w.add(1, 0 if last else 1)
+    w.add(3, 0); w.add(7, 0); w.add(2, 0); w.add(2, 0); w.add(1, 0); w.add(3, 0)
+    satMask = 0
+    for prn in sats:
+        satMask |= 1 << (64 - prn)
+    w.add(64, satMask)
+    sigMask = 0
+    for sig in sigIds:
+        sigMask |= 1 << (32 - sig)
+    w.add(32, sigMask)
+    for _ in sats:
+        w.add(len(sigIds), (1 << len(sigIds)) - 1)
+    ranges = [satRange(prn, tow) / C * 1000.0 for prn in sats]  # ms
+    for r in ranges:
+        w.add(8, int(r))
+    for _ in sats:
+        w.add(4, 0)
+    for r in ranges:
+        w.add(10, int((r - int(r)) * 1024))
+    for prn in sats:
+        w.add(14, int(600 * math.cos(prn + tow / 3000.0)))
+    cells = [(s, g) for s in range(len(sats)) for g in range(len(sigIds))]
+    fine = []
+    for s, g in cells:
+        rough = int(ranges[s]) + int((ranges[s] - int(ranges[s])) * 1024) / 1024.0
+        fine.append(ranges[s] - rough + 1.0e-6 * g)
+    for f in fine:
+        w.add(20, int(f * (1 << 29)))
+    for f in fine:
+        w.add(24, int((f + 2.0e-7) * (1 << 31)))
+    for _ in cells:
+        w.add(10, 500)
+    for _ in cells:
+        w.add(1, 0)
+    for s, g in cells:
+        w.add(10, int((45 - 3 * g + s % 5) * 16))
+    for _ in cells:
+        w.add(15, random.randint(-2000, 2000))
+    return rtcm3Frame(w.bytes())
+
+
+# RTCM3 1019 GPS ephemeris
+# ----------------------------------------------------------------------------
+def eph1019(prn, week, toe):
+    w = BitWriter()
+    w.add(12, 1019)
+    w.add(6, prn)
+    w.add(10, week % 1024)
+    w.add(4, 2)
+    w.add(2, 1)
+    w.add(14, 100)
+    w.add(8, toe // 16 % 256)
+    w.add(16, toe // 16)
+    w.add(8, 0)
+    w.add(16, -50)
+    w.add(22, 12345 * prn)
+    w.add(10, toe // 16 % 256)
+    w.add(16, 300)
+    w.add(16, 9000)
+    w.add(32, prn * 100000000)
+    w.add(16, 200)
+    w.add(32, 60000000)
+    w.add(16, 400)
+    w.add(32, int(5153.6 * (1 << 19)))
+    w.add(16, toe // 16)
+    w.add(16, 10)
+    w.add(32, prn * 50000000)
+    w.add(16, -10)
+    w.add(32, 650000000)
+    w.add(16, 5000)
+    w.add(32, -prn * 30000000)
+    w.add(24, -20000)
+    w.add(8, -5)
+    w.add(6, 0)
+    w.add(1, 0)
+    w.add(1, 0)
+    return rtcm3Frame(w.bytes())
+
+
+# RTCM3 1060 GPS combined orbit and clock corrections
+# ----------------------------------------------------------------------------
+def ssr1060(tow, iodByPrn):
+    w = BitWriter()
+    w.add(12, 1060)
+    w.add(20, tow)
+    w.add(4, 2)
+    w.add(1, 0)
+    w.add(1, 0)
+    w.add(4, 1)
+    w.add(16, 9999)
+    w.add(4, 1)
+    w.add(6, len(GPS_SATS))
+    for prn in GPS_SATS:
+        w.add(6, prn)
+        w.add(8, iodByPrn[prn])
+        for n in (22, 20, 20, 21, 19, 19, 22, 21, 27):
+            w.add(n, random.randint(-(1 << (n - 4)), 1 << (n - 4)))
+    return rtcm3Frame(w.bytes())
+
+
+# RTCM2 18/19 with 30-bit words, ICD-GPS-200 parity and 6-of-8 byte packing
+# ----------------------------------------------------------------------------
+PARITY = [0xBB1F3480, 0x5D8F9A40, 0xAEC7CD00, 0x5763E680, 0x6BB1F340, 0x8B7A89C0]
+
+
+class Rtcm2Writer:
+    def __init__(self):
+        self.prev = 0  # D29*, D30*
+        self.out = bytearray()
+
+    def word(self, data):
+        w = (self.prev << 30) | ((data & 0xFFFFFF) << 6)
+        p = 0
+        for mask in PARITY:
+            p = (p << 1) | (bin(w & mask).count("1") & 1)
+        if self.prev & 1:
+            data ^= 0xFFFFFF
+        word = ((data & 0xFFFFFF) << 6) | p
+        for shift in (24, 18, 12, 6, 0):
+            b = (word >> shift) & 0x3F
+            b = int("{:06b}".format(b)[::-1], 2)
+            self.out.append(0x40 | b)
+        self.prev = p & 3
+
+    def message(self, msgType, zCount, seq, dataBits):
+        nWords = len(dataBits) // 24
+        self.word((0x66 << 16) | (msgType << 10) | 1)
+        self.word((zCount << 11) | (seq << 8) | (nWords << 3))
+        for ii in range(nWords):
+            self.word(int("".join(map(str, dataBits[ii * 24:(ii + 1) * 24])), 2))
+
+
+def rtcm2Obs(writer, msgType, isL1, caCode, tow, seq):
+    secOfHour = tow % 3600
+    zCount = int(secOfHour / 0.6)
+    usec = int(round((secOfHour - zCount * 0.6) * 1.0e6))
+    w = BitWriter()
+    w.add(1, 0 if isL1 else 1)
+    w.add(1, 0)
+    w.add(2, 0)
+    w.add(20, usec)
+    for prn in GPS_SATS:
+        w.add(1, 0)
+        w.add(1, 0 if caCode else 1)
+        w.add(1, 0)
+        w.add(5, prn % 32)
+        w.add(3, 0)
+        w.add(5, 0)
+        rng = satRange(prn, tow)
+        if msgType == 19:
+            w.add(32, int(rng / 0.02))
+        else:
+            lam = C / (1575.42e6 if isL1 else 1227.60e6)
+            w.add(32, int(-(rng / lam % (1 << 23)) * 256))
+    writer.message(msgType, zCount, seq, w.bits)
+
+
+# Raw file
+# ----------------------------------------------------------------------------
+def main():
+    random.seed(4711)
+    outName = sys.argv[1] if len(sys.argv) > 1 else "replay_sample.raw"
+
+    chunks = []
+    def record(t, staID, fmt, data):
+        # split as a network read would
+        pos = 0
+        while pos < len(data):
+            n = random.randint(200, 1400)
+            chunks.append((t, staID, fmt, data[pos:pos + n]))
+            pos += n
+
+    rtcm2 = Rtcm2Writer()
+    rtcm2.word(0)  # spare word for parity synchronisation
+    iod = {prn: 10 + prn for prn in GPS_SATS}
+
+    for ep in range(EPOCHS):
+        t   = START + datetime.timedelta(seconds=ep)
+        sec = gpsSeconds(t)
+        week, tow = sec // 604800, sec % 604800
+
+        data = msm7(1077, GPS_SATS, [2, 10, 23], tow, False)
+        data += msm7(1097, GAL_SATS, [2, 15, 23], tow, True)
+        if ep % 60 == 0:
+            toe = (tow // 7200) * 7200
+            for prn in GPS_SATS:
+                data += eph1019(prn, week, toe)
+        record(t, "SMPL0", "RTCM_3", data)
+
+        if ep % 5 == 0:
+            record(t, "SSRC0", "RTCM_3", ssr1060(tow, iod))
+
+        rtcm2Obs(rtcm2, 18, True,  True,  tow, ep % 8)
+        rtcm2Obs(rtcm2, 18, False, False, tow, ep % 8)
+        rtcm2Obs(rtcm2, 19, True,  True,  tow, ep % 8)
+        rtcm2Obs(rtcm2, 19, False, False, tow, ep % 8)
+        record(t, "SMPL1", "RTCM_2", bytes(rtcm2.out))
+        rtcm2.out = bytearray()
+
+    with open(outName, "wb") as out:
+        out.write(b"1 Version of BNC raw file")
+        for t, staID, fmt, data in chunks:
+            out.write("\n{} {} {} {}\n".format(t.strftime("%Y-%m-%dT%H:%M:%S"),
+                                               staID, fmt, len(data)).encode())
+            out.write(data)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,585 @@
+//
+// Bit reader test: t_bitReader against the GETBITS family of macros in
+// bits.h on recorded RTCM3 frames. For every frame
+//   - pseudo-random sequences of fields of all kinds and widths are read
+//     from the message body up to (and beyond) its end,
+//   - 1019 GPS ephemerides are decoded field by field,
+//   - MSM4 to MSM7 header, satellite and cell data are decoded as in
+//     RTCM3Decoder::DecodeRTCM3MSM before and after the change to t_bitReader,
+// and the decoded values as well as the end-of-data position are compared
+// bit for bit. The exit code is non-zero on any mismatch.
+//
+// Usage: test_bitreader [rawFile]
+//        (default: test/data/replay_sample.raw)
+//
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QMap>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+#include <vector>
+
+#include "bnccore.h"
+#include "bncrawfile.h"
+#include "bncutils.h"
+#include "RTCM3/RTCM3Framer.h"
+#include "RTCM3/bitReader.h"
+#include "RTCM3/bits.h"
+#include "RTCM3/gnss.h"
+
+#define RTCM3_MSM_NUMSIG      32
+#define RTCM3_MSM_NUMSAT      64
+#define RTCM3_MSM_NUMCELLS    96 /* as in RTCM3Decoder.cpp */
+
+#define UINT64(c) c ## ULL
+
+namespace {
+
+uint64_t bitsOf(double d) {
+    uint64_t u;
+    memcpy(&u, &d, sizeof(u));
+    return u;
+}
+
+// Field lists
+// ----------------------------------------------------------------------------
+enum e_kind {BITS, BITSSIGN, FLOAT, FLOATSIGN, FLOATSIGNM, SKIP};
+
+struct t_field {
+    e_kind   kind;
+    unsigned n;
+    double   c;
+};
+
+t_field field(e_kind kind, unsigned n, double c = 1.0) {
+    t_field f = {kind, n, c};
+    return f;
+}
+
+// Macro version, returns false where the macros run out of data
+bool macroFields(unsigned char* data, int size, const std::vector<t_field>& fields,
+                 std::vector<uint64_t>& values) {
+    uint64_t numbits = 0, bitfield = 0;
+    for (size_t ii = 0; ii < fields.size(); ii++) {
+        const t_field& f = fields[ii];
+        uint64_t u = 0;
+        int64_t  s = 0;
+        double   d = 0.0;
+        switch (f.kind) {
+        case BITS:
+            GETBITS(u, f.n)
+            values.push_back(u);
+            break;
+        case BITSSIGN:
+            GETBITSSIGN(s, f.n)
+            values.push_back(uint64_t(s));
+            break;
+        case FLOAT:
+            GETFLOAT(d, f.n, f.c)
+            values.push_back(bitsOf(d));
+            break;
+        case FLOATSIGN:
+            GETFLOATSIGN(d, f.n, f.c)
+            values.push_back(bitsOf(d));
+            break;
+        case FLOATSIGNM:
+            GETFLOATSIGNM(d, f.n, f.c)
+            values.push_back(bitsOf(d));
+            break;
+        case SKIP:
+            SKIPBITS(f.n)
+            values.push_back(0);
+            break;
+        }
+    }
+    return true;
+}
+
+bool readerFields(const unsigned char* data, int size, const std::vector<t_field>& fields,
+                  std::vector<uint64_t>& values) {
+    t_bitReader bits(data, size);
+    for (size_t ii = 0; ii < fields.size(); ii++) {
+        const t_field& f = fields[ii];
+        uint64_t v = 0;
+        switch (f.kind) {
+        case BITS:
+            v = bits.getBits(f.n);
+            break;
+        case BITSSIGN:
+            v = uint64_t(bits.getBitsSign(f.n));
+            break;
+        case FLOAT:
+            v = bitsOf(bits.getFloat(f.n, f.c));
+            break;
+        case FLOATSIGN:
+            v = bitsOf(bits.getFloatSign(f.n, f.c));
+            break;
+        case FLOATSIGNM:
+            v = bitsOf(bits.getFloatSignM(f.n, f.c));
+            break;
+        case SKIP:
+            bits.skipBits(f.n);
+            break;
+        }
+        if (!bits.ok()) {
+            return false;
+        }
+        values.push_back(v);
+    }
+    return true;
+}
+
+// Random fields of 1 to 56 bits (the GETBITS limit), at least 64 bits more
+// than the body holds
+std::vector<t_field> randomFields(unsigned& seed, int size) {
+    std::vector<t_field> fields;
+    unsigned total = 0;
+    while (total < unsigned(size) * 8 + 64) {
+        seed = seed * 1103515245 + 12345;
+        e_kind   kind = e_kind((seed >> 16) % 6);
+        seed = seed * 1103515245 + 12345;
+        unsigned n    = 1 + (seed >> 16) % 56;
+        if (kind == FLOATSIGNM && n < 2) {
+            n = 2;
+        }
+        double c = 1.0 / double(UINT64(1) << (n % 32));
+        fields.push_back(field(kind, n, c));
+        total += n;
+    }
+    return fields;
+}
+
+// RTCM3 1019, field by field as in RTCM3Decoder::DecodeGPSEphemeris
+std::vector<t_field> gpsEphFields() {
+    std::vector<t_field> fields;
+    fields.push_back(field(SKIP, 12));
+    fields.push_back(field(BITS, 6));
+    fields.push_back(field(BITS, 10));
+    fields.push_back(field(BITS, 4));
+    fields.push_back(field(BITS, 2));
+    fields.push_back(field(FLOATSIGN, 14, R2R_PI/(double)(1<<30)/(double)(1<<13)));
+    fields.push_back(field(BITS, 8));
+    fields.push_back(field(BITS, 16));
+    fields.push_back(field(FLOATSIGN, 8, 1.0 / (double )(1 << 30) / (double )(1 << 25)));
+    fields.push_back(field(FLOATSIGN, 16, 1.0 / (double )(1 << 30) / (double )(1 << 13)));
+    fields.push_back(field(FLOATSIGN, 22, 1.0 / (double )(1 << 30) / (double )(1 << 1)));
+    fields.push_back(field(BITS, 10));
+    fields.push_back(field(FLOATSIGN, 16, 1.0 / (double )(1 << 5)));
+    fields.push_back(field(FLOATSIGN, 16, R2R_PI/(double)(1<<30)/(double)(1<<13)));
+    fields.push_back(field(FLOATSIGN, 32, R2R_PI/(double)(1<<30)/(double)(1<<1)));
+    fields.push_back(field(FLOATSIGN, 16, 1.0 / (double )(1 << 29)));
+    fields.push_back(field(FLOAT, 32, 1.0 / (double )(1 << 30) / (double )(1 << 3)));
+    fields.push_back(field(FLOATSIGN, 16, 1.0 / (double )(1 << 29)));
+    fields.push_back(field(FLOAT, 32, 1.0 / (double )(1 << 19)));
+    fields.push_back(field(BITS, 16));
+    fields.push_back(field(FLOATSIGN, 16, 1.0 / (double )(1 << 29)));
+    fields.push_back(field(FLOATSIGN, 32, R2R_PI/(double)(1<<30)/(double)(1<<1)));
+    fields.push_back(field(FLOATSIGN, 16, 1.0 / (double )(1 << 29)));
+    fields.push_back(field(FLOATSIGN, 32, R2R_PI/(double)(1<<30)/(double)(1<<1)));
+    fields.push_back(field(FLOATSIGN, 16, 1.0 / (double )(1 << 5)));
+    fields.push_back(field(FLOATSIGN, 32, R2R_PI/(double)(1<<30)/(double)(1<<1)));
+    fields.push_back(field(FLOATSIGN, 24, R2R_PI/(double)(1<<30)/(double)(1<<13)));
+    fields.push_back(field(FLOATSIGN, 8, 1.0 / (double )(1 << 30) / (double )(1 << 1)));
+    fields.push_back(field(BITS, 6));
+    fields.push_back(field(BITS, 1));
+    fields.push_back(field(BITS, 1));
+    return fields;
+}
+
+// MSM messages
+// ----------------------------------------------------------------------------
+struct t_msm {
+    int      type;
+    int      epoch;
+    int      syncf;
+    uint64_t satmask;
+    int      sigmask;
+    uint64_t cellmask;
+    double   rrmod[RTCM3_MSM_NUMSAT];
+    int      rrint[RTCM3_MSM_NUMSAT];
+    int      rdop[RTCM3_MSM_NUMSAT];
+    int      extsat[RTCM3_MSM_NUMSAT];
+    int      ll[RTCM3_MSM_NUMCELLS];
+    double   cnr[RTCM3_MSM_NUMCELLS];
+    double   cp[RTCM3_MSM_NUMCELLS];
+    double   psr[RTCM3_MSM_NUMCELLS];
+    double   dop[RTCM3_MSM_NUMCELLS];
+};
+
+bool isMsm(int type) {
+    return type >= 1071 && type <= 1137 && (type % 10) >= 4 && (type % 10) <= 7;
+}
+
+// Former RTCM3Decoder::DecodeRTCM3MSM bit handling, kept here as reference
+bool macroMsm(unsigned char* data, int size, t_msm& m) {
+    int type, syncf, i;
+    uint64_t numbits = 0, bitfield = 0;
+
+    data += 3; /* header */
+    size -= 6; /* header + crc */
+
+    GETBITS(type, 12)
+    SKIPBITS(12)
+    m.type = type;
+    if (type >= 1121 && type <= 1127) {
+        GETBITS(i, 30)
+    }
+    else if (type >= 1081 && type <= 1087) {
+        SKIPBITS(3)
+        GETBITS(i, 27)
+    }
+    else {
+        GETBITS(i, 30)
+    }
+    m.epoch = i;
+    GETBITS(syncf, 1)
+    m.syncf = syncf;
+
+    int sigmask, numsat = 0, numsig = 0;
+    uint64_t satmask, cellmask, ui;
+    SKIPBITS(3 + 7 + 2 + 2 + 1 + 3)
+    GETBITS64(satmask, RTCM3_MSM_NUMSAT)
+    for (ui = satmask; ui; ui &= (ui - 1))
+        ++numsat;
+    GETBITS(sigmask, RTCM3_MSM_NUMSIG)
+    for (i = sigmask; i; i &= (i - 1))
+        ++numsig;
+    for (i = 0; i < RTCM3_MSM_NUMSAT; ++i)
+        m.extsat[i] = 15;
+    m.satmask = satmask;
+    m.sigmask = sigmask;
+
+    i = numsat * numsig;
+    GETBITS64(cellmask, (unsigned )i)
+    m.cellmask = cellmask;
+    switch (type % 10) {
+    case 4:
+    case 6:
+        for (int j = numsat; j--;)
+            GETBITS(m.rrint[j], 8)
+        for (int j = numsat; j--;)
+            GETFLOAT(m.rrmod[j], 10, 1.0 / 1024.0)
+        break;
+    case 5:
+    case 7:
+        for (int j = numsat; j--;)
+            GETBITS(m.rrint[j], 8)
+        for (int j = numsat; j--;)
+            GETBITS(m.extsat[j], 4)
+        for (int j = numsat; j--;)
+            GETFLOAT(m.rrmod[j], 10, 1.0 / 1024.0)
+        for (int j = numsat; j--;)
+            GETBITSSIGN(m.rdop[j], 14)
+        break;
+    }
+    int numcells = numsat * numsig;
+    if (numcells <= RTCM3_MSM_NUMCELLS) {
+        switch (type % 10) {
+        case 4:
+            for (int count = numcells; count--;)
+                if (cellmask & (UINT64(1) << count))
+                    GETFLOATSIGN(m.psr[count], 15, 1.0 / (1 << 24))
+            for (int count = numcells; count--;)
+                if (cellmask & (UINT64(1) << count))
+                    GETFLOATSIGN(m.cp[count], 22, 1.0 / (1 << 29))
+            for (int count = numcells; count--;)
+                if (cellmask & (UINT64(1) << count))
+                    GETBITS(m.ll[count], 4)
+            for (int count = numcells; count--;)
+                if (cellmask & (UINT64(1) << count))
+                    SKIPBITS(1)
+            for (int count = numcells; count--;)
+                if (cellmask & (UINT64(1) << count))
+                    GETBITS(m.cnr[count], 6)
+            break;
+        case 5:
+            for (int count = numcells; count--;)
+                if (cellmask & (UINT64(1) << count))
+                    GETFLOATSIGN(m.psr[count], 15, 1.0 / (1 << 24))
+            for (int count = numcells; count--;)
+                if (cellmask & (UINT64(1) << count))
+                    GETFLOATSIGN(m.cp[count], 22, 1.0 / (1 << 29))
+            for (int count = numcells; count--;)
+                if (cellmask & (UINT64(1) << count))
+                    GETBITS(m.ll[count], 4)
+            for (int count = numcells; count--;)
+                if (cellmask & (UINT64(1) << count))
+                    SKIPBITS(1)
+            for (int count = numcells; count--;)
+                if (cellmask & (UINT64(1) << count))
+                    GETFLOAT(m.cnr[count], 6, 1.0)
+            for (int count = numcells; count--;)
+                if (cellmask & (UINT64(1) << count))
+                    GETFLOATSIGN(m.dop[count], 15, 0.0001)
+            break;
+        case 6:
+            for (int count = numcells; count--;)
+                if (cellmask & (UINT64(1) << count))
+                    GETFLOATSIGN(m.psr[count], 20, 1.0 / (1 << 29))
+            for (int count = numcells; count--;)
+                if (cellmask & (UINT64(1) << count))
+                    GETFLOATSIGN(m.cp[count], 24, 1.0 / (1U << 31))
+            for (int count = numcells; count--;)
+                if (cellmask & (UINT64(1) << count))
+                    GETBITS(m.ll[count], 10)
+            for (int count = numcells; count--;)
+                if (cellmask & (UINT64(1) << count))
+                    SKIPBITS(1)
+            for (int count = numcells; count--;)
+                if (cellmask & (UINT64(1) << count))
+                    GETFLOAT(m.cnr[count], 10, 1.0 / (1 << 4))
+            break;
+        case 7:
+            for (int count = numcells; count--;)
+                if (cellmask & (UINT64(1) << count))
+                    GETFLOATSIGN(m.psr[count], 20, 1.0 / (1 << 29))
+            for (int count = numcells; count--;)
+                if (cellmask & (UINT64(1) << count))
+                    GETFLOATSIGN(m.cp[count], 24, 1.0 / (1U << 31))
+            for (int count = numcells; count--;)
+                if (cellmask & (UINT64(1) << count))
+                    GETBITS(m.ll[count], 10)
+            for (int count = numcells; count--;)
+                if (cellmask & (UINT64(1) << count))
+                    SKIPBITS(1)
+            for (int count = numcells; count--;)
+                if (cellmask & (UINT64(1) << count))
+                    GETFLOAT(m.cnr[count], 10, 1.0 / (1 << 4))
+            for (int count = numcells; count--;)
+                if (cellmask & (UINT64(1) << count))
+                    GETFLOATSIGN(m.dop[count], 15, 0.0001)
+            break;
+        }
+    }
+    return true;
+}
+
+// Current RTCM3Decoder::DecodeRTCM3MSM bit handling
+bool readerMsm(unsigned char* data, int size, t_msm& m) {
+    int i;
+
+    data += 3; /* header */
+    size -= 6; /* header + crc */
+    t_bitReader bits(data, size);
+
+    m.type = bits.getBits(12);
+    bits.skipBits(12);
+    if (m.type >= 1121 && m.type <= 1127) {
+        m.epoch = bits.getBits(30);
+    }
+    else if (m.type >= 1081 && m.type <= 1087) {
+        bits.skipBits(3);
+        m.epoch = bits.getBits(27);
+    }
+    else {
+        m.epoch = bits.getBits(30);
+    }
+    m.syncf = bits.getBits(1);
+    if (!bits.ok()) {
+        return false;
+    }
+
+    int numsat = 0, numsig = 0;
+    uint64_t ui;
+    bits.skipBits(3 + 7 + 2 + 2 + 1 + 3);
+    m.satmask = bits.getBits(RTCM3_MSM_NUMSAT);
+    for (ui = m.satmask; ui; ui &= (ui - 1))
+        ++numsat;
+    m.sigmask = bits.getBits(RTCM3_MSM_NUMSIG);
+    for (i = m.sigmask; i; i &= (i - 1))
+        ++numsig;
+    for (i = 0; i < RTCM3_MSM_NUMSAT; ++i)
+        m.extsat[i] = 15;
+
+    i = numsat * numsig;
+    m.cellmask = bits.getBits((unsigned )i);
+    switch (m.type % 10) {
+    case 4:
+    case 6:
+        for (int j = numsat; j--;)
+            m.rrint[j] = bits.getBits(8);
+        for (int j = numsat; j--;)
+            m.rrmod[j] = bits.getFloat(10, 1.0 / 1024.0);
+        break;
+    case 5:
+    case 7:
+        for (int j = numsat; j--;)
+            m.rrint[j] = bits.getBits(8);
+        for (int j = numsat; j--;)
+            m.extsat[j] = bits.getBits(4);
+        for (int j = numsat; j--;)
+            m.rrmod[j] = bits.getFloat(10, 1.0 / 1024.0);
+        for (int j = numsat; j--;)
+            m.rdop[j] = bits.getBitsSign(14);
+        break;
+    }
+    if (!bits.ok()) {
+        return false;
+    }
+    int      numcells = numsat * numsig;
+    uint64_t cellmask = m.cellmask;
+    if (numcells <= RTCM3_MSM_NUMCELLS) {
+        switch (m.type % 10) {
+        case 4:
+            bits.getCellsFloatSign(m.psr, 15, 1.0 / (1 << 24), cellmask, numcells);
+            bits.getCellsFloatSign(m.cp, 22, 1.0 / (1 << 29), cellmask, numcells);
+            bits.getCells(m.ll, 4, cellmask, numcells);
+            bits.skipCells(1, cellmask);
+            bits.getCells(m.cnr, 6, cellmask, numcells);
+            break;
+        case 5:
+            bits.getCellsFloatSign(m.psr, 15, 1.0 / (1 << 24), cellmask, numcells);
+            bits.getCellsFloatSign(m.cp, 22, 1.0 / (1 << 29), cellmask, numcells);
+            bits.getCells(m.ll, 4, cellmask, numcells);
+            bits.skipCells(1, cellmask);
+            bits.getCellsFloat(m.cnr, 6, 1.0, cellmask, numcells);
+            bits.getCellsFloatSign(m.dop, 15, 0.0001, cellmask, numcells);
+            break;
+        case 6:
+            bits.getCellsFloatSign(m.psr, 20, 1.0 / (1 << 29), cellmask, numcells);
+            bits.getCellsFloatSign(m.cp, 24, 1.0 / (1U << 31), cellmask, numcells);
+            bits.getCells(m.ll, 10, cellmask, numcells);
+            bits.skipCells(1, cellmask);
+            bits.getCellsFloat(m.cnr, 10, 1.0 / (1 << 4), cellmask, numcells);
+            break;
+        case 7:
+            bits.getCellsFloatSign(m.psr, 20, 1.0 / (1 << 29), cellmask, numcells);
+            bits.getCellsFloatSign(m.cp, 24, 1.0 / (1U << 31), cellmask, numcells);
+            bits.getCells(m.ll, 10, cellmask, numcells);
+            bits.skipCells(1, cellmask);
+            bits.getCellsFloat(m.cnr, 10, 1.0 / (1 << 4), cellmask, numcells);
+            bits.getCellsFloatSign(m.dop, 15, 0.0001, cellmask, numcells);
+            break;
+        }
+        if (!bits.ok()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Comparison
+// ----------------------------------------------------------------------------
+struct t_count {
+    t_count() : frames(0), sweeps(0), fields(0), ephs(0), msms(0), errors(0) {}
+    int frames;
+    int sweeps;
+    int fields;
+    int ephs;
+    int msms;
+    int errors;
+};
+
+void compareFields(const QByteArray& frame, int type, const std::vector<t_field>& fields,
+                   const char* what, t_count& count) {
+    QByteArray body = frame.mid(3, frame.size() - 6);
+    unsigned char* data = reinterpret_cast<unsigned char*>(body.data());
+
+    std::vector<uint64_t> macroValues;
+    std::vector<uint64_t> readerValues;
+    bool macroOk  = macroFields(data, body.size(), fields, macroValues);
+    bool readerOk = readerFields(data, body.size(), fields, readerValues);
+
+    count.fields += int(macroValues.size());
+    if (macroOk != readerOk || macroValues != readerValues) {
+        size_t ii = 0;
+        while (ii < macroValues.size() && ii < readerValues.size()
+               && macroValues[ii] == readerValues[ii]) {
+            ii++;
+        }
+        fprintf(stderr, "%s mismatch in frame %d (type %d): field %d,"
+                " %d/%d fields read, ok %d/%d\n", what, count.frames, type, int(ii),
+                int(macroValues.size()), int(readerValues.size()), macroOk, readerOk);
+        count.errors++;
+    }
+}
+
+void compareMsm(const QByteArray& frame, t_count& count) {
+    QByteArray copy = frame;
+    unsigned char* data = reinterpret_cast<unsigned char*>(copy.data());
+
+    t_msm macro;
+    t_msm reader;
+    memset(&macro,  0, sizeof(macro));
+    memset(&reader, 0, sizeof(reader));
+    bool macroOk  = macroMsm(data, copy.size(), macro);
+    bool readerOk = readerMsm(data, copy.size(), reader);
+
+    count.msms++;
+    if (macroOk != readerOk || (macroOk && memcmp(&macro, &reader, sizeof(macro)) != 0)) {
+        fprintf(stderr, "MSM mismatch in frame %d (type %d), ok %d/%d\n",
+                count.frames, macro.type, macroOk, readerOk);
+        count.errors++;
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QStringList args     = app.arguments();
+    QString     fileName = args.size() > 1 ? args[1]
+                                           : QString(BNC_TEST_DATA_DIR "/replay_sample.raw");
+
+    // Default options from an empty configuration
+    // -------------------------------------------
+    QTemporaryDir tmpDir;
+    BNC_CORE->setConfFileName(tmpDir.path() + "/test_bitreader.bnc");
+
+    if (!QFile::exists(fileName)) {
+        fprintf(stderr, "cannot open %s\n", fileName.toLatin1().data());
+        return 1;
+    }
+
+    // Compare frame by frame
+    // ----------------------
+    t_count                        count;
+    unsigned                       seed = 1;
+    QMap<QByteArray, RTCM3Framer*> framers;
+    bncRawFile                     rawFile(fileName.toLatin1(), "", bncRawFile::input);
+    for (;;) {
+        QByteArray data = rawFile.readChunk();
+        if (data.isEmpty()) {
+            break;
+        }
+        if (rawFile.format() != "RTCM_3") {
+            continue;
+        }
+        RTCM3Framer*& framer = framers[rawFile.staID()];
+        if (!framer) {
+            framer = new RTCM3Framer;
+        }
+        framer->feed(data.data(), data.size());
+        RTCM3Framer::t_frame frame;
+        while (framer->next(frame)) {
+            QByteArray bytes(reinterpret_cast<const char*>(frame.data), int(frame.size));
+            for (int ii = 0; ii < 8; ii++) {
+                compareFields(bytes, frame.type, randomFields(seed, int(frame.size) - 6),
+                              "sweep", count);
+                count.sweeps++;
+            }
+            if (frame.type == 1019) {
+                compareFields(bytes, frame.type, gpsEphFields(), "1019", count);
+                count.ephs++;
+            }
+            if (isMsm(frame.type)) {
+                compareMsm(bytes, count);
+            }
+            count.frames++;
+        }
+    }
+    qDeleteAll(framers);
+
+    printf("%d frames, %d sweeps, %d fields, %d ephemerides, %d MSM messages: %d mismatches\n",
+           count.frames, count.sweeps, count.fields, count.ephs, count.msms, count.errors);
+    if (count.frames == 0) {
+        fprintf(stderr, "no RTCM_3 frames in %s\n", fileName.toLatin1().data());
+        return 1;
+    }
+    return count.errors ? 1 : 0;
+}
@@ -0,0 +1,82 @@
+//
+// CRC24Q test: the table-driven CRC24() of bncutils against the former bit
+// by bit computation, on pseudo-random buffers of every length up to the
+// maximum RTCM3 frame size at every alignment offset within 8 bytes, and on
+// the CRC-24Q check value. The exit code is non-zero on any mismatch.
+//
+// Usage: test_crc24
+//
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "bncutils.h"
+
+namespace {
+
+// Former bncutils CRC24, kept here as reference
+// ----------------------------------------------------------------------------
+unsigned long crc24Bitwise(long size, const unsigned char* buf) {
+    unsigned long crc = 0;
+    int ii;
+    while (size--) {
+        crc ^= (*buf++) << (16);
+        for (ii = 0; ii < 8; ii++) {
+            crc <<= 1;
+            if (crc & 0x1000000) {
+                crc ^= 0x01864cfb;
+            }
+        }
+    }
+    return crc;
+}
+
+} // namespace
+
+int main() {
+    const long maxSize = 1029; // RTCM3 frame with 1023 bytes message
+    const long maxOffset = 8;
+
+    int errors = 0;
+    int checks = 0;
+
+    // CRC-24Q check value
+    // -------------------
+    const char* check = "123456789";
+    unsigned long crc = CRC24(long(strlen(check)), reinterpret_cast<const unsigned char*>(check));
+    checks++;
+    if (crc != 0xCDE703) {
+        fprintf(stderr, "check value: 0x%06lX instead of 0xCDE703\n", crc);
+        errors++;
+    }
+
+    // Random buffers, all lengths and alignments
+    // ------------------------------------------
+    std::vector<unsigned char> buf(maxSize + maxOffset);
+    unsigned seed = 0x12345678;
+    for (int pass = 0; pass < 4; pass++) {
+        for (size_t ii = 0; ii < buf.size(); ii++) {
+            seed = 1103515245 * seed + 12345;
+            buf[ii] = static_cast<unsigned char>(seed >> 16);
+        }
+        for (long offset = 0; offset < maxOffset; offset++) {
+            for (long size = 0; size <= maxSize; size++) {
+                const unsigned char* data = &buf[offset];
+                unsigned long table = CRC24(size, data);
+                unsigned long ref   = crc24Bitwise(size, data);
+                checks++;
+                if (table != ref) {
+                    if (errors < 10) {
+                        fprintf(stderr, "pass %d offset %ld size %ld: 0x%06lX instead of 0x%06lX\n",
+                                pass, offset, size, table, ref);
+                    }
+                    errors++;
+                }
+            }
+        }
+    }
+
+    printf("%d checks: %d mismatches\n", checks, errors);
+    return errors ? 1 : 0;
+}